@@ -0,0 +1,91 @@
+#include "benchmetrics.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <sys/resource.h>
+
+
+/*! \brief Number of calls to operator new. */
+static std::atomic<int64_t> allocation_count = 0;
+/*! \brief Total number of bytes requested from operator new. */
+static std::atomic<int64_t> allocated_byte_count = 0;
+
+void* operator new(size_t size)
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocated_byte_count.fetch_add(size, std::memory_order_relaxed);
+  if(void* pointer = std::malloc(size == 0 ? 1 : size))
+    return pointer;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t size) noexcept
+{
+  std::free(pointer);
+}
+
+BenchMetrics BenchMetrics::capture()
+{
+  BenchMetrics metrics;
+  metrics.wall_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count();
+  metrics.allocations = allocation_count.load(std::memory_order_relaxed);
+  metrics.allocated_bytes = allocated_byte_count.load(std::memory_order_relaxed);
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+    metrics.user_time_ns = usage.ru_utime.tv_sec * 1000000000ll + usage.ru_utime.tv_usec * 1000ll;
+    metrics.system_time_ns =
+      usage.ru_stime.tv_sec * 1000000000ll + usage.ru_stime.tv_usec * 1000ll;
+    metrics.minor_page_faults = usage.ru_minflt;
+    metrics.voluntary_context_switches = usage.ru_nvcsw;
+  }
+  std::ifstream io_file("/proc/self/io");
+  std::string key;
+  int64_t value;
+  while(io_file >> key >> value)
+  {
+    if(key == "syscr:")
+      metrics.read_calls = value;
+    else if(key == "syscw:")
+      metrics.write_calls = value;
+  }
+  return metrics;
+}
+
+BenchMetrics BenchMetrics::operator-(const BenchMetrics& start) const
+{
+  return { wall_time_ns - start.wall_time_ns,
+           user_time_ns - start.user_time_ns,
+           system_time_ns - start.system_time_ns,
+           allocations - start.allocations,
+           allocated_bytes - start.allocated_bytes,
+           read_calls - start.read_calls,
+           write_calls - start.write_calls,
+           minor_page_faults - start.minor_page_faults,
+           voluntary_context_switches - start.voluntary_context_switches };
+}
+
+Json::Value BenchMetrics::toJson() const
+{
+  Json::Value json;
+  json["wall_time_ms"] = wall_time_ns / 1e6;
+  json["user_time_ms"] = user_time_ns / 1e6;
+  json["system_time_ms"] = system_time_ns / 1e6;
+  json["allocations"] = Json::Int64(allocations);
+  json["allocated_bytes"] = Json::Int64(allocated_bytes);
+  json["read_calls"] = Json::Int64(read_calls);
+  json["write_calls"] = Json::Int64(write_calls);
+  json["minor_page_faults"] = Json::Int64(minor_page_faults);
+  json["voluntary_context_switches"] = Json::Int64(voluntary_context_switches);
+  return json;
+}
@@ -0,0 +1,58 @@
+/*!
+ * \file benchmetrics.h
+ * \brief Header for the BenchMetrics struct.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <json/json.h>
+
+
+/*!
+ * \brief Resource usage of the current process at one point in time. The difference of
+ * two snapshots describes the resources used in between.
+ *
+ * Allocations are counted by replacing the global operator new of the benchmark executable.
+ * Read and write calls are taken from /proc/self/io, which only counts read and write like
+ * system calls. Other file system calls, e.g. stat, link or rename, are not counted. Page faults
+ * and context switches are taken from getrusage.
+ */
+struct BenchMetrics
+{
+  /*! \brief Wall clock time in nanoseconds. */
+  int64_t wall_time_ns = 0;
+  /*! \brief CPU time spent in user mode in nanoseconds. */
+  int64_t user_time_ns = 0;
+  /*! \brief CPU time spent in kernel mode in nanoseconds. */
+  int64_t system_time_ns = 0;
+  /*! \brief Number of calls to operator new. */
+  int64_t allocations = 0;
+  /*! \brief Total number of bytes requested from operator new. */
+  int64_t allocated_bytes = 0;
+  /*! \brief Number of read like system calls, as counted in /proc/self/io. */
+  int64_t read_calls = 0;
+  /*! \brief Number of write like system calls, as counted in /proc/self/io. */
+  int64_t write_calls = 0;
+  /*! \brief Number of minor page faults. */
+  int64_t minor_page_faults = 0;
+  /*! \brief Number of voluntary context switches. */
+  int64_t voluntary_context_switches = 0;
+
+  /*!
+   * \brief Captures the current resource usage.
+   * \return The snapshot.
+   */
+  static BenchMetrics capture();
+  /*!
+   * \brief Computes the resources used between the given snapshot and this one.
+   * \param start Snapshot taken before this one.
+   * \return The difference.
+   */
+  BenchMetrics operator-(const BenchMetrics& start) const;
+  /*!
+   * \brief Serializes this object.
+   * \return Json object containing all values.
+   */
+  Json::Value toJson() const;
+};
@@ -0,0 +1,244 @@
+#include "../src/core/casematchingdeployer.h"
+#include "../src/core/deployer.h"
+#include "../src/core/reversedeployer.h"
+#include "benchmetrics.h"
+#include "stagingtreegenerator.h"
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <json/json.h>
+#include <ranges>
+#include <unistd.h>
+
+namespace sfs = std::filesystem;
+namespace str = std::ranges;
+
+
+/*! \brief Names of all scenarios, in the order in which they are run. */
+const std::vector<std::string> SCENARIOS = { "first_deploy",         "noop_redeploy",
+                                             "toggle_mod",           "conflict_query",
+                                             "external_change_scan", "reverse_scan",
+                                             "undeploy",             "case_matching_deploy" };
+/*! \brief Names of all directories created inside the work directory. */
+const std::vector<std::string> GENERATED_DIRS = { "staging",
+                                                  "target",
+                                                  "reverse",
+                                                  "case_matching_staging",
+                                                  "case_matching_target" };
+
+/*!
+ * \brief Prints usage information.
+ */
+void printUsage()
+{
+  std::string scenario_names;
+  for(const auto& name : SCENARIOS)
+    scenario_names += (scenario_names.empty() ? "" : ", ") + name;
+  std::string generated_dir_names;
+  for(const auto& name : GENERATED_DIRS)
+    generated_dir_names += (generated_dir_names.empty() ? "" : ", ") + name;
+  std::cout
+    << "Usage: limo_bench [options]\n"
+       "Creates synthetic staging directories and measures common deployer operations.\n"
+       "Results are written as JSON.\n\n"
+       "Options:\n"
+       "  --mods=N               Number of generated mods (default 100).\n"
+       "  --files=N              Number of files per mod (default 100).\n"
+       "  --overlap=R            Fraction of files shared between mods (default 0.2).\n"
+       "  --depth=N              Directory depth of every file (default 3).\n"
+       "  --dirs=N               Sub directories per directory (default 4).\n"
+       "  --case-collisions=R    Fraction of path components with different case (default 0).\n"
+       "  --file-size=N          Size of every file in bytes (default 16).\n"
+       "  --seed=N               Seed for the generator (default 0).\n"
+       "  --scenarios=A,B,...    Scenarios to run (default all). Available: "
+    << scenario_names
+    << ".\n"
+       "  --work-dir=PATH        Directory for generated files (default: a temporary directory).\n"
+       "                         Must not contain any of: "
+    << generated_dir_names
+    << ".\n"
+       "  --output=PATH          Write results to this file instead of stdout.\n"
+       "  --keep                 Do not delete generated files.\n"
+       "  --help                 Show this message.\n";
+}
+
+int main(int argc, char* argv[])
+{
+  StagingTreeGenerator::Options options;
+  std::vector<std::string> scenarios = SCENARIOS;
+  sfs::path work_dir = sfs::temp_directory_path() / std::format("limo_bench_{}", getpid());
+  sfs::path output_path;
+  bool keep_files = false;
+  try
+  {
+    for(int i = 1; i < argc; i++)
+    {
+      const std::string arg = argv[i];
+      const size_t separator = arg.find('=');
+      const std::string key = arg.substr(0, separator);
+      const std::string value = separator == std::string::npos ? "" : arg.substr(separator + 1);
+      if(key == "--mods")
+        options.num_mods = std::stoi(value);
+      else if(key == "--files")
+        options.files_per_mod = std::stoi(value);
+      else if(key == "--overlap")
+        options.overlap_ratio = std::stod(value);
+      else if(key == "--depth")
+        options.depth = std::stoi(value);
+      else if(key == "--dirs")
+        options.directories_per_level = std::stoi(value);
+      else if(key == "--case-collisions")
+        options.case_collision_ratio = std::stod(value);
+      else if(key == "--file-size")
+        options.file_size = std::stoi(value);
+      else if(key == "--seed")
+        options.seed = std::stoul(value);
+      else if(key == "--scenarios")
+      {
+        scenarios.clear();
+        for(const auto name : std::views::split(value, ','))
+          scenarios.emplace_back(std::string_view(name));
+      }
+      else if(key == "--work-dir")
+        work_dir = value;
+      else if(key == "--output")
+        output_path = value;
+      else if(key == "--keep")
+        keep_files = true;
+      else if(key == "--help")
+      {
+        printUsage();
+        return 0;
+      }
+      else
+        throw std::invalid_argument(arg);
+    }
+    for(const auto& scenario : scenarios)
+    {
+      if(str::find(SCENARIOS, scenario) == SCENARIOS.end())
+        throw std::invalid_argument(scenario);
+    }
+    // only directories created by the benchmark are deleted afterwards
+    for(const auto& name : GENERATED_DIRS)
+    {
+      if(sfs::exists(work_dir / name))
+        throw std::invalid_argument(
+          std::format("'{}' already exists", (work_dir / name).string()));
+    }
+  }
+  catch(const std::exception& error)
+  {
+    std::cerr << std::format("Invalid argument: {}\n\n", error.what());
+    printUsage();
+    return 1;
+  }
+
+  Json::Value results;
+  results["options"] = StagingTreeGenerator(options).toJson();
+  results["scenarios"] = Json::Value(Json::arrayValue);
+  auto run_scenario = [&scenarios, &results](const std::string& name, std::function<void()> fun)
+  {
+    if(str::find(scenarios, name) == scenarios.end())
+      return;
+    const BenchMetrics start = BenchMetrics::capture();
+    fun();
+    Json::Value result = (BenchMetrics::capture() - start).toJson();
+    result["name"] = name;
+    results["scenarios"].append(result);
+    std::cerr << std::format("{}: {:.2f} ms\n", name, result["wall_time_ms"].asDouble());
+  };
+
+  const sfs::path staging_dir = work_dir / "staging";
+  const sfs::path target_dir = work_dir / "target";
+  const bool created_work_dir = !sfs::exists(work_dir);
+  auto remove_generated_files = [&work_dir, created_work_dir]()
+  {
+    for(const auto& name : GENERATED_DIRS)
+      sfs::remove_all(work_dir / name);
+    std::error_code error;
+    if(created_work_dir)
+      sfs::remove(work_dir, error);
+  };
+  try
+  {
+    sfs::create_directories(work_dir);
+    StagingTreeGenerator generator(options);
+    // the regular deployer operates on a tree without case collisions
+    StagingTreeGenerator::Options regular_options = options;
+    regular_options.case_collision_ratio = 0.0;
+    StagingTreeGenerator regular_generator(regular_options);
+    const BenchMetrics generation_start = BenchMetrics::capture();
+    regular_generator.generate(staging_dir, target_dir);
+    results["generated_files"] = Json::Int64(regular_generator.getNumFiles());
+    results["generation_time_ms"] =
+      (BenchMetrics::capture() - generation_start).wall_time_ns / 1e6;
+
+    Deployer deployer(staging_dir, target_dir, "bench");
+    deployer.addProfile();
+    for(int mod_id = 0; mod_id < options.num_mods; mod_id++)
+      deployer.addMod(mod_id, true, false);
+
+    run_scenario("first_deploy", [&deployer]() { deployer.deploy(); });
+    run_scenario("noop_redeploy", [&deployer]() { deployer.deploy(); });
+    run_scenario("toggle_mod",
+                 [&deployer, &options]()
+                 {
+                   deployer.setModStatus(options.num_mods / 2, false);
+                   deployer.deploy();
+                   deployer.setModStatus(options.num_mods / 2, true);
+                   deployer.deploy();
+                 });
+    run_scenario("conflict_query",
+                 [&deployer, &options]()
+                 {
+                   for(int mod_id = 0; mod_id < options.num_mods; mod_id++)
+                     deployer.getModConflicts(mod_id);
+                   for(int mod_id = 0; mod_id < std::min(options.num_mods, 10); mod_id++)
+                     deployer.getFileConflicts(mod_id);
+                 });
+    run_scenario("external_change_scan",
+                 [&deployer]() { deployer.getExternallyModifiedFiles(); });
+    run_scenario("reverse_scan",
+                 [&work_dir, &target_dir]()
+                 {
+                   ReverseDeployer reverse_deployer(work_dir / "reverse", target_dir, "reverse");
+                   reverse_deployer.addProfile();
+                   reverse_deployer.updateManagedFiles();
+                 });
+    run_scenario("undeploy", [&deployer]() { deployer.unDeploy(); });
+
+    if(str::find(scenarios, "case_matching_deploy") != scenarios.end())
+    {
+      const sfs::path case_staging_dir = work_dir / "case_matching_staging";
+      const sfs::path case_target_dir = work_dir / "case_matching_target";
+      generator.generate(case_staging_dir, case_target_dir);
+      CaseMatchingDeployer case_deployer(case_staging_dir, case_target_dir, "bench");
+      case_deployer.addProfile();
+      for(int mod_id = 0; mod_id < options.num_mods; mod_id++)
+        case_deployer.addMod(mod_id, true, false);
+      run_scenario("case_matching_deploy", [&case_deployer]() { case_deployer.deploy(); });
+    }
+  }
+  catch(const std::exception& error)
+  {
+    std::cerr << std::format("Benchmark failed: {}\n", error.what());
+    if(!keep_files)
+      remove_generated_files();
+    return 1;
+  }
+  if(!keep_files)
+    remove_generated_files();
+
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "  ";
+  if(output_path.empty())
+    std::cout << Json::writeString(builder, results) << "\n";
+  else
+  {
+    std::ofstream file(output_path);
+    file << Json::writeString(builder, results) << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,114 @@
+#include "stagingtreegenerator.h"
+#include <format>
+#include <fstream>
+#include <set>
+
+namespace sfs = std::filesystem;
+
+
+StagingTreeGenerator::StagingTreeGenerator(const Options& options) :
+  options_(options), generator_(options.seed)
+{}
+
+void StagingTreeGenerator::generate(const sfs::path& staging_dir, const sfs::path& target_dir)
+{
+  num_files_ = 0;
+  sfs::create_directories(staging_dir);
+  sfs::create_directories(target_dir);
+  const std::string content(options_.file_size, 'x');
+  std::uniform_real_distribution<double> ratio_distribution(0.0, 1.0);
+  // shared files always use the same directory, so that overlapping mods actually conflict
+  std::vector<std::vector<std::string>> shared_directories;
+  for(int i = 0; i < options_.files_per_mod; i++)
+    shared_directories.push_back(createDirectoryPath());
+  std::uniform_int_distribution<int> shared_distribution(0, options_.files_per_mod - 1);
+
+  for(int mod_id = 0; mod_id < options_.num_mods; mod_id++)
+  {
+    const sfs::path mod_dir = staging_dir / std::to_string(mod_id);
+    sfs::create_directories(mod_dir);
+    std::set<int> used_shared_ids;
+    for(int i = 0; i < options_.files_per_mod; i++)
+    {
+      std::vector<std::string> directory;
+      std::string file_name;
+      const int shared_id = shared_distribution(generator_);
+      if(ratio_distribution(generator_) < options_.overlap_ratio &&
+         used_shared_ids.insert(shared_id).second)
+      {
+        directory = shared_directories[shared_id];
+        file_name = std::format("shared_{}.dat", shared_id);
+      }
+      else
+      {
+        directory = createDirectoryPath();
+        file_name = std::format("mod_{}_file_{}.dat", mod_id, i);
+      }
+      sfs::path target_path = target_dir;
+      sfs::path mod_path = mod_dir;
+      for(const auto& component : directory)
+      {
+        target_path /= component;
+        mod_path /= maybeChangeCase(component);
+      }
+      sfs::create_directories(target_path);
+      sfs::create_directories(mod_path);
+      std::ofstream file(mod_path / maybeChangeCase(file_name), std::ios::binary);
+      file << content;
+      num_files_++;
+    }
+    setOldModificationTimes(mod_dir);
+  }
+}
+
+long StagingTreeGenerator::getNumFiles() const
+{
+  return num_files_;
+}
+
+Json::Value StagingTreeGenerator::toJson() const
+{
+  Json::Value json;
+  json["num_mods"] = options_.num_mods;
+  json["files_per_mod"] = options_.files_per_mod;
+  json["overlap_ratio"] = options_.overlap_ratio;
+  json["depth"] = options_.depth;
+  json["directories_per_level"] = options_.directories_per_level;
+  json["case_collision_ratio"] = options_.case_collision_ratio;
+  json["file_size"] = options_.file_size;
+  json["seed"] = options_.seed;
+  return json;
+}
+
+std::vector<std::string> StagingTreeGenerator::createDirectoryPath()
+{
+  std::uniform_int_distribution<int> distribution(0, options_.directories_per_level - 1);
+  std::vector<std::string> path;
+  for(int level = 0; level < options_.depth; level++)
+    path.push_back(std::format("Directory_{}_{}", level, distribution(generator_)));
+  return path;
+}
+
+std::string StagingTreeGenerator::maybeChangeCase(const std::string& name)
+{
+  if(options_.case_collision_ratio <= 0.0)
+    return name;
+  std::uniform_real_distribution<double> ratio_distribution(0.0, 1.0);
+  if(ratio_distribution(generator_) >= options_.case_collision_ratio)
+    return name;
+  std::string changed = name;
+  for(char& c : changed)
+    c = std::isupper(c) ? std::tolower(c) : std::toupper(c);
+  return changed;
+}
+
+void StagingTreeGenerator::setOldModificationTimes(const sfs::path& path)
+{
+  const auto old_time = sfs::file_time_type::clock::now() - std::chrono::hours(1);
+  sfs::last_write_time(path, old_time);
+  for(const auto& dir_entry : sfs::recursive_directory_iterator(path))
+  {
+    if(dir_entry.is_directory())
+      sfs::last_write_time(dir_entry.path(), old_time);
+  }
+}
@@ -0,0 +1,99 @@
+/*!
+ * \file stagingtreegenerator.h
+ * \brief Header for the StagingTreeGenerator class.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <json/json.h>
+#include <random>
+#include <string>
+#include <vector>
+
+
+/*!
+ * \brief Creates synthetic staging directories containing mods in the format used by the
+ * Installer class, together with a target directory containing the directory structure
+ * those mods are deployed into.
+ */
+class StagingTreeGenerator
+{
+public:
+  /*! \brief Describes the shape of the generated tree. */
+  struct Options
+  {
+    /*! \brief Number of mods to create. */
+    int num_mods = 100;
+    /*! \brief Number of files in every mod. */
+    int files_per_mod = 100;
+    /*! \brief Fraction of files in every mod which are also contained in other mods. */
+    double overlap_ratio = 0.2;
+    /*! \brief Number of directory levels above every file. */
+    int depth = 3;
+    /*! \brief Number of sub directories in every directory. */
+    int directories_per_level = 4;
+    /*!
+     * \brief Fraction of path components the case of which differs from the case used
+     * in the target directory.
+     */
+    double case_collision_ratio = 0.0;
+    /*! \brief Size of every file in bytes. */
+    int file_size = 16;
+    /*! \brief Seed used for all random choices. */
+    unsigned int seed = 0;
+  };
+
+  /*!
+   * \brief Constructor.
+   * \param options Describes the shape of generated trees.
+   */
+  StagingTreeGenerator(const Options& options);
+
+  /*!
+   * \brief Creates all mods in the given staging directory and all directories those mods
+   * contain in the given target directory. Modification times of all mod directories are
+   * set to a point in the past, such that mod file manifests are trusted.
+   * \param staging_dir Directory in which mods are created. Mods use ids starting at 0.
+   * \param target_dir Directory in which the directory structure is created.
+   */
+  void generate(const std::filesystem::path& staging_dir,
+                const std::filesystem::path& target_dir);
+  /*!
+   * \brief Returns the total number of files created by the last call to \ref generate.
+   * \return The number of files.
+   */
+  long getNumFiles() const;
+  /*!
+   * \brief Serializes the options of this generator.
+   * \return Json object containing all options.
+   */
+  Json::Value toJson() const;
+
+private:
+  /*! \brief Describes the shape of generated trees. */
+  Options options_;
+  /*! \brief Used for all random choices. */
+  std::mt19937 generator_;
+  /*! \brief Total number of files created by the last call to \ref generate. */
+  long num_files_ = 0;
+
+  /*!
+   * \brief Creates a random directory path in the canonical case used in the target directory.
+   * \return The path.
+   */
+  std::vector<std::string> createDirectoryPath();
+  /*!
+   * \brief Randomly changes the case of the given path component, depending on
+   * \ref Options::case_collision_ratio.
+   * \param name Component to change.
+   * \return The changed component.
+   */
+  std::string maybeChangeCase(const std::string& name);
+  /*!
+   * \brief Sets the modification time of the given directory and all directories in it
+   * to one hour in the past.
+   * \param path Target directory.
+   */
+  static void setOldModificationTimes(const std::filesystem::path& path);
+};
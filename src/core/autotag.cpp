@@ -108,3 +108,13 @@ int AutoTag::getNumConditions() const
 {
   return conditions_.size();
 }
+
+const TagConditionNode& AutoTag::getEvaluator() const
+{
+  return evaluator_;
+}
+
+void AutoTag::setMods(const std::vector<int>& mods)
+{
+  mods_ = mods;
+}
@@ -13,6 +13,7 @@
 #include <json/json.h>
 #include <optional>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 
@@ -88,11 +89,10 @@ public:
                   const View& mods,
                   std::optional<ProgressNode*> progress_node = {})
   {
+    const std::unordered_set<int> checked_mods(mods.begin(), mods.end());
+    std::erase_if(mods_, [&checked_mods](int mod) { return checked_mods.contains(mod); });
     for(int mod : mods)
     {
-      auto iter = std::ranges::find(mods_, mod);
-      if(iter != mods_.end())
-        mods_.erase(iter);
       if(evaluator_.evaluate(files.at(mod)))
         mods_.push_back(mod);
       if(progress_node)
@@ -145,6 +145,16 @@ public:
    * \return The number of conditions.
    */
   int getNumConditions() const;
+  /*!
+   * \brief Getter for the tree used to evaluate this tags expression.
+   * \return The tree.
+   */
+  const TagConditionNode& getEvaluator() const;
+  /*!
+   * \brief Replaces all mods which have this tag.
+   * \param mods Ids of the mods which have this tag.
+   */
+  void setMods(const std::vector<int>& mods);
   /*!
    * \brief Recursively iterates over all files for all mods with given ids and creates a
    * a map of mod ids to a vector containing pairs of path and file name.
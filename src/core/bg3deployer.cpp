@@ -1,10 +1,13 @@
 #include "bg3deployer.h"
 #include "pathutils.h"
 #include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <format>
 #include <fstream>
 #include <ranges>
+#include <thread>
+#include <unordered_map>
 
 namespace sfs = std::filesystem;
 namespace str = std::ranges;
@@ -71,14 +74,15 @@ std::unordered_set<int> Bg3Deployer::getModConflicts(int mod_id,
   std::unordered_set<int> conflicts{ mod_id };
   if(progress_node)
     (*progress_node)->setTotalSteps(plugins_.size());
-  const std::string plugin_uuid = plugins_[mod_id].first;
-  auto file = pak_files_[uuid_map_[plugin_uuid]];
+  if(pak_conflicts_are_stale_)
+    updatePakConflicts();
+  const sfs::path& pak_path = uuid_map_[plugins_[mod_id].first];
+  const auto& conflicting_paks = pak_conflicts_[pak_path];
   for(const auto& [i, pair] : str::enumerate_view(plugins_))
   {
-    if(i == mod_id)
-      continue;
-    const auto& [uuid, enabled] = pair;
-    if(file.conflictsWith(pak_files_[uuid_map_[uuid]]))
+    const sfs::path& other_pak_path = uuid_map_[pair.first];
+    // plugins in the same pak file always conflict
+    if(other_pak_path == pak_path || conflicting_paks.contains(other_pak_path))
       conflicts.insert(i);
     if(progress_node)
       (*progress_node)->advance();
@@ -86,6 +90,29 @@ std::unordered_set<int> Bg3Deployer::getModConflicts(int mod_id,
   return conflicts;
 }
 
+std::vector<std::unordered_set<int>> Bg3Deployer::getConflictMatrix()
+{
+  if(pak_conflicts_are_stale_)
+    updatePakConflicts();
+  std::map<sfs::path, std::vector<int>> pak_plugins;
+  for(const auto& [i, pair] : str::enumerate_view(plugins_))
+    pak_plugins[uuid_map_[pair.first]].push_back(i);
+  std::vector<std::unordered_set<int>> conflicts(plugins_.size());
+  for(const auto& [pak_path, plugins] : pak_plugins)
+  {
+    std::vector<int> conflicting_plugins = plugins;
+    for(const auto& other_pak_path : pak_conflicts_[pak_path])
+    {
+      if(auto iter = pak_plugins.find(other_pak_path); iter != pak_plugins.end())
+        conflicting_plugins.insert(
+          conflicting_plugins.end(), iter->second.begin(), iter->second.end());
+    }
+    for(int plugin : plugins)
+      conflicts[plugin].insert(conflicting_plugins.begin(), conflicting_plugins.end());
+  }
+  return conflicts;
+}
+
 void Bg3Deployer::updatePlugins()
 {
   updatePluginsPrivate();
@@ -191,7 +218,7 @@ void Bg3Deployer::updateSourceMods()
   const sfs::path relative_path(pu::getRelativePath(source_path_, *deployed_source_path));
   for(const auto& [uuid, _] : plugins_)
   {
-    auto iter = deployed_files.find(relative_path / uuid_map_[uuid]);
+    auto iter = deployed_files.find((relative_path / uuid_map_[uuid]).string());
     if(iter != deployed_files.end())
       source_mods_[uuid] = iter->second;
   }
@@ -232,32 +259,25 @@ void Bg3Deployer::updatePluginsPrivate()
     for(int i : str::reverse_view(plugins_to_remove))
       plugins_.erase(plugins_.begin() + i);
     pak_files_.erase(path);
+    pak_conflicts_are_stale_ = true;
   }
   // add new files and update modified files
+  std::vector<sfs::path> paths_to_parse;
   for(const auto& path : pak_file_paths)
   {
+    if(!pak_files_.contains(path) || !pak_files_[path].timestampsMatch())
+      paths_to_parse.push_back(path);
+  }
+  auto parsed_files = parsePakFiles(paths_to_parse);
+  for(const auto& path : paths_to_parse)
+  {
+    auto parsed_iter = parsed_files.find(path);
+    if(parsed_iter == parsed_files.end())
+      continue;
+    Bg3PakFile& new_file = parsed_iter->second;
+    pak_conflicts_are_stale_ = true;
     if(pak_files_.contains(path))
     {
-      if(pak_files_[path].timestampsMatch())
-        continue;
-
-      Bg3PakFile new_file;
-      try
-      {
-        new_file = Bg3PakFile(path, source_path_);
-      }
-      catch(std::runtime_error& error)
-      {
-        log_(Log::LOG_WARNING,
-             std::format("Failed to parse '{}':\n{}", path.string(), error.what()));
-        continue;
-      }
-      catch(...)
-      {
-        log_(Log::LOG_WARNING, std::format("Failed to parse '{}'.", path.string()));
-        continue;
-      }
-
       std::vector<int> plugins_to_remove;
       for(const auto& old_plugin : pak_files_[path].getPlugins())
       {
@@ -287,33 +307,16 @@ void Bg3Deployer::updatePluginsPrivate()
           uuid_map_[new_plugin.getUuid()] = path;
         }
       }
-      pak_files_[path] = new_file;
+      pak_files_[path] = std::move(new_file);
     }
     else
     {
-      Bg3PakFile new_file;
-      try
-      {
-        new_file = Bg3PakFile(path, source_path_);
-      }
-      catch(std::runtime_error& error)
-      {
-        log_(Log::LOG_WARNING,
-             std::format("Failed to parse '{}':\n{}", path.string(), error.what()));
-        continue;
-      }
-      catch(...)
-      {
-        log_(Log::LOG_WARNING, std::format("Failed to parse '{}'.", path.string()));
-        continue;
-      }
-
       if(new_file.getPlugins().empty())
       {
         log_(Log::LOG_WARNING, std::format("Archive '{}' contains no plugins.", path.string()));
         continue;
       }
-      pak_files_[path] = new_file;
+      pak_files_[path] = std::move(new_file);
       for(const auto& plugin : pak_files_[path].getPlugins())
       {
         auto iter = str::find_if(
@@ -340,10 +343,83 @@ void Bg3Deployer::updatePluginsPrivate()
       }
     }
   }
+  if(pak_conflicts_are_stale_)
+    updatePakConflicts();
   writePluginsPrivate();
   saveSettingsPrivate();
 }
 
+void Bg3Deployer::updatePakConflicts()
+{
+  std::unordered_map<std::string, std::vector<const sfs::path*>> file_index;
+  for(const auto& [path, pak_file] : pak_files_)
+  {
+    for(const auto& file : pak_file.getFileList())
+    {
+      auto& paks = file_index[file.string()];
+      if(paks.empty() || paks.back() != &path)
+        paks.push_back(&path);
+    }
+  }
+  pak_conflicts_.clear();
+  for(const auto& [file, paks] : file_index)
+  {
+    if(paks.size() < 2)
+      continue;
+    for(const sfs::path* path : paks)
+    {
+      for(const sfs::path* other_path : paks)
+      {
+        if(path != other_path)
+          pak_conflicts_[*path].insert(*other_path);
+      }
+    }
+  }
+  pak_conflicts_are_stale_ = false;
+}
+
+std::map<sfs::path, Bg3PakFile> Bg3Deployer::parsePakFiles(const std::vector<sfs::path>& paths)
+{
+  std::vector<std::optional<Bg3PakFile>> pak_files(paths.size());
+  std::vector<std::string> errors(paths.size());
+  std::atomic<size_t> next_file = 0;
+  auto parse_files = [&]()
+  {
+    for(size_t i = next_file++; i < paths.size(); i = next_file++)
+    {
+      try
+      {
+        pak_files[i] = Bg3PakFile(paths[i], source_path_);
+      }
+      catch(std::runtime_error& error)
+      {
+        errors[i] = std::format("Failed to parse '{}':\n{}", paths[i].string(), error.what());
+      }
+      catch(...)
+      {
+        errors[i] = std::format("Failed to parse '{}'.", paths[i].string());
+      }
+    }
+  };
+  const size_t num_threads = std::clamp<size_t>(
+    std::min<size_t>(std::thread::hardware_concurrency(), paths.size()), 1, MAX_PARSER_THREADS);
+  std::vector<std::jthread> threads;
+  for(size_t i = 1; i < num_threads; i++)
+    threads.emplace_back(parse_files);
+  parse_files();
+  threads.clear();
+
+  std::map<sfs::path, Bg3PakFile> parsed_files;
+  for(size_t i = 0; i < paths.size(); i++)
+  {
+    if(pak_files[i])
+      parsed_files.emplace(paths[i], std::move(*pak_files[i]));
+    else
+      log_(Log::LOG_WARNING, errors[i]);
+  }
+  return parsed_files;
+}
+
 void Bg3Deployer::loadSettingsPrivate()
 {
   Json::Value settings;
@@ -370,6 +446,8 @@ void Bg3Deployer::loadSettingsPrivate()
   current_profile_ = settings["current_profile"].asInt();
   pak_files_.clear();
   uuid_map_.clear();
+  // the stored conflicts are only valid if no pak file has been modified since they were saved
+  pak_conflicts_are_stale_ = !settings.isMember("pak_conflicts");
   for(int i = 0; i < settings["pak_files"].size(); i++)
   {
     Bg3PakFile pak_file;
@@ -381,18 +459,33 @@ void Bg3Deployer::loadSettingsPrivate()
     {
       log_(Log::LOG_WARNING,
            std::format("Failed to parse '{}':\n{}", source_path_.string(), error.what()));
+      pak_conflicts_are_stale_ = true;
       continue;
     }
     catch(...)
     {
       log_(Log::LOG_WARNING, std::format("Failed to parse '{}'.", source_path_.string()));
+      pak_conflicts_are_stale_ = true;
       continue;
     }
+    if(pak_file.getModifiedTime() != settings["pak_files"][i]["modified_time"].asInt64())
+      pak_conflicts_are_stale_ = true;
 
     for(const auto& plugin : pak_file.getPlugins())
       uuid_map_[plugin.getUuid()] = pak_file.getSourceFile();
     pak_files_[pak_file.getSourceFile()] = pak_file;
   }
+  pak_conflicts_.clear();
+  if(!pak_conflicts_are_stale_)
+  {
+    const Json::Value& pak_conflicts = settings["pak_conflicts"];
+    for(const auto& path : pak_conflicts.getMemberNames())
+    {
+      auto& conflicts = pak_conflicts_[path];
+      for(int i = 0; i < pak_conflicts[path].size(); i++)
+        conflicts.insert(pak_conflicts[path][i].asString());
+    }
+  }
 }
 
 void Bg3Deployer::writePluginsPrivate() const
@@ -452,6 +545,15 @@ void Bg3Deployer::saveSettingsPrivate() const
   settings["current_profile"] = current_profile_;
   for(const auto& [i, pair] : str::enumerate_view(pak_files_))
     settings["pak_files"][(int)i] = pair.second.toJson();
+  if(!pak_conflicts_are_stale_)
+  {
+    settings["pak_conflicts"] = Json::Value(Json::objectValue);
+    for(const auto& [path, conflicts] : pak_conflicts_)
+    {
+      for(const auto& [i, other_path] : str::enumerate_view(conflicts))
+        settings["pak_conflicts"][path.string()][(int)i] = other_path.string();
+    }
+  }
   sfs::path settings_file_path = dest_path_ / config_file_name_;
   std::ofstream file(settings_file_path, std::fstream::binary);
   if(!file.is_open())
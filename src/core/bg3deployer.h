@@ -52,16 +52,27 @@ public:
   virtual std::unordered_set<int> getModConflicts(
     int mod_id,
     std::optional<ProgressNode*> progress_node = {}) override;
+  /*!
+   * \brief Checks for conflicts between all plugins.
+   * \return For every plugin: The indices of all plugins which conflict with it.
+   */
+  std::vector<std::unordered_set<int>> getConflictMatrix();
 
 protected:
   /*! \brief Name of the mod settings file. */
   static constexpr std::string BG3_PLUGINS_FILE_NAME = "modsettings.lsx";
+  /*! \brief Maximum number of threads used to parse pak files. */
+  static constexpr size_t MAX_PARSER_THREADS = 16;
   /*! \brief Mod fixer is a popular mod which does not contain plugins. */
   static inline const std::set<std::string> NON_PLUGIN_ARCHIVES = { "ModFixer.pak" };
   /*! \brief Maps plugin UUIDs to the pak file containing them. */
   std::map<std::string, std::filesystem::path> uuid_map_;
   /*! \brief Maps pak file paths to the object containing that files plugin data. */
   std::map<std::filesystem::path, Bg3PakFile> pak_files_;
+  /*! \brief Maps pak file paths to all other pak files sharing at least one file with them. */
+  std::map<std::filesystem::path, std::set<std::filesystem::path>> pak_conflicts_;
+  /*! \brief If true: pak_conflicts_ has to be rebuilt from the file lists of all pak files. */
+  bool pak_conflicts_are_stale_ = true;
 
   /*! \brief Wrapper for \ref updatePluginsPrivate. */
   virtual void updatePlugins() override;
@@ -85,6 +96,18 @@ protected:
 private:
   /*! \brief Reads all pak files in the source directory and extracts all plugins. */
   void updatePluginsPrivate();
+  /*!
+   * \brief Parses the given pak files in parallel. Logs a warning for every file which
+   * could not be parsed.
+   * \param paths Paths to the files, relative to the source directory.
+   * \return Maps paths to all successfully parsed files.
+   */
+  std::map<std::filesystem::path, Bg3PakFile> parsePakFiles(
+    const std::vector<std::filesystem::path>& paths);
+  /*!
+   * \brief Rebuilds pak_conflicts_ using an index of all files in all pak files.
+   */
+  void updatePakConflicts();
   /*! \brief Saves pak file and profile data to disk. */
   void saveSettingsPrivate() const;
   /*! \brief Reads pak file and profile data from disk. */
@@ -44,6 +44,16 @@ public:
    * \return The path.
    */
   std::filesystem::path getSourceFile() const;
+  /*!
+   * \brief Returns the paths to all files in this pak file.
+   * \return The paths.
+   */
+  const std::vector<std::filesystem::path>& getFileList() const;
+  /*!
+   * \brief Returns the modification time of the source file at the time it was read.
+   * \return The time.
+   */
+  std::time_t getModifiedTime() const;
   /*!
    * \brief Checks if this file's timestamp matches the modification time on disk.
    * \return True of the times match.
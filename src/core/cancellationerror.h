@@ -0,0 +1,24 @@
+/*!
+ * \file cancellationerror.h
+ * \brief Contains the CancellationError class.
+ */
+
+#pragma once
+
+#include <stdexcept>
+
+
+/*!
+ * \brief Exception indicating that an operation was stopped because its cancellation
+ * was requested.
+ */
+class CancellationError : public std::runtime_error
+{
+public:
+  /*!
+   * \brief Constructor.
+   * \param message Message for the exception.
+   */
+  CancellationError(const char* message = "Operation cancelled.") : std::runtime_error(message)
+  {}
+};
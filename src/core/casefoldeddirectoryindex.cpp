@@ -0,0 +1,128 @@
+#include "casefoldeddirectoryindex.h"
+#include "pathutils.h"
+
+namespace sfs = std::filesystem;
+namespace pu = path_utils;
+
+
+CaseFoldedDirectoryIndex::CaseFoldedDirectoryIndex(const sfs::path& root_path) :
+  root_path_(root_path)
+{}
+
+bool CaseFoldedDirectoryIndex::exists(const std::string& path)
+{
+  if(path.empty())
+    return getDirectory("").exists;
+  const auto [parent, name] = splitPath(path);
+  return getDirectory(parent).entries.contains(name);
+}
+
+bool CaseFoldedDirectoryIndex::isDirectory(const std::string& path)
+{
+  if(path.empty())
+    return getDirectory("").exists;
+  const auto [parent, name] = splitPath(path);
+  const auto& entries = getDirectory(parent).entries;
+  auto iter = entries.find(name);
+  return iter != entries.end() && iter->second;
+}
+
+std::optional<std::string> CaseFoldedDirectoryIndex::findUniqueMatch(const std::string& directory,
+                                                                     const std::string& name)
+{
+  const auto& folded_entries = getDirectory(directory).folded_entries;
+  auto iter = folded_entries.find(pu::toCaseFolded(name));
+  if(iter == folded_entries.end() || iter->second.size() != 1)
+    return {};
+  return iter->second.front();
+}
+
+std::optional<sfs::path> CaseFoldedDirectoryIndex::resolve(const sfs::path& path)
+{
+  if(pu::exists(root_path_ / path))
+    return path.has_filename() ? path : path.parent_path();
+  if(!getDirectory("").exists)
+    return {};
+  std::string actual_path;
+  for(const auto& part : path)
+  {
+    const std::string name = part.string();
+    if(name.empty() || name == ".")
+      continue;
+    if(name == "..")
+    {
+      const size_t separator = actual_path.rfind('/');
+      if(actual_path.empty())
+        actual_path = "..";
+      else if(actual_path == ".." || actual_path.ends_with("/.."))
+        actual_path += "/..";
+      else
+        actual_path.erase(separator == std::string::npos ? 0 : separator);
+      continue;
+    }
+    const Directory& directory = getDirectory(actual_path);
+    if(!actual_path.empty())
+      actual_path += '/';
+    if(directory.entries.contains(name))
+    {
+      actual_path += name;
+      continue;
+    }
+    auto iter = directory.folded_entries.find(pu::toCaseFolded(name));
+    if(iter == directory.folded_entries.end())
+      return {};
+    actual_path += iter->second.front();
+  }
+  return actual_path;
+}
+
+const sfs::path& CaseFoldedDirectoryIndex::getRootPath() const
+{
+  return root_path_;
+}
+
+void CaseFoldedDirectoryIndex::refresh()
+{
+  generation_++;
+}
+
+const CaseFoldedDirectoryIndex::Directory& CaseFoldedDirectoryIndex::getDirectory(
+  const std::string& path)
+{
+  Directory& directory = directories_[path];
+  if(directory.is_read && directory.generation == generation_)
+    return directory;
+  const sfs::path full_path = root_path_ / path;
+  std::error_code error;
+  auto mtime = sfs::last_write_time(full_path, error);
+  if(error)
+    mtime = sfs::file_time_type::min();
+  if(directory.is_read && directory.mtime == mtime)
+  {
+    directory.generation = generation_;
+    return directory;
+  }
+  directory = Directory();
+  directory.is_read = true;
+  directory.generation = generation_;
+  directory.mtime = mtime;
+  sfs::directory_iterator dir_iter(full_path, error);
+  if(error)
+    return directory;
+  directory.exists = true;
+  for(const auto& dir_entry : dir_iter)
+  {
+    const std::string name = dir_entry.path().filename().string();
+    directory.entries[name] = dir_entry.is_directory(error);
+    directory.folded_entries[pu::toCaseFolded(name)].push_back(name);
+  }
+  return directory;
+}
+
+std::pair<std::string, std::string> CaseFoldedDirectoryIndex::splitPath(const std::string& path)
+{
+  const size_t separator = path.rfind('/');
+  if(separator == std::string::npos)
+    return { "", path };
+  return { path.substr(0, separator), path.substr(separator + 1) };
+}
@@ -0,0 +1,109 @@
+/*!
+ * \file casefoldeddirectoryindex.h
+ * \brief Header for the CaseFoldedDirectoryIndex class.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+/*!
+ * \brief Caches the contents of directories in a file tree for case insensitive lookups.
+ * Every directory is read when it is first accessed. After a call to refresh, the modification
+ * time of a cached directory is checked once when it is next accessed and the directory is
+ * read again only if that time has changed. This allows sharing one index between many
+ * lookups in the same tree without touching the file system for every lookup.
+ */
+class CaseFoldedDirectoryIndex
+{
+public:
+  /*!
+   * \brief Creates an empty index for the given directory.
+   * \param root_path Root directory of the indexed tree.
+   */
+  CaseFoldedDirectoryIndex(const std::filesystem::path& root_path = "");
+
+  /*!
+   * \brief Checks if the given path exists, using case sensitive comparison.
+   * \param path Path relative to the root directory.
+   * \return True if the path exists.
+   */
+  bool exists(const std::string& path);
+  /*!
+   * \brief Checks if the given path exists and is a directory, using case sensitive comparison.
+   * \param path Path relative to the root directory. An empty path refers to the root.
+   * \return True if the path is a directory.
+   */
+  bool isDirectory(const std::string& path);
+  /*!
+   * \brief Searches the given directory for entries the names of which match the given name
+   * case insensitively.
+   * \param directory Path to the directory to search, relative to the root directory.
+   * \param name Name to search for.
+   * \return The actual name of the matching entry, if exactly one entry matches.
+   */
+  std::optional<std::string> findUniqueMatch(const std::string& directory,
+                                             const std::string& name);
+  /*!
+   * \brief Finds the actual case of the given path. If the path does not exist exactly,
+   * every component which does not exist exactly is replaced by the first entry in its
+   * directory matching it case insensitively.
+   * \param path Path relative to the root directory. May contain ".." components.
+   * \return The path in its actual case, if found.
+   */
+  std::optional<std::filesystem::path> resolve(const std::filesystem::path& path);
+  /*!
+   * \brief Getter for the root directory of the indexed tree.
+   * \return The root directory.
+   */
+  const std::filesystem::path& getRootPath() const;
+  /*!
+   * \brief Marks all cached directories as possibly outdated. This must be called after
+   * the indexed tree has been modified.
+   */
+  void refresh();
+
+private:
+  /*! \brief Contents of one directory. */
+  struct Directory
+  {
+    /*! \brief True if the directory has been read. */
+    bool is_read = false;
+    /*! \brief True if the directory exists. */
+    bool exists = false;
+    /*! \brief Value of generation_ when the modification time was last checked. */
+    int generation = 0;
+    /*! \brief Modification time of the directory when it was read. */
+    std::filesystem::file_time_type mtime = std::filesystem::file_time_type::min();
+    /*! \brief Maps the names of all entries to whether or not they are directories. */
+    std::unordered_map<std::string, bool> entries;
+    /*! \brief Maps case folded names to all entries with that name. */
+    std::unordered_map<std::string, std::vector<std::string>> folded_entries;
+  };
+
+  /*! \brief Root directory of the indexed tree. */
+  std::filesystem::path root_path_;
+  /*! \brief Maps paths relative to the root directory to their contents. */
+  std::unordered_map<std::string, Directory> directories_;
+  /*! \brief Incremented by every call to refresh. */
+  int generation_ = 0;
+
+  /*!
+   * \brief Returns the contents of the given directory, reading them if they have not been
+   * read yet or if the directory has been modified before the last call to refresh.
+   * \param path Path to the directory, relative to the root directory.
+   * \return The contents.
+   */
+  const Directory& getDirectory(const std::string& path);
+  /*!
+   * \brief Splits the given path into its parent directory and file name.
+   * \param path Path to split.
+   * \return The parent directory and the file name.
+   */
+  static std::pair<std::string, std::string> splitPath(const std::string& path);
+};
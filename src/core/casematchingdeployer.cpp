@@ -2,6 +2,7 @@
 #include "pathutils.h"
 #include <algorithm>
 #include <format>
+#include <unordered_map>
 
 namespace sfs = std::filesystem;
 namespace pu = path_utils;
@@ -34,13 +35,14 @@ void CaseMatchingDeployer::updateDeployedFilesForMod(
   int mod_id,
   std::optional<ProgressNode*> progress_node) const
 {
-  std::map<sfs::path, int> deployed_files = loadDeployedFiles(progress_node);
+  const PathMap deployed_files = loadDeployedFiles(progress_node);
+  CaseFoldedDirectoryIndex mod_files(source_path_ / std::to_string(mod_id));
   for(const auto& [path, id] : deployed_files)
   {
     if(id != mod_id)
       continue;
     const sfs::path dest_path = dest_path_ / path;
-    auto actual_path = pu::pathExists(path, source_path_ / std::to_string(mod_id));
+    auto actual_path = mod_files.resolve(path);
     if(!actual_path)
       continue;
     const sfs::path source_path = source_path_ / std::to_string(mod_id) / *actual_path;
@@ -64,64 +66,149 @@ bool CaseMatchingDeployer::isCaseInvariant() const
   return true;
 }
 
-void CaseMatchingDeployer::adaptDirectoryFiles(const sfs::path& path,
-                                               int mod_id,
-                                               const sfs::path& target_path) const
+DeploymentPlan CaseMatchingDeployer::getDeploymentPlan() const
 {
-  std::vector<sfs::path> directories;
-  for(auto const& dir_entry : sfs::directory_iterator(source_path_ / std::to_string(mod_id) / path))
+  if(loadorders_.empty())
+    return {};
+  std::vector<int> loadorder;
+  for(auto const& [id, enabled] : loadorders_[current_profile_])
   {
-    const std::string relative_path =
-      pu::getRelativePath(dir_entry.path(), source_path_ / std::to_string(mod_id));
-    if(pu::exists(target_path / relative_path))
-    {
-      if(sfs::is_directory(target_path / relative_path))
-        directories.push_back(relative_path);
+    if(enabled)
+      loadorder.push_back(id);
+  }
+  const int64_t last_deployment_time = getLastDeploymentTime();
+  CaseFoldedDirectoryIndex target_index(dest_path_);
+  std::vector<std::pair<int, std::vector<std::string>>> mod_paths;
+  std::set<int> modified_mods;
+  for(int mod_id : loadorder)
+  {
+    if(!checkModPathExistsAndMaybeLogError(mod_id))
       continue;
+    const auto manifest = mod_file_catalog_->getManifest(mod_id, false);
+    std::vector<std::pair<std::string, std::string>> renames;
+    mod_paths.emplace_back(mod_id, matchTargetNames(*manifest, target_index, renames));
+    // renamed mods are scanned again during deployment
+    if(!renames.empty() || manifest->getScanTime() > last_deployment_time)
+      modified_mods.insert(mod_id);
+  }
+
+  const auto file_name_map = getFileNameMap(mod_paths);
+  PathMap source_files;
+  for(const auto& [mod_id, paths] : mod_paths)
+  {
+    for(const auto& path : paths)
+    {
+      std::string folded_prefix;
+      std::string adapted_path;
+      for(const auto& component : sfs::path(path))
+      {
+        const std::string folded_component = pu::toCaseFolded(component.string());
+        folded_prefix =
+          folded_prefix.empty() ? folded_component : folded_prefix + "/" + folded_component;
+        auto iter = file_name_map.find(folded_prefix);
+        const std::string file_name = iter == file_name_map.end()
+                                        ? component.string()
+                                        : sfs::path(iter->second).filename().string();
+        adapted_path = adapted_path.empty() ? file_name : adapted_path + "/" + file_name;
+      }
+      if(adapted_path != path)
+        modified_mods.insert(mod_id);
+      source_files.add(adapted_path, mod_id);
     }
-    std::string file_name = std::prev(dir_entry.path().end())->string();
-    int num_matches = 0;
-    std::string match_file_name = file_name;
-    if(!pu::exists(target_path / path))
+  }
+  source_files.sort();
+  PathMap dest_files = loadDeployedFiles();
+  const PathMap unverified_files = addInterruptedDeployment(dest_files);
+  return createDeploymentPlan(source_files, dest_files, modified_mods, unverified_files);
+}
+
+std::vector<std::string> CaseMatchingDeployer::matchTargetNames(
+  const ModFileManifest& manifest,
+  CaseFoldedDirectoryIndex& target_index,
+  std::vector<std::pair<std::string, std::string>>& renames) const
+{
+  std::vector<std::string> adapted_paths;
+  adapted_paths.reserve(manifest.getEntries().size());
+  // maps directories in the manifest to their path after renaming and to whether or not
+  // they also exist in the target
+  std::unordered_map<std::string, std::pair<std::string, bool>> directories = {
+    { "", { "", true } }
+  };
+  // entries are ordered such that every directory precedes its contents
+  for(const auto& entry : manifest.getEntries())
+  {
+    const sfs::path entry_path(entry.path);
+    auto parent_iter = directories.find(entry_path.parent_path().string());
+    if(parent_iter == directories.end())
+    {
+      adapted_paths.push_back(entry.path);
       continue;
-    for(const auto& dest_entry : sfs::directory_iterator(target_path / path))
+    }
+    const auto& [parent, parent_is_matched] = parent_iter->second;
+    const std::string file_name = entry_path.filename().string();
+    std::string adapted_path = parent.empty() ? file_name : parent + "/" + file_name;
+    bool is_matched = false;
+    if(parent_is_matched)
     {
-      // This method of determining the file name also works for directory names
-      std::string dest_file_name = std::prev(dest_entry.path().end())->string();
-      if(!std::equal(file_name.begin(),
-                     file_name.end(),
-                     dest_file_name.begin(),
-                     dest_file_name.end(),
-                     [](char a, char b) { return std::tolower(a) == std::tolower(b); }))
-        continue;
-      num_matches++;
-      match_file_name = dest_file_name;
-      if(num_matches > 1)
-        break;
+      if(target_index.exists(adapted_path))
+        is_matched = target_index.isDirectory(adapted_path);
+      else if(const auto match = target_index.findUniqueMatch(parent, file_name))
+      {
+        const std::string match_path = parent.empty() ? *match : parent + "/" + *match;
+        renames.emplace_back(adapted_path, match_path);
+        adapted_path = match_path;
+        is_matched = target_index.isDirectory(adapted_path);
+      }
     }
-    if(num_matches == 1)
+    if(entry.is_directory)
+      directories[entry.path] = { adapted_path, is_matched };
+    adapted_paths.push_back(std::move(adapted_path));
+  }
+  return adapted_paths;
+}
+
+std::unordered_map<std::string, std::string> CaseMatchingDeployer::getFileNameMap(
+  const std::vector<std::pair<int, std::vector<std::string>>>& mod_paths)
+{
+  std::unordered_map<std::string, std::string> file_name_map;
+  for(const auto& [mod_id, paths] : mod_paths)
+  {
+    std::vector<const std::string*> sorted_paths;
+    sorted_paths.reserve(paths.size());
+    for(const auto& path : paths)
+      sorted_paths.push_back(&path);
+    std::stable_sort(sorted_paths.begin(),
+                     sorted_paths.end(),
+                     [](const std::string* a, const std::string* b)
+                     { return a->size() > b->size(); });
+    for(const std::string* path : sorted_paths)
+      file_name_map.try_emplace(pu::toCaseFolded(*path), *path);
+  }
+  return file_name_map;
+}
+
+bool CaseMatchingDeployer::adaptDirectoryFiles(int mod_id,
+                                               CaseFoldedDirectoryIndex& target_index) const
+{
+  const sfs::path mod_path = source_path_ / std::to_string(mod_id);
+  const auto manifest = mod_file_catalog_->getManifest(mod_id);
+  std::vector<std::pair<std::string, std::string>> renames;
+  matchTargetNames(*manifest, target_index, renames);
+  bool files_changed = false;
+  for(const auto& [path, match_path] : renames)
+  {
+    // the entry no longer exists if it has already been merged together with its parent
+    if(pu::exists(mod_path / path))
     {
-      const auto source = source_path_ / std::to_string(mod_id) / path / file_name;
-      const auto target = source_path_ / std::to_string(mod_id) / path / match_file_name;
-      if(!pu::exists(target))
-        sfs::rename(source, target);
-      else if(sfs::is_directory(target))
-        pu::moveFilesToDirectory(source, target);
-      else if(match_file_name != file_name)
-        throw std::runtime_error(std::format("Could not rename file '{}' to '{}' "
-                                             "because the target already exists",
-                                             source.string(),
-                                             target.string()));
+      moveModFile(mod_path / path, mod_path / match_path);
+      files_changed = true;
     }
-    if(sfs::is_directory(source_path_ / std::to_string(mod_id) / path / match_file_name))
-      directories.push_back(path / match_file_name);
   }
-  for(const auto& dir : directories)
-    adaptDirectoryFiles(dir, mod_id, target_path);
+  return files_changed;
 }
 
 void CaseMatchingDeployer::adaptLoadorderFiles(const std::vector<int>& loadorder,
-                                               std::optional<ProgressNode*> progress_node) const
+                                               std::optional<ProgressNode*> progress_node)
 {
   log_(Log::LOG_INFO, std::format("Deployer '{}': Matching file names...", name_));
   if(progress_node)
@@ -130,52 +217,74 @@ void CaseMatchingDeployer::adaptLoadorderFiles(const std::vector<int>& loadorder
     (*progress_node)->child(0).setTotalSteps(loadorder.size());
     (*progress_node)->child(1).setTotalSteps(loadorder.size());
   }
+  CaseFoldedDirectoryIndex target_index(dest_path_);
+  std::vector<int> existing_mods;
   for(int mod_id : loadorder)
   {
+    if(progress_node)
+      (*progress_node)->checkStop();
     if(checkModPathExistsAndMaybeLogError(mod_id))
-      adaptDirectoryFiles("", mod_id, dest_path_);
+    {
+      existing_mods.push_back(mod_id);
+      if(adaptDirectoryFiles(mod_id, target_index))
+        invalidateAdaptedMod(mod_id);
+    }
     if(progress_node)
       (*progress_node)->child(0).advance();
   }
 
-  std::map<std::string, std::string> file_name_map;
-  for(int mod_id : loadorder)
+  std::vector<std::pair<int, std::vector<std::string>>> mod_paths;
+  mod_paths.reserve(existing_mods.size());
+  for(int mod_id : existing_mods)
+    mod_paths.emplace_back(mod_id, mod_file_catalog_->getModFiles(mod_id, true));
+  const auto file_name_map = getFileNameMap(mod_paths);
+  for(const auto& [mod_id, paths] : mod_paths)
   {
+    if(progress_node)
+      (*progress_node)->checkStop();
     const sfs::path mod_path = source_path_ / std::to_string(mod_id);
-    std::vector<sfs::path> mod_paths;
-    for(const auto& dir_entry : sfs::recursive_directory_iterator(mod_path))
-      mod_paths.push_back(dir_entry.path());
-    std::sort(mod_paths.begin(),
-              mod_paths.end(),
-              [](const std::string& a, const std::string& b) { return a.size() > b.size(); });
-    for(const auto& path : mod_paths)
+    std::vector<const std::string*> sorted_paths;
+    sorted_paths.reserve(paths.size());
+    for(const auto& path : paths)
+      sorted_paths.push_back(&path);
+    // children are renamed before their parent directories
+    std::stable_sort(sorted_paths.begin(),
+                     sorted_paths.end(),
+                     [](const std::string* a, const std::string* b)
+                     { return a->size() > b->size(); });
+    bool files_changed = false;
+    for(const std::string* relative_path : sorted_paths)
     {
-      const std::string relative_path = pu::getRelativePath(path, mod_path);
-      const std::string file_name = std::prev(sfs::path(relative_path).end())->string();
-      std::string lower_case_path = pu::toLowerCase(relative_path);
-      if(file_name_map.contains(lower_case_path))
-      {
-        const sfs::path target_file_name =
-          std::prev(sfs::path(file_name_map[lower_case_path]).end())->string();
-        if(file_name == target_file_name)
-          continue;
-        const sfs::path source = mod_path / relative_path;
-        const sfs::path target =
-          mod_path / sfs::path(relative_path).parent_path() / target_file_name;
-        if(!pu::exists(target))
-          sfs::rename(source, target);
-        else if(sfs::is_directory(target))
-          pu::moveFilesToDirectory(source, target);
-        else
-          throw std::runtime_error(std::format("Could not rename file '{}' to '{}' "
-                                               "because the target already exists",
-                                               source.string(),
-                                               target.string()));
-      }
-      else
-        file_name_map[lower_case_path] = relative_path;
+      const sfs::path path(*relative_path);
+      const sfs::path target_file_name =
+        sfs::path(file_name_map.at(pu::toCaseFolded(*relative_path))).filename();
+      if(path.filename() == target_file_name)
+        continue;
+      moveModFile(mod_path / path, mod_path / path.parent_path() / target_file_name);
+      files_changed = true;
     }
+    if(files_changed)
+      invalidateAdaptedMod(mod_id);
     if(progress_node)
       (*progress_node)->child(1).advance();
   }
 }
+
+void CaseMatchingDeployer::invalidateAdaptedMod(int mod_id)
+{
+  mod_file_catalog_->invalidate(mod_id);
+  conflict_index_.removeMod(mod_id);
+}
+
+void CaseMatchingDeployer::moveModFile(const sfs::path& source, const sfs::path& target)
+{
+  if(!pu::exists(target))
+    sfs::rename(source, target);
+  else if(sfs::is_directory(target))
+    pu::moveFilesToDirectory(source, target);
+  else
+    throw std::runtime_error(std::format("Could not rename file '{}' to '{}' "
+                                         "because the target already exists",
+                                         source.string(),
+                                         target.string()));
+}
@@ -5,7 +5,9 @@
 
 #pragma once
 
+#include "casefoldeddirectoryindex.h"
 #include "deployer.h"
+#include <unordered_map>
 
 /*!
  * \brief Automatically renames mod files to match the case of target files.
@@ -38,6 +40,13 @@ public:
     std::optional<ProgressNode*> progress_node = {}) override;
   /*! \brief Use base class implementation of overloaded function. */
   using Deployer::deploy;
+  /*!
+   * \brief Determines which file operations would be performed by deploying the current
+   * load order, including the effects of renaming mod files to match the target. No files
+   * are renamed.
+   * \return The deployment plan.
+   */
+  virtual DeploymentPlan getDeploymentPlan() const override;
   /*!
    * \brief Updates the deployed files for one mod to match those in the mod's source directory.
    * \param mod_id Target mod.
@@ -54,15 +63,34 @@ public:
 
 private:
   /*!
-   * \brief Recursively renames every file in source_path_/mod_id/path to the name of a file
-   * in dest_path_, if both match case insensitively.
-   * \param path Path relative to the mods root directory.
+   * \brief Determines the path of every entry in the given manifest after renaming it to
+   * the name of an entry in \ref dest_path_, if both match case insensitively.
+   * \param manifest Manifest of the mod containing the source files.
+   * \param target_index Index of \ref dest_path_, shared by all mods.
+   * \param renames Receives all renames, in the order in which they have to be performed.
+   * \return The new paths of all entries in the manifest, in the same order.
+   */
+  std::vector<std::string> matchTargetNames(
+    const ModFileManifest& manifest,
+    CaseFoldedDirectoryIndex& target_index,
+    std::vector<std::pair<std::string, std::string>>& renames) const;
+  /*!
+   * \brief Maps the case folded version of every path in the given mods to the first
+   * occurrence of that path. Within a mod, longer paths come first.
+   * \param mod_paths Pairs of mod ids and the paths of all entries in that mod, ordered by
+   * the load order.
+   * \return The map.
+   */
+  static std::unordered_map<std::string, std::string> getFileNameMap(
+    const std::vector<std::pair<int, std::vector<std::string>>>& mod_paths);
+  /*!
+   * \brief Renames every file and directory in the given mod to the name of an entry in
+   * \ref dest_path_, if both match case insensitively.
    * \param mod_id Id of the mod containing the source files.
-   * \param target_path Path used for file comparisons.
+   * \param target_index Index of \ref dest_path_, shared by all mods.
+   * \return True if any file has been renamed.
    */
-  void adaptDirectoryFiles(const std::filesystem::path& path,
-                           int mod_id,
-                           const std::filesystem::path& target_path) const;
+  bool adaptDirectoryFiles(int mod_id, CaseFoldedDirectoryIndex& target_index) const;
   /*!
    * \brief Renames every file in every mod in the given load order
    * such that all paths are case invariant and match the case of files in \ref dest_path_.
@@ -70,5 +98,18 @@ private:
    * \param progress_node Used to inform about the current progress of deployment.
    */
   void adaptLoadorderFiles(const std::vector<int>& loadorder,
-                           std::optional<ProgressNode*> progress_node = {}) const;
+                           std::optional<ProgressNode*> progress_node = {});
+  /*!
+   * \brief Deletes all cached file listings for the given mod after its files have been renamed.
+   * \param mod_id Target mod.
+   */
+  void invalidateAdaptedMod(int mod_id);
+  /*!
+   * \brief Renames the given source file. If the target is an existing directory, the source
+   * is merged into it instead. Throws std::runtime_error if the target is an existing file.
+   * \param source File to rename.
+   * \param target New path.
+   */
+  static void moveModFile(const std::filesystem::path& source,
+                          const std::filesystem::path& target);
 };
@@ -0,0 +1,205 @@
+#include "deployedfilesrecord.h"
+#include "parseerror.h"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <ranges>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace sfs = std::filesystem;
+
+
+DeployedFilesRecord::DeployedFilesRecord(const sfs::path& path)
+{
+  const int fd = open(path.c_str(), O_RDONLY);
+  if(fd == -1)
+    throw std::runtime_error("Could not read \"" + path.string() + "\"");
+  struct stat file_stat;
+  if(fstat(fd, &file_stat) != 0)
+  {
+    close(fd);
+    throw std::runtime_error("Could not read \"" + path.string() + "\"");
+  }
+  data_size_ = file_stat.st_size;
+  if(data_size_ < sizeof(Header))
+  {
+    close(fd);
+    throw ParseError("Invalid deployed files record \"" + path.string() + "\"");
+  }
+  data_ = mmap(nullptr, data_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(data_ == MAP_FAILED)
+  {
+    data_ = nullptr;
+    throw std::runtime_error("Could not map \"" + path.string() + "\"");
+  }
+
+  const char* bytes = static_cast<const char*>(data_);
+  header_ = reinterpret_cast<const Header*>(bytes);
+  try
+  {
+    if(std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0 || header_->version != VERSION)
+      throw ParseError("Unsupported deployed files record \"" + path.string() + "\"");
+    const uint64_t expected_size =
+      sizeof(Header) + (static_cast<uint64_t>(header_->num_components) + 1) * sizeof(uint32_t) +
+      static_cast<uint64_t>(header_->num_nodes) * sizeof(Node) +
+      static_cast<uint64_t>(header_->num_files) * sizeof(FileEntry) + header_->string_data_size;
+    if(expected_size != data_size_)
+      throw ParseError("Invalid deployed files record \"" + path.string() + "\"");
+    size_t offset = sizeof(Header);
+    component_offsets_ = reinterpret_cast<const uint32_t*>(bytes + offset);
+    offset += (header_->num_components + 1) * sizeof(uint32_t);
+    nodes_ = reinterpret_cast<const Node*>(bytes + offset);
+    offset += header_->num_nodes * sizeof(Node);
+    files_ = reinterpret_cast<const FileEntry*>(bytes + offset);
+    offset += header_->num_files * sizeof(FileEntry);
+    string_data_ = bytes + offset;
+    validate(path);
+  }
+  catch(...)
+  {
+    munmap(data_, data_size_);
+    throw;
+  }
+}
+
+DeployedFilesRecord::~DeployedFilesRecord()
+{
+  if(data_)
+    munmap(data_, data_size_);
+}
+
+bool DeployedFilesRecord::isBinaryRecord(const sfs::path& path)
+{
+  std::ifstream file(path, std::fstream::binary);
+  char magic[sizeof(MAGIC)];
+  if(!file.read(magic, sizeof(magic)))
+    return false;
+  return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+void DeployedFilesRecord::write(const sfs::path& path, const PathMap& deployed_files)
+{
+  std::vector<uint32_t> component_offsets;
+  std::string string_data;
+  std::vector<Node> nodes;
+  std::vector<FileEntry> files;
+  files.reserve(deployed_files.size());
+  std::unordered_map<std::string_view, uint32_t> component_ids;
+  std::unordered_map<uint64_t, uint32_t> node_ids;
+  for(const auto& [file_path, mod_id] : deployed_files)
+  {
+    uint32_t node = NO_PARENT;
+    for(const auto part : std::views::split(file_path, '/'))
+    {
+      const auto [component_iter, component_added] =
+        component_ids.emplace(std::string_view(part), component_offsets.size());
+      if(component_added)
+      {
+        component_offsets.push_back(string_data.size());
+        string_data.append(component_iter->first);
+      }
+      const uint64_t key = static_cast<uint64_t>(node) << 32 | component_iter->second;
+      const auto [node_iter, node_added] = node_ids.emplace(key, nodes.size());
+      if(node_added)
+        nodes.push_back({ node, component_iter->second });
+      node = node_iter->second;
+    }
+    if(node != NO_PARENT)
+      files.push_back({ node, mod_id });
+  }
+  component_offsets.push_back(string_data.size());
+
+  const Header header{ { MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3] },
+                       VERSION,
+                       static_cast<uint32_t>(component_offsets.size() - 1),
+                       static_cast<uint32_t>(nodes.size()),
+                       static_cast<uint32_t>(files.size()),
+                       static_cast<uint32_t>(string_data.size()) };
+  const sfs::path tmp_path = path.string() + ".tmp";
+  std::ofstream file(tmp_path, std::fstream::binary);
+  if(!file.is_open())
+    throw std::runtime_error("Could not write \"" + tmp_path.string() + "\"");
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(component_offsets.data()),
+             component_offsets.size() * sizeof(uint32_t));
+  file.write(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(Node));
+  file.write(reinterpret_cast<const char*>(files.data()), files.size() * sizeof(FileEntry));
+  file.write(string_data.data(), string_data.size());
+  file.close();
+  if(!file)
+    throw std::runtime_error("Could not write \"" + tmp_path.string() + "\"");
+  sfs::rename(tmp_path, path);
+}
+
+size_t DeployedFilesRecord::size() const
+{
+  return header_->num_files;
+}
+
+std::string DeployedFilesRecord::getPath(size_t index) const
+{
+  std::vector<uint32_t> components;
+  size_t length = 0;
+  for(uint32_t node = files_[index].node; node != NO_PARENT; node = nodes_[node].parent)
+  {
+    components.push_back(nodes_[node].component);
+    length += component_offsets_[nodes_[node].component + 1] -
+              component_offsets_[nodes_[node].component] + 1;
+  }
+  std::string path;
+  path.reserve(length);
+  for(auto iter = components.rbegin(); iter != components.rend(); iter++)
+  {
+    if(!path.empty())
+      path += '/';
+    const uint32_t begin = component_offsets_[*iter];
+    path.append(string_data_ + begin, component_offsets_[*iter + 1] - begin);
+  }
+  return path;
+}
+
+int DeployedFilesRecord::getModId(size_t index) const
+{
+  return files_[index].mod_id;
+}
+
+PathMap DeployedFilesRecord::toPathMap() const
+{
+  PathMap deployed_files;
+  deployed_files.reserve(size());
+  // files are stored in sorted order, so sorting only has an effect for invalid records
+  for(size_t i = 0; i < size(); i++)
+    deployed_files.add(getPath(i), getModId(i));
+  deployed_files.sort();
+  return deployed_files;
+}
+
+void DeployedFilesRecord::validate(const sfs::path& path) const
+{
+  const std::string message = "Invalid deployed files record \"" + path.string() + "\"";
+  if(component_offsets_[header_->num_components] != header_->string_data_size)
+    throw ParseError(message);
+  for(uint32_t i = 0; i < header_->num_components; i++)
+  {
+    if(component_offsets_[i] > component_offsets_[i + 1])
+      throw ParseError(message);
+  }
+  for(uint32_t i = 0; i < header_->num_nodes; i++)
+  {
+    // parents always precede their children, which rules out cycles
+    if(nodes_[i].parent != NO_PARENT && nodes_[i].parent >= i ||
+       nodes_[i].component >= header_->num_components)
+      throw ParseError(message);
+  }
+  for(uint32_t i = 0; i < header_->num_files; i++)
+  {
+    if(files_[i].node >= header_->num_nodes)
+      throw ParseError(message);
+  }
+}
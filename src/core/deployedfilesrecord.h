@@ -0,0 +1,137 @@
+/*!
+ * \file deployedfilesrecord.h
+ * \brief Header for the DeployedFilesRecord class.
+ */
+
+#pragma once
+
+#include "pathmap.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+
+/*!
+ * \brief Provides read access to a binary file storing which files have been deployed from
+ * which mod. The file is memory mapped and accessed in place, so no parsing is required
+ * when it is loaded.
+ *
+ * The file starts with a header, followed by a table of offsets into a block of interned
+ * path components, a table of path nodes, each consisting of a parent node and a component,
+ * and an array of (node, mod id) pairs, sorted by path. The string data follows at the end.
+ */
+class DeployedFilesRecord
+{
+public:
+  /*!
+   * \brief Memory maps the given file and validates its contents.
+   * Throws ParseError if the file is not a valid record.
+   * \param path Path to the file.
+   */
+  DeployedFilesRecord(const std::filesystem::path& path);
+  DeployedFilesRecord(const DeployedFilesRecord&) = delete;
+  DeployedFilesRecord& operator=(const DeployedFilesRecord&) = delete;
+  /*! \brief Unmaps the file. */
+  ~DeployedFilesRecord();
+
+  /*!
+   * \brief Checks if the given file starts with the signature of a binary record.
+   * \param path Path to the file.
+   * \return True if the file is a binary record, false if it is in the legacy JSON format.
+   */
+  static bool isBinaryRecord(const std::filesystem::path& path);
+  /*!
+   * \brief Writes the given files to a new binary record. The target file is replaced
+   * atomically.
+   * \param path Path to the target file.
+   * \param deployed_files Maps deployed files to the mods from which they were deployed.
+   */
+  static void write(const std::filesystem::path& path, const PathMap& deployed_files);
+
+  /*!
+   * \brief Returns the number of files in this record.
+   * \return The number of files.
+   */
+  size_t size() const;
+  /*!
+   * \brief Reconstructs the path of the file at the given index. Files are sorted by path.
+   * \param index Index of the file.
+   * \return The path, relative to the target directory.
+   */
+  std::string getPath(size_t index) const;
+  /*!
+   * \brief Returns the id of the mod from which the file at the given index was deployed.
+   * \param index Index of the file.
+   * \return The mod id.
+   */
+  int getModId(size_t index) const;
+  /*!
+   * \brief Creates a map of all files in this record to their source mods.
+   * \return The map.
+   */
+  PathMap toPathMap() const;
+
+private:
+  /*! \brief Fixed size header at the start of every record. */
+  struct Header
+  {
+    /*! \brief File signature. */
+    char magic[4];
+    /*! \brief Version of the file format. */
+    uint32_t version;
+    /*! \brief Number of interned path components. */
+    uint32_t num_components;
+    /*! \brief Number of path nodes. */
+    uint32_t num_nodes;
+    /*! \brief Number of deployed files. */
+    uint32_t num_files;
+    /*! \brief Size of the string data block in bytes. */
+    uint32_t string_data_size;
+  };
+
+  /*! \brief One component of a path, linked to the node representing its parent directory. */
+  struct Node
+  {
+    /*! \brief Index of the parent node or NO_PARENT for top level paths. */
+    uint32_t parent;
+    /*! \brief Index of the path component. */
+    uint32_t component;
+  };
+
+  /*! \brief One deployed file. */
+  struct FileEntry
+  {
+    /*! \brief Index of the node representing the files path. */
+    uint32_t node;
+    /*! \brief Mod from which the file was deployed. */
+    int32_t mod_id;
+  };
+
+  /*! \brief Signature at the start of every binary record. */
+  static constexpr char MAGIC[4] = { 'L', 'M', 'M', 'F' };
+  /*! \brief Version of the file format. */
+  static constexpr uint32_t VERSION = 1;
+  /*! \brief Parent index used for nodes without parent. */
+  static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+  /*! \brief Start of the mapped file. */
+  void* data_ = nullptr;
+  /*! \brief Size of the mapped file. */
+  size_t data_size_ = 0;
+  /*! \brief The files header. */
+  const Header* header_ = nullptr;
+  /*! \brief Offsets of all path components in the string data block. */
+  const uint32_t* component_offsets_ = nullptr;
+  /*! \brief All path nodes. */
+  const Node* nodes_ = nullptr;
+  /*! \brief All deployed files. */
+  const FileEntry* files_ = nullptr;
+  /*! \brief Contains all path components. */
+  const char* string_data_ = nullptr;
+
+  /*!
+   * \brief Checks if all offsets and indices in the mapped file are within bounds.
+   * \param path Path to the file, used for error messages.
+   */
+  void validate(const std::filesystem::path& path) const;
+};
@@ -1,12 +1,18 @@
 #include "deployer.h"
+#include "deployedfilesrecord.h"
 #include "pathutils.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <format>
 #include <fstream>
 #include <iostream>
 #include <json/json.h>
+#include <numeric>
 #include <ranges>
 #include <set>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace str = std::ranges;
@@ -19,7 +25,8 @@ Deployer::Deployer(const sfs::path& source_path,
                    const sfs::path& dest_path,
                    const std::string& name,
                    DeployMode deploy_mode) :
-  source_path_(source_path), dest_path_(dest_path), name_(name), deploy_mode_(deploy_mode)
+  source_path_(source_path), dest_path_(dest_path), name_(name), deploy_mode_(deploy_mode),
+  mod_file_catalog_(std::make_shared<ModFileCatalog>(source_path))
 {}
 
 std::string Deployer::getDestPath() const
@@ -45,21 +52,49 @@ void Deployer::setName(const std::string& name)
 std::map<int, unsigned long> Deployer::deploy(const std::vector<int>& loadorder,
                                               std::optional<ProgressNode*> progress_node)
 {
-  auto [source_files, mod_sizes] = getDeploymentSourceFilesAndModSizes(loadorder);
+  auto [source_files, mod_sizes, modified_mods] =
+    getDeploymentSourceFilesAndModSizes(loadorder, getLastDeploymentTime());
+  // mods changed outside of this application since the last deployment are indexed again
+  for(int mod_id : modified_mods)
+    conflict_index_.removeMod(mod_id);
+  if(progress_node)
+    (*progress_node)->addChildren({ 2, 5, 1 });
+  PathMap dest_files =
+    loadDeployedFiles(progress_node ? &(*progress_node)->child(0) : std::optional<ProgressNode*>{});
+  const PathMap unverified_files = addInterruptedDeployment(dest_files);
+  const auto plan =
+    createDeploymentPlan(source_files, dest_files, modified_mods, unverified_files);
   log_(Log::LOG_INFO,
-       std::format("Deployer '{}': Deploying {} files for {} mods...",
+       std::format("Deployer '{}': Deploying {} files for {} mods. {} files need to be changed...",
                    name_,
                    source_files.size(),
-                   loadorder.size()));
+                   loadorder.size(),
+                   plan.getNumChanges()));
   if(progress_node)
-    (*progress_node)->addChildren({ 2, 5, 1 });
-  std::map<sfs::path, int> dest_files =
-    loadDeployedFiles(progress_node ? &(*progress_node)->child(0) : std::optional<ProgressNode*>{});
-  backupOrRestoreFiles(source_files, dest_files);
-  deployFiles(source_files,
-              progress_node ? &(*progress_node)->child(1) : std::optional<ProgressNode*>{});
+    (*progress_node)->checkStop();
+  backupOrRestoreFiles(plan);
+
+  // every file which may be changed from here on is recorded, so that an interrupted
+  // deployment can be completed or reverted by the next deployment
+  const sfs::path journal_path = dest_path_ / deployment_journal_name_;
+  if(plan.getNumChanges() > 0)
+  {
+    PathMap journal;
+    journal.reserve(plan.getNumChanges());
+    for(const auto* plan_files :
+        { &plan.files_to_create, &plan.files_to_replace, &plan.files_to_remove })
+    {
+      for(const auto& [path, mod_id] : *plan_files)
+        journal.add(path.string(), mod_id);
+    }
+    journal.sort();
+    DeployedFilesRecord::write(journal_path, journal);
+  }
+
+  deployFiles(plan, progress_node ? &(*progress_node)->child(1) : std::optional<ProgressNode*>{});
   saveDeployedFiles(source_files,
                     progress_node ? &(*progress_node)->child(2) : std::optional<ProgressNode*>{});
+  sfs::remove(journal_path);
   return mod_sizes;
 }
 
@@ -74,6 +109,23 @@ std::map<int, unsigned long> Deployer::deploy(std::optional<ProgressNode*> progr
   return deploy(loadorder, progress_node);
 }
 
+DeploymentPlan Deployer::getDeploymentPlan() const
+{
+  if(is_autonomous_ || loadorders_.empty())
+    return {};
+  std::vector<int> loadorder;
+  for(auto const& [id, enabled] : loadorders_[current_profile_])
+  {
+    if(enabled)
+      loadorder.push_back(id);
+  }
+  auto [source_files, mod_sizes, modified_mods] =
+    getDeploymentSourceFilesAndModSizes(loadorder, getLastDeploymentTime(), false);
+  PathMap dest_files = loadDeployedFiles();
+  const PathMap unverified_files = addInterruptedDeployment(dest_files);
+  return createDeploymentPlan(source_files, dest_files, modified_mods, unverified_files);
+}
+
 void Deployer::unDeploy(std::optional<ProgressNode*> progress_node)
 {
   log_(Log::LOG_DEBUG, "Undeploying...");
@@ -124,7 +176,7 @@ bool Deployer::addMod(int mod_id, bool enabled, bool update_conflicts)
     return false;
   loadorders_[current_profile_].emplace_back(mod_id, enabled);
   if(update_conflicts && auto_update_conflict_groups_)
-    updateConflictGroups();
+    addModToConflictGroups(mod_id);
   return true;
 }
 
@@ -137,7 +189,8 @@ bool Deployer::removeMod(int mod_id)
     return false;
   loadorders_[current_profile_].erase(iter);
   if(auto_update_conflict_groups_)
-    updateConflictGroups();
+    removeModFromConflictGroups(mod_id);
+  removeUnusedModFromConflictIndex(mod_id);
   return true;
 }
 
@@ -161,41 +214,40 @@ bool Deployer::hasMod(int mod_id) const
 std::vector<ConflictInfo> Deployer::getFileConflicts(
   int mod_id,
   bool show_disabled,
-  std::optional<ProgressNode*> progress_node) const
+  std::optional<ProgressNode*> progress_node)
 {
   std::vector<ConflictInfo> conflicts;
   if(!checkModPathExistsAndMaybeLogError(mod_id))
     return conflicts;
-  std::vector<std::string> mod_files = getModFiles(mod_id, false);
-  std::vector<int> loadorder;
-  for(const auto& [id, enabled] : loadorders_[current_profile_])
+  updateConflictIndex(mod_id);
+  std::unordered_map<int, int> loadorder_positions;
+  for(const auto& [i, mod] : str::enumerate_view(loadorders_[current_profile_]))
   {
+    const auto& [id, enabled] = mod;
     if(enabled || show_disabled)
-      loadorder.push_back(id);
+      loadorder_positions[id] = i;
   }
 
+  const auto& mod_files = conflict_index_.getModFiles(mod_id);
   if(progress_node)
-    (*progress_node)->setTotalSteps(loadorder.size() * mod_files.size());
-  std::vector<std::vector<int>> overwrite_orders;
-  overwrite_orders.reserve(mod_files.size());
-  for(const auto& [i, path] : str::enumerate_view(mod_files))
+    (*progress_node)->setTotalSteps(mod_files.size());
+  for(const std::string* path : mod_files)
   {
-    overwrite_orders.push_back({});
-    for(int cur_id : loadorder)
+    std::vector<int> overwrite_order;
+    for(int cur_id : conflict_index_.getModsForFile(*path))
     {
-      if(!checkModPathExistsAndMaybeLogError(cur_id))
-        continue;
-      if(sfs::exists(source_path_ / std::to_string(cur_id) / path))
-        overwrite_orders[i].push_back(cur_id);
-      if(progress_node)
-        (*progress_node)->advance();
+      if(loadorder_positions.contains(cur_id))
+        overwrite_order.push_back(cur_id);
     }
-  }
-
-  for(const auto& [path, order] : str::zip_view(mod_files, overwrite_orders))
-  {
-    if(order.size() > 1)
-      conflicts.push_back({ path, order, {} });
+    if(overwrite_order.size() > 1)
+    {
+      str::sort(overwrite_order,
+                [&loadorder_positions](int a, int b)
+                { return loadorder_positions[a] < loadorder_positions[b]; });
+      conflicts.push_back({ *path, overwrite_order, {} });
+    }
+    if(progress_node)
+      (*progress_node)->advance();
   }
 
   return conflicts;
@@ -220,29 +272,26 @@ std::unordered_set<int> Deployer::getModConflicts(int mod_id,
                                                   std::optional<ProgressNode*> progress_node)
 {
   std::unordered_set<int> conflicts{ mod_id };
-  std::vector<std::string> mod_files = getModFiles(mod_id, false);
   if(!checkModPathExistsAndMaybeLogError(mod_id))
     return conflicts;
   if(progress_node)
-    (*progress_node)->setTotalSteps(loadorders_[current_profile_].size());
-  for(const auto& [cur_id, _] : loadorders_[current_profile_])
+    (*progress_node)->setTotalSteps(1);
+  updateConflictIndex(mod_id);
+  for(int cur_id : conflict_index_.getConflictingMods(mod_id))
   {
-    if(!checkModPathExistsAndMaybeLogError(cur_id))
-      continue;
-    for(const auto& path : mod_files)
-    {
-      if(sfs::exists(source_path_ / std::to_string(cur_id) / path))
-      {
-        conflicts.insert(cur_id);
-        break;
-      }
-    }
-    if(progress_node)
-      (*progress_node)->advance();
+    if(hasMod(cur_id))
+      conflicts.insert(cur_id);
   }
+  if(progress_node)
+    (*progress_node)->advance();
   return conflicts;
 }
 
+void Deployer::invalidateModFiles(int mod_id)
+{
+  conflict_index_.removeMod(mod_id);
+}
+
 void Deployer::addProfile(int source)
 {
   if(source < 0 || source >= loadorders_.size())
@@ -359,6 +408,7 @@ bool Deployer::swapMod(int old_id, int new_id)
   if(iter == loadorders_[current_profile_].end() || std::get<0>(*iter) == new_id)
     return false;
   *iter = { new_id, std::get<1>(*iter) };
+  removeUnusedModFromConflictIndex(old_id);
   if(auto_update_conflict_groups_)
     updateConflictGroups();
   return true;
@@ -421,74 +471,112 @@ std::filesystem::path Deployer::sourcePath() const
 void Deployer::setSourcePath(const sfs::path& newSourcePath)
 {
   source_path_ = newSourcePath;
+  conflict_index_.clear();
+  mod_file_catalog_ = std::make_shared<ModFileCatalog>(source_path_);
 }
 
-std::pair<std::map<std::filesystem::path, int>, std::map<int, unsigned long>>
-Deployer::getDeploymentSourceFilesAndModSizes(const std::vector<int>& loadorder) const
+void Deployer::setModFileCatalog(std::shared_ptr<ModFileCatalog> catalog)
 {
-  std::map<sfs::path, int> source_files{};
+  if(catalog->getStagingDir() == source_path_)
+    mod_file_catalog_ = catalog;
+}
+
+std::tuple<PathMap, std::map<int, unsigned long>, std::set<int>>
+Deployer::getDeploymentSourceFilesAndModSizes(const std::vector<int>& loadorder,
+                                              int64_t modified_after,
+                                              bool persist_manifests) const
+{
+  PathMap source_files{};
   std::map<int, unsigned long> mod_sizes{};
-  for(int i = loadorder.size() - 1; i >= 0; i--)
+  std::set<int> modified_mods{};
+  // later mods in the load order overwrite files from earlier mods
+  for(int mod_id : loadorder)
   {
-    if(!checkModPathExistsAndMaybeLogError(loadorder[i]))
+    if(!checkModPathExistsAndMaybeLogError(mod_id))
       continue;
-    sfs::path mod_base_path = source_path_ / std::to_string(loadorder[i]);
-    unsigned long mod_size = 0;
-    for(auto const& dir_entry : sfs::recursive_directory_iterator(mod_base_path))
+    const auto manifest = mod_file_catalog_->getManifest(mod_id, persist_manifests);
+    for(const auto& entry : manifest->getEntries())
+      source_files.add(entry.path, mod_id);
+    mod_sizes[mod_id] = manifest->getModSize();
+    if(manifest->getScanTime() > modified_after)
+      modified_mods.insert(mod_id);
+  }
+  source_files.sort();
+  return { std::move(source_files), mod_sizes, modified_mods };
+}
+
+DeploymentPlan Deployer::createDeploymentPlan(const PathMap& source_files,
+                                              const PathMap& dest_files,
+                                              const std::set<int>& modified_mods,
+                                              const PathMap& unverified_files) const
+{
+  DeploymentPlan plan;
+  auto source_iter = source_files.begin();
+  auto dest_iter = dest_files.begin();
+  while(source_iter != source_files.end() || dest_iter != dest_files.end())
+  {
+    if(dest_iter == dest_files.end() ||
+       source_iter != source_files.end() && PathMap::less(source_iter->first, dest_iter->first))
     {
-      const bool is_regular_file = dir_entry.is_regular_file();
-      if(is_regular_file)
-        mod_size += dir_entry.file_size();
-      if(is_regular_file || dir_entry.is_directory())
-        source_files.insert({ pu::getRelativePath(dir_entry.path(), mod_base_path), loadorder[i] });
+      plan.files_to_create.emplace_back(source_iter->first, source_iter->second);
+      const sfs::path absolute_path = dest_path_ / source_iter->first;
+      if(pu::exists(absolute_path) && !sfs::is_directory(absolute_path))
+        plan.files_to_back_up.push_back(source_iter->first);
+      source_iter++;
+    }
+    else if(source_iter == source_files.end() ||
+            PathMap::less(dest_iter->first, source_iter->first))
+    {
+      plan.files_to_remove.emplace_back(dest_iter->first, dest_iter->second);
+      dest_iter++;
+    }
+    else
+    {
+      // copied files may have been modified in place, so they are always redeployed
+      if(source_iter->second != dest_iter->second || deploy_mode_ == copy ||
+         modified_mods.contains(source_iter->second) ||
+         unverified_files.contains(source_iter->first))
+        plan.files_to_replace.emplace_back(source_iter->first, source_iter->second);
+      else
+        plan.num_unchanged_files++;
+      source_iter++;
+      dest_iter++;
     }
-    mod_sizes[loadorder[i]] = mod_size;
   }
-  return { source_files, mod_sizes };
+  return plan;
 }
 
-void Deployer::backupOrRestoreFiles(const std::map<sfs::path, int>& source_files,
-                                    const std::map<sfs::path, int>& dest_files) const
+void Deployer::backupOrRestoreFiles(const DeploymentPlan& plan) const
 {
-  std::map<sfs::path, int> restore_targets;
-  std::map<sfs::path, int> backup_targets;
-  std::set_difference(dest_files.begin(),
-                      dest_files.end(),
-                      source_files.begin(),
-                      source_files.end(),
-                      std::inserter(restore_targets, restore_targets.begin()),
-                      dest_files.value_comp());
-  std::set_difference(source_files.begin(),
-                      source_files.end(),
-                      dest_files.begin(),
-                      dest_files.end(),
-                      std::inserter(backup_targets, backup_targets.begin()),
-                      source_files.value_comp());
-
-  std::map<sfs::path, int> restore_directories;
-  for(const auto& [path, id] : restore_targets)
+  std::vector<sfs::path> restore_directories;
+  for(const auto& [path, id] : plan.files_to_remove)
   {
     sfs::path absolute_path = dest_path_ / path;
+    sfs::path backup_name = absolute_path.string() + backup_extension_;
     if(!pu::exists(absolute_path))
+    {
+      // the file may never have been deployed by an interrupted deployment
+      if(pu::exists(backup_name))
+        sfs::rename(backup_name, absolute_path);
       continue;
+    }
     if(sfs::is_directory(absolute_path))
     {
-      restore_directories[path] = id;
+      restore_directories.push_back(path);
       continue;
     }
-    sfs::path backup_name = absolute_path.string() + backup_extension_;
     sfs::remove(absolute_path);
     if(pu::exists(backup_name))
       sfs::rename(backup_name, absolute_path);
   }
-  for(const auto& [path, id] : restore_directories)
+  for(const auto& path : restore_directories)
   {
     sfs::path absolute_path = dest_path_ / path;
     if(pu::directoryIsEmpty(absolute_path, {managed_dir_file_name_}))
       sfs::remove_all(absolute_path);
   }
 
-  for(const auto& [path, id] : backup_targets)
+  for(const auto& path : plan.files_to_back_up)
   {
     sfs::path absolute_path = dest_path_ / path;
     sfs::path backup_name = absolute_path.string() + backup_extension_;
@@ -497,46 +585,131 @@ void Deployer::backupOrRestoreFiles(const std::map<sfs::path, int>& source_files
   }
 }
 
-void Deployer::deployFiles(const std::map<sfs::path, int>& source_files,
+void Deployer::deployFiles(const DeploymentPlan& plan,
                            std::optional<ProgressNode*> progress_node) const
 {
   if(progress_node)
-    (*progress_node)->setTotalSteps(source_files.size());
+    (*progress_node)->setTotalSteps(plan.files_to_create.size() + plan.files_to_replace.size());
 
-  for(const auto& [path, id] : source_files)
+  std::vector<const std::pair<sfs::path, int>*> files;
+  files.reserve(plan.files_to_create.size() + plan.files_to_replace.size());
+  std::map<int, bool> mod_exists;
+  std::set<sfs::path> directories;
+  for(const auto* plan_files : { &plan.files_to_create, &plan.files_to_replace })
   {
-    sfs::path dest_path = dest_path_ / path;
-    if(!checkModPathExistsAndMaybeLogError(id))
-      continue;
-    sfs::path source_path = source_path_ / std::to_string(id) / path;
-    if(sfs::is_directory(source_path) ||
-       pu::exists(dest_path) && (deploy_mode_ == hard_link && !sfs::is_symlink(dest_path) &&
-                                    sfs::equivalent(source_path, dest_path) ||
-                                  deploy_mode_ == sym_link && sfs::is_symlink(dest_path) &&
-                                    sfs::read_symlink(dest_path) == source_path))
+    for(const auto& file : *plan_files)
+    {
+      auto iter = mod_exists.find(file.second);
+      if(iter == mod_exists.end())
+      {
+        const bool exists = checkModPathExistsAndMaybeLogError(file.second);
+        iter = mod_exists.emplace(file.second, exists).first;
+      }
+      if(!iter->second)
+        continue;
+      directories.insert((dest_path_ / file.first).parent_path());
+      files.push_back(&file);
+    }
+  }
+
+  // Create all directories first, so that files can be linked in any order
+  for(const auto& directory : directories)
+  {
+    sfs::create_directories(directory);
+    removeManagedDirFile(directory);
+  }
+
+  std::vector<std::exception_ptr> errors(files.size());
+  std::atomic<size_t> next_file = 0;
+  auto deploy_files = [&]()
+  {
+    for(size_t i = next_file++; i < files.size(); i = next_file++)
     {
+      if(progress_node && (*progress_node)->stopRequested())
+        return;
+      try
+      {
+        deployFile(files[i]->first, files[i]->second);
+      }
+      catch(...)
+      {
+        errors[i] = std::current_exception();
+      }
       if(progress_node)
         (*progress_node)->advance();
+    }
+  };
+  const size_t max_threads =
+    std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_DEPLOY_THREADS);
+  const size_t num_threads =
+    std::clamp<size_t>(files.size() / MIN_FILES_PER_DEPLOY_THREAD, 1, max_threads);
+  std::vector<std::jthread> threads;
+  for(size_t i = 1; i < num_threads; i++)
+    threads.emplace_back(deploy_files);
+  deploy_files();
+  threads.clear();
+
+  std::exception_ptr first_error;
+  for(const auto& [file, error] : stv::zip(files, errors))
+  {
+    if(!error)
       continue;
+    if(!first_error)
+      first_error = error;
+    try
+    {
+      std::rethrow_exception(error);
+    }
+    catch(const std::exception& e)
+    {
+      log_(Log::LOG_ERROR,
+           std::format("Failed to deploy \"{}\" from mod with id {}: {}",
+                       file->first.string(),
+                       file->second,
+                       e.what()));
+    }
+    catch(...)
+    {
+      log_(Log::LOG_ERROR,
+           std::format("Failed to deploy \"{}\" from mod with id {}",
+                       file->first.string(),
+                       file->second));
     }
-    const auto parent_path = dest_path.parent_path();
-    sfs::create_directories(parent_path);
-    removeManagedDirFile(parent_path);
-    sfs::remove(dest_path);
-    if(deploy_mode_ == copy)
-      sfs::copy_file(source_path, dest_path);
-    else if(deploy_mode_ == sym_link)
-      sfs::create_symlink(source_path, dest_path);
-    else
-      sfs::create_hard_link(source_path, dest_path);
-
-    if(progress_node)
-      (*progress_node)->advance();
   }
+  if(first_error)
+    std::rethrow_exception(first_error);
+  if(progress_node)
+    (*progress_node)->checkStop();
+}
+
+void Deployer::deployFile(const sfs::path& path, int mod_id) const
+{
+  const sfs::path dest_path = dest_path_ / path;
+  const sfs::path source_path = source_path_ / std::to_string(mod_id) / path;
+  if(sfs::is_directory(source_path) || fileIsDeployed(path, mod_id))
+    return;
+  sfs::remove(dest_path);
+  if(deploy_mode_ == copy)
+    sfs::copy_file(source_path, dest_path);
+  else if(deploy_mode_ == sym_link)
+    sfs::create_symlink(source_path, dest_path);
+  else
+    sfs::create_hard_link(source_path, dest_path);
 }
 
-std::map<sfs::path, int> Deployer::loadDeployedFiles(std::optional<ProgressNode*> progress_node,
-                                                     sfs::path dest_path) const
+int64_t Deployer::getLastDeploymentTime() const
+{
+  const sfs::path deployed_files_path = dest_path_ / deployed_files_name_;
+  if(!sfs::exists(deployed_files_path))
+    return 0;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::file_clock::to_sys(sfs::last_write_time(deployed_files_path))
+             .time_since_epoch())
+    .count();
+}
+
+PathMap Deployer::loadDeployedFiles(std::optional<ProgressNode*> progress_node,
+                                    sfs::path dest_path) const
 {
   if(dest_path == "")
     dest_path = dest_path_;
@@ -545,10 +718,24 @@ std::map<sfs::path, int> Deployer::loadDeployedFiles(std::optional<ProgressNode*
     (*progress_node)->addChildren({ 1, 2 });
     (*progress_node)->child(0).setTotalSteps(1);
   }
-  std::map<sfs::path, int> deployed_files;
+  PathMap deployed_files;
   sfs::path deployed_files_path = dest_path / deployed_files_name_;
   if(!sfs::exists(deployed_files_path))
     return deployed_files;
+  if(DeployedFilesRecord::isBinaryRecord(deployed_files_path))
+  {
+    DeployedFilesRecord record(deployed_files_path);
+    if(progress_node)
+    {
+      (*progress_node)->child(0).advance();
+      (*progress_node)->child(1).setTotalSteps(1);
+    }
+    deployed_files = record.toPathMap();
+    if(progress_node)
+      (*progress_node)->child(1).advance();
+    return deployed_files;
+  }
+  // legacy format, replaced by a binary record on the next deployment
   std::ifstream file(deployed_files_path, std::fstream::binary);
   if(!file.is_open())
     throw std::runtime_error("Could not read \"" + deployed_files_path.string() + "\"");
@@ -559,57 +746,80 @@ std::map<sfs::path, int> Deployer::loadDeployedFiles(std::optional<ProgressNode*
     (*progress_node)->child(0).advance();
     (*progress_node)->child(1).setTotalSteps(json_object["files"].size());
   }
+  deployed_files.reserve(json_object["files"].size());
   for(int i = 0; i < json_object["files"].size(); i++)
   {
-    deployed_files[json_object["files"][i]["path"].asString()] =
-      json_object["files"][i]["mod_id"].asInt();
+    deployed_files.add(json_object["files"][i]["path"].asString(),
+                       json_object["files"][i]["mod_id"].asInt());
     if(progress_node)
       (*progress_node)->child(1).advance();
   }
+  deployed_files.sort();
   return deployed_files;
 }
 
-void Deployer::saveDeployedFiles(const std::map<sfs::path, int>& deployed_files,
+void Deployer::saveDeployedFiles(const PathMap& deployed_files,
                                  std::optional<ProgressNode*> progress_node) const
 {
   if(progress_node)
   {
     (*progress_node)->addChildren({ 1, 1 });
-    (*progress_node)->child(0).setTotalSteps(deployed_files.size());
+    (*progress_node)->child(0).setTotalSteps(1);
     (*progress_node)->child(1).setTotalSteps(1);
   }
-  sfs::path deployed_files_path = dest_path_ / deployed_files_name_;
-  std::ofstream file(deployed_files_path, std::fstream::binary);
-  if(!file.is_open())
-    throw std::runtime_error("Could not write \"" + deployed_files_path.string() + "\"");
-  Json::Value json_object;
-  int i = 0;
-  for(auto const& [path, id] : deployed_files)
-  {
-    json_object["files"][i]["path"] = path.c_str();
-    json_object["files"][i]["mod_id"] = id;
-    i++;
-    if(progress_node)
-      (*progress_node)->child(0).advance();
-  }
-  file << json_object;
-  file.close();
+  DeployedFilesRecord::write(dest_path_ / deployed_files_name_, deployed_files);
   if(progress_node)
+  {
+    (*progress_node)->child(0).advance();
     (*progress_node)->child(1).advance();
+  }
 }
 
-std::vector<std::string> Deployer::getModFiles(int mod_id, bool include_directories) const
+bool Deployer::fileIsDeployed(const sfs::path& path, int mod_id) const
 {
-  std::vector<std::string> mod_files;
-  if(!checkModPathExistsAndMaybeLogError(mod_id))
-    return mod_files;
-  sfs::path mod_base_path = source_path_ / std::to_string(mod_id);
-  for(const auto& dir_entry : sfs::recursive_directory_iterator(mod_base_path))
+  const sfs::path dest_path = dest_path_ / path;
+  const sfs::path source_path = source_path_ / std::to_string(mod_id) / path;
+  const auto dest_status = sfs::symlink_status(dest_path);
+  if(dest_status.type() == sfs::file_type::not_found)
+    return false;
+  if(sfs::is_directory(dest_status))
+    return sfs::is_directory(source_path);
+  std::error_code error;
+  if(deploy_mode_ == hard_link)
+    return sfs::is_regular_file(dest_status) && sfs::equivalent(source_path, dest_path, error);
+  if(deploy_mode_ == sym_link)
+    return sfs::is_symlink(dest_status) && sfs::read_symlink(dest_path, error) == source_path;
+  // copies can not be checked without reading them
+  return false;
+}
+
+PathMap Deployer::addInterruptedDeployment(PathMap& dest_files) const
+{
+  const sfs::path journal_path = dest_path_ / deployment_journal_name_;
+  if(!pu::exists(journal_path))
+    return {};
+  log_(Log::LOG_INFO, std::format("Deployer '{}': Completing interrupted deployment...", name_));
+  const PathMap journal = DeployedFilesRecord(journal_path).toPathMap();
+  const PathMap new_files = PathMap::difference(journal, dest_files);
+  for(const auto& [path, mod_id] : new_files)
+    dest_files.add(path, mod_id);
+  dest_files.sort();
+  // only files in the journal may have been changed by the interrupted deployment
+  PathMap unverified_files;
+  for(const auto& [path, mod_id] : journal)
   {
-    if(!dir_entry.is_directory() || include_directories)
-      mod_files.push_back(pu::getRelativePath(dir_entry.path(), mod_base_path));
+    const int deployed_id = dest_files.find(path)->second;
+    if(new_files.contains(path) || !fileIsDeployed(path, deployed_id))
+      unverified_files.add(path, deployed_id);
   }
-  return mod_files;
+  return unverified_files;
+}
+
+std::vector<std::string> Deployer::getModFiles(int mod_id, bool include_directories) const
+{
+  if(!checkModPathExistsAndMaybeLogError(mod_id))
+    return {};
+  return mod_file_catalog_->getModFiles(mod_id, include_directories);
 }
 
 bool Deployer::modPathExists(int mod_id) const
@@ -629,87 +839,12 @@ bool Deployer::checkModPathExistsAndMaybeLogError(int mod_id) const
 void Deployer::updateConflictGroups(std::optional<ProgressNode*> progress_node)
 {
   log_(Log::LOG_INFO, std::format("Deployer '{}': Updating conflict groups...", name_));
-  std::map<std::string, int> file_map;
-  std::vector<std::set<int>> groups;
-  std::vector<int> non_conflicting;
-  // create groups
-  if(progress_node)
-    (*progress_node)->setTotalSteps(loadorders_[current_profile_].size());
-  for(const auto& [mod_id, _] : loadorders_[current_profile_])
-  {
-    if(!checkModPathExistsAndMaybeLogError(mod_id))
-      continue;
-    std::string base_path = (source_path_ / std::to_string(mod_id)).string();
-    for(const auto& dir_entry : sfs::recursive_directory_iterator(base_path))
-    {
-      if(dir_entry.is_directory())
-        continue;
-      const auto relative_path = pu::getRelativePath(dir_entry.path(), base_path);
-      if(!file_map.contains(relative_path))
-        file_map[relative_path] = mod_id;
-      else
-      {
-        int other_id = file_map[relative_path];
-        auto contains_id = [other_id](const auto& s) { return str::find(s, other_id) != s.end(); };
-        auto group_iter = str::find_if(groups, contains_id);
-        if(group_iter != groups.end())
-          group_iter->insert(mod_id);
-        else
-          groups.push_back({ other_id, mod_id });
-      }
-    }
-    if(progress_node)
-      (*progress_node)->advance();
-  }
-  std::vector<std::set<int>> merged_groups;
-  // merge groups
-  for(int i = 0; i < groups.size(); i++)
-  {
-    if(groups[i].empty())
-      continue;
-    std::set<int> new_group = groups[i];
-    bool found_intersection = true;
-    while(found_intersection)
-    {
-      found_intersection = false;
-      for(int j = i + 1; j < groups.size(); j++)
-      {
-        if(groups[j].empty())
-          continue;
-        std::vector<int> intersection;
-        std::set_intersection(new_group.begin(),
-                              new_group.end(),
-                              groups[j].begin(),
-                              groups[j].end(),
-                              std::back_inserter(intersection));
-        if(!intersection.empty())
-        {
-          found_intersection = true;
-          new_group.merge(groups[j]);
-          groups[j].clear();
-        }
-      }
-    }
-    merged_groups.push_back(std::move(new_group));
-  }
-  std::vector<std::vector<int>> sorted_groups(merged_groups.size() + 1, std::vector<int>());
-  // sort mods
+  updateConflictIndex();
+  std::vector<int> mod_ids;
+  mod_ids.reserve(loadorders_[current_profile_].size());
   for(const auto& [mod_id, _] : loadorders_[current_profile_])
-  {
-    bool is_in_group = false;
-    for(int i = 0; i < merged_groups.size(); i++)
-    {
-      if(merged_groups[i].contains(mod_id))
-      {
-        sorted_groups[i].push_back(mod_id);
-        is_in_group = true;
-        break;
-      }
-    }
-    if(!is_in_group)
-      sorted_groups[sorted_groups.size() - 1].push_back(mod_id);
-  }
-  conflict_groups_[current_profile_] = sorted_groups;
+    mod_ids.push_back(mod_id);
+  conflict_groups_[current_profile_] = createConflictGroups(mod_ids, progress_node);
   log_(Log::LOG_INFO, std::format("Deployer '{}': Conflict groups updated", name_));
 }
 
@@ -806,6 +941,8 @@ void Deployer::keepOrRevertFileModifications(const FileChangeChoices& changes_to
       continue;
     if(keep_change)
     {
+      mod_file_catalog_->invalidate(mod_id);
+      conflict_index_.removeMod(mod_id);
       sfs::remove(mod_file_path);
       try
       {
@@ -835,7 +972,7 @@ void Deployer::keepOrRevertFileModifications(const FileChangeChoices& changes_to
 void Deployer::updateDeployedFilesForMod(int mod_id,
                                          std::optional<ProgressNode*> progress_node) const
 {
-  std::map<sfs::path, int> deployed_files = loadDeployedFiles(progress_node);
+  const PathMap deployed_files = loadDeployedFiles(progress_node);
   for(const auto& [path, id] : deployed_files)
   {
     if(id != mod_id)
@@ -952,6 +1089,219 @@ void Deployer::setEnableUnsafeSorting(bool enable)
   enable_unsafe_sorting_ = enable;
 }
 
+void Deployer::updateConflictIndex(int mod_id)
+{
+  std::vector<int> mod_ids;
+  for(const auto& [id, _] : loadorders_[current_profile_])
+    mod_ids.push_back(id);
+  if(mod_id >= 0)
+    mod_ids.push_back(mod_id);
+  for(int id : mod_ids)
+  {
+    if(conflict_index_.containsMod(id) || !modPathExists(id))
+      continue;
+    const auto manifest = mod_file_catalog_->getManifest(id);
+    std::vector<std::string> files;
+    files.reserve(manifest->getEntries().size());
+    for(const auto& entry : manifest->getEntries())
+    {
+      if(!entry.is_directory)
+        files.push_back(entry.path);
+    }
+    conflict_index_.addMod(id, files, manifest->getScanTime());
+  }
+}
+
+std::vector<std::vector<int>> Deployer::createConflictGroups(
+  const std::vector<int>& mod_ids,
+  std::optional<ProgressNode*> progress_node) const
+{
+  const int num_mods = mod_ids.size();
+  std::unordered_map<int, int> positions;
+  for(const auto& [i, mod_id] : str::enumerate_view(mod_ids))
+    positions[mod_id] = i;
+  std::vector<int> parents(num_mods);
+  std::iota(parents.begin(), parents.end(), 0);
+  auto find_root = [&parents](int i)
+  {
+    while(parents[i] != i)
+    {
+      parents[i] = parents[parents[i]];
+      i = parents[i];
+    }
+    return i;
+  };
+  std::vector<bool> conflicts_with_earlier(num_mods, false);
+  // every path is handled once, by the first mod containing it, which is joined with all
+  // other mods containing it
+  std::unordered_set<const std::string*> visited_paths;
+  if(progress_node)
+    (*progress_node)->setTotalSteps(num_mods);
+  for(int i = 0; i < num_mods; i++)
+  {
+    for(const std::string* path : conflict_index_.getModFiles(mod_ids[i]))
+    {
+      if(!visited_paths.insert(path).second)
+        continue;
+      for(int other_id : conflict_index_.getModsForFile(*path))
+      {
+        auto iter = positions.find(other_id);
+        if(iter == positions.end() || iter->second == i)
+          continue;
+        conflicts_with_earlier[iter->second] = true;
+        const int root = find_root(i);
+        const int other_root = find_root(iter->second);
+        if(root != other_root)
+          parents[other_root] = root;
+      }
+    }
+    if(progress_node)
+      (*progress_node)->advance();
+  }
+
+  // position of the first mod in each group which conflicts with an earlier mod
+  std::vector<int> group_keys(num_mods, num_mods);
+  for(int i = 0; i < num_mods; i++)
+  {
+    if(conflicts_with_earlier[i])
+    {
+      const int root = find_root(i);
+      group_keys[root] = std::min(group_keys[root], i);
+    }
+  }
+  std::map<int, std::vector<int>> groups_by_key;
+  std::vector<int> non_conflicting;
+  for(int i = 0; i < num_mods; i++)
+  {
+    const int key = group_keys[find_root(i)];
+    if(key == num_mods)
+      non_conflicting.push_back(mod_ids[i]);
+    else
+      groups_by_key[key].push_back(mod_ids[i]);
+  }
+  std::vector<std::vector<int>> groups;
+  groups.reserve(groups_by_key.size() + 1);
+  for(auto& [_, group] : groups_by_key)
+    groups.push_back(std::move(group));
+  groups.push_back(std::move(non_conflicting));
+  return groups;
+}
+
+void Deployer::addModToConflictGroups(int mod_id)
+{
+  auto& groups = conflict_groups_[current_profile_];
+  const auto& loadorder = loadorders_[current_profile_];
+  int num_grouped_mods = 0;
+  for(const auto& group : groups)
+    num_grouped_mods += group.size();
+  if(groups.empty() || num_grouped_mods != loadorder.size() - 1)
+  {
+    updateConflictGroups();
+    return;
+  }
+
+  updateConflictIndex();
+  auto conflicts = conflict_index_.getConflictingMods(mod_id);
+  conflicts.erase(mod_id);
+  std::unordered_map<int, int> positions;
+  for(const auto& [i, mod] : str::enumerate_view(loadorder))
+    positions[std::get<0>(mod)] = i;
+  std::set<int> merged_groups;
+  std::vector<int> new_group{ mod_id };
+  for(const auto& [i, group] : str::enumerate_view(groups))
+  {
+    const bool is_last = i == groups.size() - 1;
+    for(int other_id : group)
+    {
+      if(!conflicts.contains(other_id))
+        continue;
+      if(is_last)
+        new_group.push_back(other_id);
+      else
+        merged_groups.insert(i);
+    }
+  }
+  if(new_group.size() == 1 && merged_groups.empty())
+  {
+    groups.back().push_back(mod_id);
+    return;
+  }
+
+  std::erase_if(groups.back(),
+                [&new_group](int id) { return str::find(new_group, id) != new_group.end(); });
+  for(int i : merged_groups)
+    new_group.insert(new_group.end(), groups[i].begin(), groups[i].end());
+  str::sort(new_group, [&positions](int a, int b) { return positions[a] < positions[b]; });
+  const int target = merged_groups.empty() ? groups.size() - 1 : *merged_groups.begin();
+  for(int i : merged_groups | stv::reverse)
+    groups.erase(groups.begin() + i);
+  groups.insert(groups.begin() + target, std::move(new_group));
+}
+
+void Deployer::removeModFromConflictGroups(int mod_id)
+{
+  auto& groups = conflict_groups_[current_profile_];
+  auto group_iter = str::find_if(
+    groups, [mod_id](const auto& group) { return str::find(group, mod_id) != group.end(); });
+  if(group_iter == groups.end())
+  {
+    updateConflictGroups();
+    return;
+  }
+  std::erase(*group_iter, mod_id);
+  if(group_iter == groups.end() - 1)
+    return;
+
+  updateConflictIndex();
+  auto new_groups = createConflictGroups(*group_iter);
+  groups.erase(group_iter);
+  std::unordered_map<int, int> positions;
+  for(const auto& [i, mod] : str::enumerate_view(loadorders_[current_profile_]))
+    positions[std::get<0>(mod)] = i;
+  auto& non_conflicting = groups.back();
+  non_conflicting.insert(non_conflicting.end(), new_groups.back().begin(), new_groups.back().end());
+  str::sort(non_conflicting, [&positions](int a, int b) { return positions[a] < positions[b]; });
+  new_groups.pop_back();
+  // keys of the remaining groups are not affected by the removal
+  for(auto& group : new_groups)
+  {
+    const int key = getConflictGroupKey(group, positions);
+    auto target = std::partition_point(
+      groups.begin(),
+      groups.end() - 1,
+      [this, key, &positions](const auto& other)
+      { return getConflictGroupKey(other, positions) < key; });
+    groups.insert(target, std::move(group));
+  }
+}
+
+int Deployer::getConflictGroupKey(const std::vector<int>& group,
+                                  const std::unordered_map<int, int>& positions) const
+{
+  std::unordered_set<int> earlier_mods;
+  for(int mod_id : group)
+  {
+    for(const std::string* path : conflict_index_.getModFiles(mod_id))
+    {
+      if(str::any_of(conflict_index_.getModsForFile(*path),
+                     [&earlier_mods](int id) { return earlier_mods.contains(id); }))
+        return positions.at(mod_id);
+    }
+    earlier_mods.insert(mod_id);
+  }
+  return positions.size();
+}
+
+void Deployer::removeUnusedModFromConflictIndex(int mod_id)
+{
+  for(const auto& loadorder : loadorders_)
+  {
+    if(str::any_of(loadorder, [mod_id](const auto& mod) { return std::get<0>(mod) == mod_id; }))
+      return;
+  }
+  conflict_index_.removeMod(mod_id);
+}
+
 void Deployer::removeManagedDirFile(const sfs::path& directory) const
 {
   sfs::remove(directory / managed_dir_file_name_);
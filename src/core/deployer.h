@@ -6,12 +6,20 @@
 #pragma once
 
 #include "conflictinfo.h"
+#include "deploymentplan.h"
+#include "fileconflictindex.h"
 #include "filechangechoices.h"
 #include "log.h"
+#include "modfilecatalog.h"
+#include "pathmap.h"
 #include "progressnode.h"
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <optional>
+#include <set>
+#include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -71,6 +79,9 @@ public:
    * Previously backed up files are automatically restored if no mod in the current load order
    * overwrites them. Conflicts are handled by overwriting mods earlier in the load order
    * with later mods.
+   * Before files are linked, a journal of all files which are to be changed is written to the
+   * target directory. If deployment is cancelled through the progress node or otherwise
+   * interrupted, the next deployment uses this journal to complete or revert all changes.
    * \param loadorder A vector of mod ids representing the load order.
    * \param progress_node Used to inform about the current progress of deployment.
    * \return A map from deployed mod ids to their respective mods total size on disk.
@@ -87,6 +98,12 @@ public:
    * \return A map from deployed mod ids to their respective mods total size on disk.
    */
   virtual std::map<int, unsigned long> deploy(std::optional<ProgressNode*> progress_node = {});
+  /*!
+   * \brief Determines which file operations would be performed by deploying the current
+   * load order. Does not write to the target or the staging directory.
+   * \return The deployment plan. Always empty for autonomous deployers.
+   */
+  virtual DeploymentPlan getDeploymentPlan() const;
   /*!
    * \brief Removes all deployed mods from the target directory and restores backups.
    * \param progress_node Used to inform about the current progress.
@@ -141,6 +158,7 @@ public:
   virtual bool hasMod(int mod_id) const;
   /*!
    * \brief Checks for file conflicts of given mod with all other mods in the load order.
+   * Conflicts are determined using an in memory index of all mod files.
    * \param mod_id Mod to be checked.
    * \param show_disabled If true: Also check for conflicts with disabled mods.
    * \param progress_node Used to inform about the current progress.
@@ -149,7 +167,7 @@ public:
   virtual std::vector<ConflictInfo> getFileConflicts(
     int mod_id,
     bool show_disabled = false,
-    std::optional<ProgressNode*> progress_node = {}) const;
+    std::optional<ProgressNode*> progress_node = {});
   /*!
    * \brief Returns the number of mods in the load order.
    * \return The number of mods.
@@ -168,12 +186,19 @@ public:
   /*!
    * \brief Checks for conflicts with other mods.
    * Two mods are conflicting if they share at least one file.
+   * Conflicts are determined using an in memory index of all mod files.
    * \param mod_id The mod to be checked.
    * \param progress_node Used to inform about the current progress.
    * \return A set of mod ids which conflict with the given mod.
    */
   virtual std::unordered_set<int> getModConflicts(int mod_id,
                                                   std::optional<ProgressNode*> progress_node = {});
+  /*!
+   * \brief Discards all cached information about the files of the given mod. Must be called
+   * whenever files are added to or removed from a mods installation directory.
+   * \param mod_id Target mod.
+   */
+  void invalidateModFiles(int mod_id);
   /*!
    * \brief Adds a new profile and optionally copies it's load order from an existing profile.
    * \param source The profile to be copied. A value of -1 indicates no copy.
@@ -248,6 +273,12 @@ public:
    * \param New source path.
    */
   void setSourcePath(const std::filesystem::path& newSourcePath);
+  /*!
+   * \brief Shares the given catalog with this deployer. The catalog is only used if it
+   * belongs to this deployers source directory.
+   * \param catalog Catalog of the staging directory.
+   */
+  void setModFileCatalog(std::shared_ptr<ModFileCatalog> catalog);
   /*!
    * \brief Setter for log callback.
    * \param newLog New log callback
@@ -260,6 +291,8 @@ public:
   virtual void cleanup();
   /*!
    * \brief Updates conflict_groups_ for the current profile.
+   * Groups are created by joining all mods sharing at least one file in a disjoint set
+   * structure, using the files stored in the conflict index.
    * \param progress_node Used to inform about the current progress.
    */
   void updateConflictGroups(std::optional<ProgressNode*> progress_node = {});
@@ -400,6 +433,11 @@ protected:
   const std::string deployed_files_name_ = ".lmmfiles";
   /*! \brief Name of the file indicating that the directory is managed by a deployer. */
   const std::string managed_dir_file_name_ = ".lmm_managed_dir";
+  /*!
+   * \brief Name of the file recording all files which may have been deployed by a deployment
+   * which has not been completed.
+   */
+  const std::string deployment_journal_name_ = ".lmmfiles.journal";
   /*! \brief The name of this deployer. */
   std::string name_;
   /*! \brief The currently active profile. */
@@ -419,46 +457,111 @@ protected:
   bool auto_update_conflict_groups_ = false;
   /*! \brief Determines whether sorting mods can affect overwrite behavior. */
   bool enable_unsafe_sorting_ = false;
+  /*! \brief Maps all files of every indexed mod to the mods containing them. */
+  FileConflictIndex conflict_index_;
+  /*! \brief Provides the file listings of all mods in the source directory. */
+  std::shared_ptr<ModFileCatalog> mod_file_catalog_;
+  /*! \brief Maximum number of threads used to deploy files. */
+  static constexpr size_t MAX_DEPLOY_THREADS = 16;
+  /*! \brief Minimum number of files each deployment thread has to deploy. */
+  static constexpr size_t MIN_FILES_PER_DEPLOY_THREAD = 256;
 
   /*!
-   * \brief Creates a pair of maps. One maps relative file paths to the mod id from which that
-   * file is to be deployed. The other maps mod ids to their total file size on disk.
+   * \brief Creates a map of relative file paths to the mod id from which that file is to be
+   * deployed and a map of mod ids to their total file size on disk. Also determines which
+   * mods have been modified since the given time.
+   * Mod files are read from stored ModFileManifests, so only mods which have been modified
+   * since their last scan need to be scanned again.
    * \param loadorder The load order used for file checks.
-   * \return The generated maps.
-   */
-  std::pair<std::map<std::filesystem::path, int>, std::map<int, unsigned long>>
-  getDeploymentSourceFilesAndModSizes(const std::vector<int>& loadorder) const;
-  /*!
-   * \brief Backs up all files which would be overwritten during deployment and restores all
-   * files backed up during previous deployments files which are no longer overwritten.
+   * \param modified_after Mods which have been scanned after this time, in nanoseconds since
+   * epoch, are considered to be modified.
+   * \param persist_manifests If false: Newly scanned manifests are not stored.
+   * \return The generated maps and the set of modified mods.
+   */
+  std::tuple<PathMap, std::map<int, unsigned long>, std::set<int>>
+  getDeploymentSourceFilesAndModSizes(const std::vector<int>& loadorder,
+                                      int64_t modified_after = 0,
+                                      bool persist_manifests = true) const;
+  /*!
+   * \brief Compares the files to be deployed with the currently deployed files and creates
+   * a plan containing only the operations required to go from one state to the other.
+   * Files which are deployed from the same, unmodified, mod in both states are skipped
+   * without accessing the file system.
    * \param source_files A map of files to be deployed to their source mods.
    * \param dest_files A map of files currently deployed to their source mods.
-   */
-  void backupOrRestoreFiles(const std::map<std::filesystem::path, int>& source_files,
-                            const std::map<std::filesystem::path, int>& dest_files) const;
-  /*!
-   * \brief Hard links all given files to target directory.
-   * \param source_files A map of files to be deployed to their source mods.
+   * \param modified_mods Mods which have been modified since the last deployment.
+   * \param unverified_files Files which are always redeployed if they are to be kept.
+   * \return The plan.
+   */
+  DeploymentPlan createDeploymentPlan(const PathMap& source_files,
+                                      const PathMap& dest_files,
+                                      const std::set<int>& modified_mods,
+                                      const PathMap& unverified_files = {}) const;
+  /*!
+   * \brief Restores backed up files for all files which are to be removed and backs up
+   * all files which would be overwritten during deployment.
+   * \param plan Plan containing the files to be removed and backed up.
+   */
+  void backupOrRestoreFiles(const DeploymentPlan& plan) const;
+  /*!
+   * \brief Links all files which are to be created or replaced to the target directory.
+   * All required directories are created first, after which files are deployed by a pool of
+   * worker threads. If any file could not be deployed, all failures are logged in the order
+   * in which they appear in the plan and the first failure is rethrown.
+   * \param plan Plan containing the files to be deployed.
    * \param progress_node Used to inform about the current progress of deployment.
    */
-  void deployFiles(const std::map<std::filesystem::path, int>& source_files,
+  void deployFiles(const DeploymentPlan& plan,
                    std::optional<ProgressNode*> progress_node = {}) const;
+  /*!
+   * \brief Links a single file from the given mod to the target directory, replacing any
+   * existing file. The parent directory of the target file must already exist.
+   * This function may be called concurrently for different files.
+   * \param path Path to the file, relative to the mods root directory.
+   * \param mod_id Mod from which to deploy the file.
+   */
+  void deployFile(const std::filesystem::path& path, int mod_id) const;
+  /*!
+   * \brief Returns the time at which files were last deployed to the target directory.
+   * \return The time in nanoseconds since epoch or 0 if no files have been deployed.
+   */
+  int64_t getLastDeploymentTime() const;
   /*!
    * \brief Creates a map of currently deployed files to their source mods.
+   * Supports both binary DeployedFilesRecords and the legacy JSON format.
    * \param progress_node Used to inform about the current progress.
    * \param dest_path Directory containing the file in which deployed file names are stored.
    * If empty: Use the location in dest_path_ instead.
    * \return The map.
    */
-  std::map<std::filesystem::path, int> loadDeployedFiles(
-    std::optional<ProgressNode*> progress_node = {}, std::filesystem::path dest_path = "") const;
+  PathMap loadDeployedFiles(std::optional<ProgressNode*> progress_node = {},
+                            std::filesystem::path dest_path = "") const;
   /*!
    * \brief Creates a file containing information about currently deployed files.
+   * The file is always written as a binary DeployedFilesRecord.
    * \param deployed_files The currently deployed files.
    * \param progress_node Used to inform about the current progress.
    */
-  void saveDeployedFiles(const std::map<std::filesystem::path, int>& deployed_files,
+  void saveDeployedFiles(const PathMap& deployed_files,
                          std::optional<ProgressNode*> progress_node = {}) const;
+  /*!
+   * \brief If the last deployment was interrupted: Adds all files which may have been
+   * deployed by it to the given map and returns every file whose state is unknown. These are
+   * all files missing from the given map and all files in the journal which are not linked
+   * to their source file.
+   * \param dest_files Files recorded as deployed by the last completed deployment.
+   * \return The files which have to be deployed again, mapped to their mods in dest_files.
+   */
+  PathMap addInterruptedDeployment(PathMap& dest_files) const;
+  /*!
+   * \brief Checks if the given file in the target directory is linked to the given mods
+   * file. For hard links, both files must be the same inode, for sym links the link must
+   * point to the mods file. Copies are never considered to be deployed.
+   * \param path Path to the file, relative to the mods root directory.
+   * \param mod_id Mod from which the file should be deployed.
+   * \return True if the file is deployed.
+   */
+  bool fileIsDeployed(const std::filesystem::path& path, int mod_id) const;
   /*!
    * \brief Creates a vector containing every file contained in one mod. Files are
    * represented as paths relative to the mods root directory.
@@ -482,6 +585,55 @@ protected:
    * \return True if the directory exists, else false.
    */
   bool checkModPathExistsAndMaybeLogError(int mod_id) const;
+  /*!
+   * \brief Adds all mods in the current load order and the given mod to the conflict index,
+   * if they have not been indexed yet. Mod files are read from their ModFileManifests.
+   * Indexed mods are not checked for changes, they are removed from the index when they
+   * are changed by this application or by \ref deploy.
+   * \param mod_id Additional mod to index. Ignored if negative.
+   */
+  void updateConflictIndex(int mod_id = -1);
+  /*!
+   * \brief Groups the given mods such that mods which share files with each other are in the
+   * same group.
+   * \param mod_ids Mods to group, in load order.
+   * \param progress_node Used to inform about the current progress.
+   * \return One vector per group, ordered by the position of the first mod in that group which
+   * conflicts with an earlier mod. The last group contains all mods without conflicts. Mods in
+   * every group are in load order.
+   */
+  std::vector<std::vector<int>> createConflictGroups(
+    const std::vector<int>& mod_ids,
+    std::optional<ProgressNode*> progress_node = {}) const;
+  /*!
+   * \brief Adds a mod which has just been appended to the current load order to the conflict
+   * groups of the current profile, merging all groups with which it conflicts. Falls back to
+   * updateConflictGroups if the current groups are not up to date.
+   * \param mod_id Target mod.
+   */
+  void addModToConflictGroups(int mod_id);
+  /*!
+   * \brief Removes a mod which has just been removed from the current load order from the
+   * conflict groups of the current profile. Only the group containing the mod is regrouped.
+   * Falls back to updateConflictGroups if the current groups are not up to date.
+   * \param mod_id Target mod.
+   */
+  void removeModFromConflictGroups(int mod_id);
+  /*!
+   * \brief Returns the key by which createConflictGroups orders the given group.
+   * \param group Mods in one conflict group, in load order.
+   * \param positions Maps the ids of all mods in the load order to their positions.
+   * \return The load order position of the first mod in the group which conflicts with an
+   * earlier mod, or the size of the load order if no mod conflicts.
+   */
+  int getConflictGroupKey(const std::vector<int>& group,
+                          const std::unordered_map<int, int>& positions) const;
+  /*!
+   * \brief Removes the given mod from the conflict index, if it is no longer part of
+   * any profile.
+   * \param mod_id Target mod.
+   */
+  void removeUnusedModFromConflictIndex(int mod_id);
   /*!
    * \brief Removes a legacy file that is no longer needed and may cause issues.
    * \param directory Directory from which to remove the file.
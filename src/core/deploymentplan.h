@@ -0,0 +1,40 @@
+/*!
+ * \file deploymentplan.h
+ * \brief Contains the DeploymentPlan struct.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+
+/*!
+ * \brief Contains all file operations needed to change the currently deployed files of a
+ * deployer to match its current load order.
+ */
+struct DeploymentPlan
+{
+  /*! \brief Files which are not currently deployed and the mods from which to deploy them. */
+  std::vector<std::pair<std::filesystem::path, int>> files_to_create{};
+  /*!
+   * \brief Deployed files which have to be redeployed, either because they are now provided
+   * by a different mod or because their mod has been modified since the last deployment.
+   */
+  std::vector<std::pair<std::filesystem::path, int>> files_to_replace{};
+  /*! \brief Deployed files which are to be removed and the mods from which they were deployed. */
+  std::vector<std::pair<std::filesystem::path, int>> files_to_remove{};
+  /*! \brief Files not managed by the deployer which are to be backed up before deployment. */
+  std::vector<std::filesystem::path> files_to_back_up{};
+  /*! \brief Number of deployed files which do not need to be changed. */
+  int num_unchanged_files = 0;
+
+  /*!
+   * \brief Returns the number of files which will be changed by this plan.
+   * \return The number of changed files.
+   */
+  int getNumChanges() const
+  {
+    return files_to_create.size() + files_to_replace.size() + files_to_remove.size();
+  }
+};
@@ -0,0 +1,77 @@
+#include "fileconflictindex.h"
+
+
+void FileConflictIndex::addMod(int mod_id,
+                               const std::vector<std::string>& files,
+                               int64_t scan_time)
+{
+  removeMod(mod_id);
+  scan_times_[mod_id] = scan_time;
+  auto& mod_files = mod_files_[mod_id];
+  mod_files.reserve(files.size());
+  for(const auto& file : files)
+  {
+    auto iter = file_mods_.try_emplace(file).first;
+    iter->second.push_back(mod_id);
+    mod_files.push_back(&iter->first);
+  }
+}
+
+void FileConflictIndex::removeMod(int mod_id)
+{
+  auto mod_iter = mod_files_.find(mod_id);
+  if(mod_iter == mod_files_.end())
+    return;
+  for(const std::string* file : mod_iter->second)
+  {
+    auto file_iter = file_mods_.find(*file);
+    std::erase(file_iter->second, mod_id);
+    if(file_iter->second.empty())
+      file_mods_.erase(file_iter);
+  }
+  mod_files_.erase(mod_iter);
+  scan_times_.erase(mod_id);
+}
+
+bool FileConflictIndex::containsMod(int mod_id) const
+{
+  return mod_files_.contains(mod_id);
+}
+
+int64_t FileConflictIndex::getScanTime(int mod_id) const
+{
+  auto iter = scan_times_.find(mod_id);
+  return iter == scan_times_.end() ? -1 : iter->second;
+}
+
+void FileConflictIndex::clear()
+{
+  file_mods_.clear();
+  mod_files_.clear();
+  scan_times_.clear();
+}
+
+const std::vector<const std::string*>& FileConflictIndex::getModFiles(int mod_id) const
+{
+  static const std::vector<const std::string*> empty;
+  auto iter = mod_files_.find(mod_id);
+  return iter == mod_files_.end() ? empty : iter->second;
+}
+
+const std::vector<int>& FileConflictIndex::getModsForFile(std::string_view path) const
+{
+  static const std::vector<int> empty;
+  auto iter = file_mods_.find(path);
+  return iter == file_mods_.end() ? empty : iter->second;
+}
+
+std::unordered_set<int> FileConflictIndex::getConflictingMods(int mod_id) const
+{
+  std::unordered_set<int> conflicts;
+  for(const std::string* file : getModFiles(mod_id))
+  {
+    for(int other_id : file_mods_.find(*file)->second)
+      conflicts.insert(other_id);
+  }
+  return conflicts;
+}
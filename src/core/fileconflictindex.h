@@ -0,0 +1,94 @@
+/*!
+ * \file fileconflictindex.h
+ * \brief Header for the FileConflictIndex class.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+/*!
+ * \brief In memory index mapping relative file paths to all mods which contain them.
+ * Allows conflict checks without accessing the file system.
+ */
+class FileConflictIndex
+{
+public:
+  /*!
+   * \brief Adds all given files for the given mod. If the mod is already in the index,
+   * its files are replaced.
+   * \param mod_id Mod to add.
+   * \param files Paths of all files in the mod, relative to the mods root directory.
+   * \param scan_time Time at which the files were read from the mod directory.
+   */
+  void addMod(int mod_id, const std::vector<std::string>& files, int64_t scan_time);
+  /*!
+   * \brief Removes all files of the given mod from the index.
+   * \param mod_id Mod to remove.
+   */
+  void removeMod(int mod_id);
+  /*!
+   * \brief Checks if the given mod has been added to the index.
+   * \param mod_id Mod to check.
+   * \return True if the mod has been added.
+   */
+  bool containsMod(int mod_id) const;
+  /*!
+   * \brief Returns the time at which the files of the given mod were read.
+   * \param mod_id Target mod.
+   * \return The time passed to addMod, or -1 if the mod is not in the index.
+   */
+  int64_t getScanTime(int mod_id) const;
+  /*! \brief Removes all mods from the index. */
+  void clear();
+  /*!
+   * \brief Returns all files of the given mod.
+   * \param mod_id Target mod.
+   * \return Pointers to the stored file paths. Empty if the mod is not in the index.
+   */
+  const std::vector<const std::string*>& getModFiles(int mod_id) const;
+  /*!
+   * \brief Returns all mods containing the given file, in the order in which they were added.
+   * \param path Path to the file, relative to the mods root directory.
+   * \return The mod ids.
+   */
+  const std::vector<int>& getModsForFile(std::string_view path) const;
+  /*!
+   * \brief Returns all mods sharing at least one file with the given mod, including
+   * the mod itself if it contains any files.
+   * \param mod_id Target mod.
+   * \return The conflicting mod ids.
+   */
+  std::unordered_set<int> getConflictingMods(int mod_id) const;
+
+private:
+  /*! \brief Hash which allows looking up strings by string_view. */
+  struct StringHash
+  {
+    /*! \brief Enables heterogeneous lookup. */
+    using is_transparent = void;
+    /*!
+     * \brief Hashes the given string.
+     * \param string String to hash.
+     * \return The hash.
+     */
+    size_t operator()(std::string_view string) const
+    {
+      return std::hash<std::string_view>{}(string);
+    }
+  };
+
+  /*! \brief Maps every file to the mods containing it. */
+  std::unordered_map<std::string, std::vector<int>, StringHash, std::equal_to<>> file_mods_;
+  /*! \brief Maps every mod to its files. Files point to keys in file_mods_. */
+  std::unordered_map<int, std::vector<const std::string*>> mod_files_;
+  /*! \brief Maps every mod to the time at which its files were read. */
+  std::unordered_map<int, int64_t> scan_times_;
+};
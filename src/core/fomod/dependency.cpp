@@ -68,7 +68,7 @@ Dependency::Dependency()
   type_ = dummy_node;
 }
 
-bool Dependency::evaluate(const sfs::path& target_path,
+bool Dependency::evaluate(CaseFoldedDirectoryIndex& target_files,
                           const std::map<std::string, std::string>& flags,
                           std::function<bool(std::string)> eval_game_version,
                           std::function<bool(std::string)> eval_fomm_version) const
@@ -79,7 +79,7 @@ bool Dependency::evaluate(const sfs::path& target_path,
       return true;
     for(const auto& child : children_)
     {
-      if(!child.evaluate(target_path, flags, eval_game_version, eval_fomm_version))
+      if(!child.evaluate(target_files, flags, eval_game_version, eval_fomm_version))
         return false;
     }
     return true;
@@ -90,14 +90,14 @@ bool Dependency::evaluate(const sfs::path& target_path,
       return true;
     for(const auto& child : children_)
     {
-      if(child.evaluate(target_path, flags, eval_game_version, eval_fomm_version))
+      if(child.evaluate(target_files, flags, eval_game_version, eval_fomm_version))
         return true;
     }
     return false;
   }
   else if(type_ == file_leaf)
   {
-    const bool exists = pu::pathExists(target_, target_path) ? true : false;
+    const bool exists = target_files.resolve(target_) ? true : false;
     if(state_ == "Active")
       return exists;
     return !exists;
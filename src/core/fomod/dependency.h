@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "../casefoldeddirectoryindex.h"
 #include "pugixml.hpp"
 #include <filesystem>
 #include <functional>
@@ -57,14 +58,14 @@ public:
   /*!
    * \brief Checks given flags, files, game version and fomm version fulfill the condition
    * represented by this tree.
-   * \param target_path Path to target files.
+   * \param target_files Index of the target files.
    * \param flags Flags to be checked.
    * \param eval_game_version Used to check if this nodes game version is valid.
    * \param eval_fomm_version Used to check if this nodes fomm version is valid.
    * \return True if conditions are met, else false.
    */
   bool evaluate(
-    const std::filesystem::path& target_path,
+    CaseFoldedDirectoryIndex& target_files,
     const std::map<std::string, std::string>& flags,
     std::function<bool(std::string)> eval_game_version,
     std::function<bool(std::string)> eval_fomm_version = [](auto s) { return true; }) const;
@@ -25,7 +25,7 @@ void FomodInstaller::init(const sfs::path& config_file,
   steps_.clear();
   flags_.clear();
   prev_selections_.clear();
-  target_path_ = target_path;
+  target_files_ = CaseFoldedDirectoryIndex(target_path);
   if(sfs::is_directory(config_file))
   {
     mod_base_path_ = config_file;
@@ -37,6 +37,7 @@ void FomodInstaller::init(const sfs::path& config_file,
     mod_base_path_ = config_file.parent_path().parent_path();
     config_file_.load_file(config_file.c_str());
   }
+  mod_files_ = CaseFoldedDirectoryIndex(mod_base_path_);
   config_ = config_file_.child("config");
   auto file_list = config_.child("requiredInstallFiles");
   if(file_list)
@@ -51,12 +52,12 @@ std::optional<InstallStep> FomodInstaller::step(const std::vector<std::vector<bo
   updateState(selection);
   for(int i = cur_step_ + 1; i < steps_.size(); i++)
   {
-    if(steps_[i].dependencies.evaluate(target_path_, flags_, version_eval_fun_, fomm_eval_fun_))
+    if(steps_[i].dependencies.evaluate(target_files_, flags_, version_eval_fun_, fomm_eval_fun_))
     {
       for(auto& group : steps_[i].groups)
       {
         for(auto& plugin : group.plugins)
-          plugin.updateType(target_path_, flags_, version_eval_fun_, fomm_eval_fun_);
+          plugin.updateType(target_files_, flags_, version_eval_fun_, fomm_eval_fun_);
       }
       if(cur_step_ > -1)
         prev_selections_.push_back(selection);
@@ -78,7 +79,7 @@ std::optional<std::pair<std::vector<std::vector<bool>>, InstallStep>> FomodInsta
     for(auto& group : step.groups)
     {
       for(auto& plugin : group.plugins)
-        plugin.updateType(target_path_, flags_, version_eval_fun_, fomm_eval_fun_);
+        plugin.updateType(target_files_, flags_, version_eval_fun_, fomm_eval_fun_);
     }
   }
   if(prev_selections_.size() == 1)
@@ -125,7 +126,7 @@ bool FomodInstaller::hasNextStep(const std::vector<std::vector<bool>>& selection
   }
   for(int i = cur_step_ + 1; i < steps_.size(); i++)
   {
-    if(steps_[i].dependencies.evaluate(target_path_, cur_flags, version_eval_fun_, fomm_eval_fun_))
+    if(steps_[i].dependencies.evaluate(target_files_, cur_flags, version_eval_fun_, fomm_eval_fun_))
       return true;
   }
   return false;
@@ -173,7 +174,7 @@ void FomodInstaller::parseFileList(const pugi::xml_node& file_list,
   {
     File new_file;
     const auto source_path = pu::normalizePath(file.attribute("source").value());
-    auto source_path_optional = pu::pathExists(source_path, mod_base_path_);
+    auto source_path_optional = mod_files_.resolve(source_path);
     if(!source_path_optional)
     {
       if(warn_missing)
@@ -249,7 +250,7 @@ void FomodInstaller::parseInstallList()
   for(const auto& pattern : root.child("patterns").children())
   {
     if(!Dependency(pattern.child("dependencies"))
-          .evaluate(target_path_, flags_, version_eval_fun_, fomm_eval_fun_))
+          .evaluate(target_files_, flags_, version_eval_fun_, fomm_eval_fun_))
       continue;
     std::vector<File> cur_files;
     parseFileList(pattern.child("files"), cur_files);
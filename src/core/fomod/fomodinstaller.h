@@ -84,8 +84,8 @@ private:
   pugi::xml_document config_file_;
   /*! \brief Root node of the config file. */
   pugi::xml_node config_;
-  /*! \brief Path used to check for file dependencies. */
-  std::filesystem::path target_path_;
+  /*! \brief Index of the files used to check for file dependencies. */
+  mutable CaseFoldedDirectoryIndex target_files_;
   /*! \brief Contains all files extracted from the config file. */
   std::vector<File> files_;
   /*! \brief Steps performed during installation. */
@@ -96,6 +96,8 @@ private:
   std::map<std::string, std::string> flags_;
   /*! \brief Base path of the mod to be installed. */
   std::filesystem::path mod_base_path_;
+  /*! \brief Index of the files in the mod to be installed. */
+  CaseFoldedDirectoryIndex mod_files_;
   /*! \brief Previous selections made during installation process. */
   std::vector<std::vector<std::vector<bool>>> prev_selections_;
   /*! \brief Used to evaluate game version conditions. */
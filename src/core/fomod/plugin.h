@@ -41,13 +41,13 @@ struct Plugin
 
   /*!
    * \brief Updates type according to potential_types
-   * \param target_path Path file conditions.
+   * \param target_files Index of the files used for file conditions.
    * \param current_flags Flags to check.
    * \param version_eval_fun Used to evaluate game version conditions.
    * \param fomm_eval_fun Used to evaluate game fromm conditions.
    */
   void updateType(
-    const std::filesystem::path& target_path,
+    CaseFoldedDirectoryIndex& target_files,
     const std::map<std::string, std::string>& current_flags,
     std::function<bool(std::string)> version_eval_fun,
     std::function<bool(std::string)> fomm_eval_fun = [](auto s) { return true; })
@@ -55,7 +55,7 @@ struct Plugin
     for(const auto& cur_type : potential_types)
     {
       if(cur_type.dependencies.evaluate(
-           target_path, current_flags, version_eval_fun, fomm_eval_fun))
+           target_files, current_flags, version_eval_fun, fomm_eval_fun))
       {
         type = cur_type.type;
         return;
@@ -1,15 +1,27 @@
 #include "installer.h"
+#include "cancellationerror.h"
 #include "compressionerror.h"
+#include "modfilemanifest.h"
 #include "pathutils.h"
 #include <archive.h>
 #include <archive_entry.h>
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <ranges>
 #include <regex>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
 #define _UNIX
 #include <dll.hpp>
 
 namespace sfs = std::filesystem;
+namespace str = std::ranges;
 namespace pu = path_utils;
 
 
@@ -29,10 +41,17 @@ void Installer::extract(const sfs::path& source_path,
     return;
   }
 
+  const bool dest_existed = sfs::exists(dest_path);
   try
   {
     extractWithProgress(source_path, dest_path, progress_node);
   }
+  catch(CancellationError& error)
+  {
+    if(!dest_existed)
+      sfs::remove_all(dest_path);
+    throw;
+  }
   catch(CompressionError& error)
   {
     std::string extension = source_path.extension().string();
@@ -69,11 +88,40 @@ unsigned long Installer::install(const sfs::path& source,
 
   if(type != SIMPLEINSTALLER && type != FOMODINSTALLER)
     throw std::runtime_error("Error: Unknown Installer type \"" + type + "\"!");
+  if(type == FOMODINSTALLER && fomod_files.empty())
+    throw std::runtime_error("No files to install.");
+  ModFileManifest::invalidate(destination);
+  auto get_size = [&destination]()
+  {
+    unsigned long size = 0;
+    for(const auto& dir_entry : sfs::recursive_directory_iterator(destination))
+      if(dir_entry.is_regular_file())
+        size += dir_entry.file_size();
+    return size;
+  };
+  if(type == FOMODINSTALLER && !sfs::is_directory(source))
+  {
+    try
+    {
+      extractFomodFiles(source, destination, root_level, fomod_files);
+      return get_size();
+    }
+    catch(CompressionError& error)
+    {
+      log(Log::LOG_DEBUG,
+          std::string("Selective extraction failed, extracting full archive: ") + error.what());
+      sfs::remove_all(destination);
+    }
+  }
   unsigned tmp_id = 0;
   sfs::path tmp_dir;
+  // the directory is created here to reserve its name, since other mods may be installed
+  // at the same time
+  if(!destination.parent_path().empty())
+    sfs::create_directories(destination.parent_path());
   do
     tmp_dir = destination.parent_path() / (EXTRACT_TMP_DIR + std::to_string(tmp_id));
-  while(pu::exists(tmp_dir) && tmp_id++ < std::numeric_limits<unsigned>::max());
+  while(!sfs::create_directory(tmp_dir) && tmp_id++ < std::numeric_limits<unsigned>::max());
   if(tmp_id == std::numeric_limits<unsigned>::max())
     throw std::runtime_error("Could not create directory!");
   try
@@ -88,11 +136,6 @@ unsigned long Installer::install(const sfs::path& source,
 
   if(type == FOMODINSTALLER)
   {
-    if(fomod_files.empty())
-    {
-      sfs::remove_all(tmp_dir);
-      throw std::runtime_error("No files to install.");
-    }
     if(root_level > 0)
     {
       auto tmp_move_dir = tmp_dir.string() + "." + MOVE_EXTENSION;
@@ -100,6 +143,23 @@ unsigned long Installer::install(const sfs::path& source,
       sfs::rename(tmp_move_dir, tmp_dir);
     }
 
+    // files can only be moved out of tmp_dir if no later entry uses them
+    std::vector<bool> can_move(fomod_files.size());
+    std::unordered_set<sfs::path> later_sources;
+    std::unordered_set<sfs::path> later_parents;
+    for(int i = fomod_files.size() - 1; i >= 0; i--)
+    {
+      const sfs::path& source_file = fomod_files[i].first;
+      can_move[i] = !later_sources.contains(source_file) && !later_parents.contains(source_file);
+      later_sources.insert(source_file);
+      for(sfs::path parent = source_file.parent_path(); parent != "" && parent != "/";
+          parent = parent.parent_path())
+      {
+        if(!later_parents.insert(parent).second)
+          break;
+      }
+    }
+
     for(auto iter = fomod_files.begin(); iter != fomod_files.end(); iter++)
     {
       const auto& [source_file, dest_file] = *iter;
@@ -110,31 +170,9 @@ unsigned long Installer::install(const sfs::path& source,
         sfs::remove_all(tmp_dir);
         throw std::runtime_error("Could not find '" + source_file.string() + "'");
       }
-      bool contains_no_duplicates = std::find_if(std::next(iter),
-                                                 fomod_files.end(),
-                                                 [source_file](auto pair) {
-                                                   return pair.first == source_file;
-                                                 }) == fomod_files.end();
+      const bool contains_no_duplicates = can_move[iter - fomod_files.begin()];
       if(sfs::is_directory(tmp_dir / source_file))
       {
-        contains_no_duplicates &= std::find_if(std::next(iter),
-                                               fomod_files.end(),
-                                               [source_file](auto pair)
-                                               {
-                                                 sfs::path parent = pair.first.parent_path();
-                                                 bool is_duplicate = false;
-                                                 while(parent != "" && parent != "/")
-                                                 {
-                                                   if(parent == source_file)
-                                                   {
-                                                     is_duplicate = true;
-                                                     break;
-                                                   }
-                                                   parent = parent.parent_path();
-                                                 }
-                                                 return is_duplicate;
-                                               }) == fomod_files.end();
-
         if(sfs::exists(destination / dest_file))
           pu::moveFilesToDirectory(
             tmp_dir / source_file, destination / dest_file, contains_no_duplicates);
@@ -197,16 +235,13 @@ unsigned long Installer::install(const sfs::path& source,
       throw error;
     }
   }
-  unsigned long size = 0;
-  for(const auto& dir_entry : sfs::recursive_directory_iterator(destination))
-    if(dir_entry.is_regular_file())
-      size += dir_entry.file_size();
-  return size;
+  return get_size();
 }
 
 void Installer::uninstall(const sfs::path& mod_path, const std::string& type)
 {
   sfs::remove_all(mod_path);
+  ModFileManifest::invalidate(mod_path);
 }
 
 std::vector<std::pair<sfs::path, bool>> Installer::getArchiveFileNames(const sfs::path& path)
@@ -219,24 +254,93 @@ std::vector<std::pair<sfs::path, bool>> Installer::getArchiveFileNames(const sfs
       file_names.emplace_back(pu::getRelativePath(dir_entry.path(), path), sfs::is_directory(path));
     return file_names;
   }
-  struct archive* source;
-  struct archive_entry* entry;
-  source = archive_read_new();
-  archive_read_support_filter_all(source);
-  archive_read_support_format_all(source);
-  if(archive_read_open_filename(source, path.string().c_str(), 10240) != ARCHIVE_OK)
-    throw CompressionError("Could not open archive file.");
-  while(archive_read_next_header(source, &entry) == ARCHIVE_OK)
-    file_names.emplace_back(archive_entry_pathname(entry), archive_entry_filetype(entry) == AE_IFDIR);
-  if(archive_read_free(source) != ARCHIVE_OK)
-    throw CompressionError("Parsing of archive failed.");
+  if(auto cached_names = getCachedArchiveFileNames(path))
+    return *cached_names;
+  readArchiveEntries(path,
+                     [&file_names](const char* name, bool is_directory)
+                     {
+                       file_names.emplace_back(name, is_directory);
+                       return true;
+                     });
+  cacheArchiveFileNames(path, file_names);
   return file_names;
 }
 
 std::tuple<int, std::string, std::string> Installer::detectInstallerSignature(
   const sfs::path& source)
 {
-  const auto path = (sfs::path("fomod") / "ModuleConfig.xml");
+  // the signature closest to the archives root determines the root level
+  int root_level = -1;
+  sfs::path root_path;
+  auto check_file = [&root_level, &root_path](const sfs::path& file)
+  {
+    const int level = getSignatureRootLevel(file);
+    if(level >= 0 && (root_level < 0 || level < root_level))
+    {
+      root_level = level;
+      root_path = pu::removePathComponents(file, level).first;
+    }
+    return root_level != 0;
+  };
+
+  std::optional<std::vector<std::pair<sfs::path, bool>>> file_names;
+  if(sfs::is_directory(source))
+    file_names = getArchiveFileNames(source);
+  else
+    file_names = getCachedArchiveFileNames(source);
+  if(file_names)
+  {
+    for(const auto& [file, _] : *file_names)
+    {
+      if(!check_file(file))
+        break;
+    }
+  }
+  else
+  {
+    // headers are only read until a signature at root level has been found
+    std::vector<std::pair<sfs::path, bool>> entries;
+    const bool was_read_completely = readArchiveEntries(
+      source,
+      [&entries, &check_file](const char* name, bool is_directory)
+      {
+        entries.emplace_back(name, is_directory);
+        return check_file(entries.back().first);
+      });
+    if(was_read_completely)
+      cacheArchiveFileNames(source, entries);
+  }
+  if(root_level >= 0)
+    return { root_level, root_path.string(), FOMODINSTALLER };
+  return { 0, {}, SIMPLEINSTALLER };
+}
+
+bool Installer::readArchiveEntries(const sfs::path& path,
+                                   std::function<bool(const char*, bool)> callback)
+{
+  std::unique_ptr<struct archive, decltype(&archive_read_free)> source(archive_read_new(),
+                                                                      archive_read_free);
+  struct archive_entry* entry;
+  archive_read_support_filter_all(source.get());
+  archive_read_support_format_all(source.get());
+  if(archive_read_open_filename(source.get(), path.string().c_str(), EXTRACT_BUFFER_SIZE) !=
+     ARCHIVE_OK)
+    throw CompressionError("Could not open archive file.");
+  while(true)
+  {
+    const int return_code = archive_read_next_header(source.get(), &entry);
+    if(return_code == ARCHIVE_EOF)
+      return true;
+    // warnings, e.g. about unsupported entry attributes, do not affect the entry names
+    if(return_code < ARCHIVE_WARN)
+      throw CompressionError("Parsing of archive failed.");
+    if(!callback(archive_entry_pathname(entry), archive_entry_filetype(entry) == AE_IFDIR))
+      return false;
+  }
+}
+
+int Installer::getSignatureRootLevel(const sfs::path& file)
+{
   auto str_equals = [](const std::string& a, const std::string& b)
   {
     return std::equal(a.begin(),
@@ -245,20 +349,50 @@ std::tuple<int, std::string, std::string> Installer::detectInstallerSignature(
                       b.end(),
                       [](char c1, char c2) { return tolower(c1) == tolower(c2); });
   };
-  const auto files = getArchiveFileNames(source);
-  int max_length = 0;
-  for(const auto& [file, _] : files)
-    max_length = std::max(max_length, pu::getPathLength(file));
-  for(int root_level = 0; root_level < max_length; root_level++)
+  int num_components = 0;
+  sfs::path parent_name;
+  sfs::path file_name;
+  for(const auto& component : file)
   {
-    for(const auto& [file, _] : files)
-    {
-      const auto [head, tail] = pu::removePathComponents(file, root_level);
-      if(str_equals(path, tail))
-        return { root_level, head.string(), FOMODINSTALLER };
-    }
+    parent_name = std::move(file_name);
+    file_name = component;
+    num_components++;
   }
-  return { 0, {}, SIMPLEINSTALLER };
+  if(num_components < 2 || !str_equals(parent_name, "fomod") ||
+     !str_equals(file_name, "ModuleConfig.xml"))
+    return -1;
+  return num_components - 2;
+}
+
+std::optional<std::vector<std::pair<sfs::path, bool>>> Installer::getCachedArchiveFileNames(
+  const sfs::path& path)
+{
+  std::error_code error;
+  const auto size = sfs::file_size(path, error);
+  const auto mtime = sfs::last_write_time(path, error);
+  if(error)
+    return {};
+  std::lock_guard lock(archive_cache_mutex_);
+  auto iter = str::find_if(archive_cache_,
+                           [&path](const auto& cached) { return cached.path == path; });
+  if(iter == archive_cache_.end() || iter->size != size || iter->mtime != mtime)
+    return {};
+  return iter->file_names;
+}
+
+void Installer::cacheArchiveFileNames(const sfs::path& path,
+                                      const std::vector<std::pair<sfs::path, bool>>& file_names)
+{
+  std::error_code error;
+  const auto size = sfs::file_size(path, error);
+  const auto mtime = sfs::last_write_time(path, error);
+  if(error)
+    return;
+  std::lock_guard lock(archive_cache_mutex_);
+  std::erase_if(archive_cache_, [&path](const auto& cached) { return cached.path == path; });
+  if(archive_cache_.size() >= ARCHIVE_CACHE_SIZE)
+    archive_cache_.erase(archive_cache_.begin());
+  archive_cache_.push_back({ path, size, mtime, file_names });
 }
 
 void Installer::cleanupFailedInstallation(const sfs::path& staging_dir, int mod_id)
@@ -317,109 +451,270 @@ void Installer::extractWithProgress(const sfs::path& source_path,
 {
   log(Log::LOG_DEBUG, "Beginning extraction with progress");
 
-  constexpr int buffer_size = 10240;
-  struct archive* source;
-  struct archive* dest;
+  std::unique_ptr<struct archive, decltype(&archive_read_free)> source(archive_read_new(),
+                                                                      archive_read_free);
+  std::unique_ptr<struct archive, decltype(&archive_write_free)> dest(archive_write_disk_new(),
+                                                                     archive_write_free);
   struct archive_entry* entry;
   int return_code;
-  const char* file_name = source_path.c_str();
-  int flags = ARCHIVE_EXTRACT_TIME;
-  sfs::path working_dir = "/tmp";
-  try
-  {
-    working_dir = sfs::current_path();
-  }
-  catch(std::filesystem::filesystem_error& error)
-  {}
   if(!sfs::exists(dest_path))
     sfs::create_directories(dest_path);
-  sfs::current_path(dest_path);
-  source = archive_read_new();
-  archive_read_support_format_all(source);
-  archive_read_support_filter_all(source);
-  dest = archive_write_disk_new();
-  archive_write_disk_set_options(dest, flags);
-  archive_write_disk_set_standard_lookup(dest);
-  if(archive_read_open_filename(source, file_name, buffer_size))
-  {
-    sfs::current_path(working_dir);
+  const sfs::path absolute_dest_path = sfs::absolute(dest_path);
+  archive_read_support_format_all(source.get());
+  archive_read_support_filter_all(source.get());
+  archive_write_disk_set_options(dest.get(), ARCHIVE_EXTRACT_TIME);
+  archive_write_disk_set_standard_lookup(dest.get());
+  if(archive_read_open_filename(source.get(), source_path.c_str(), EXTRACT_BUFFER_SIZE))
     throw CompressionError("Could not open archive file.");
-  }
-  uint64_t total_size = 0;
-  while(true)
+
+  // progress is measured in bytes read from the archive file, which avoids a separate pass
+  // over all headers to determine the uncompressed size
+  const uint64_t archive_size = sfs::file_size(source_path);
+  uint64_t reported_bytes = 0;
+  auto update_progress = [&]()
   {
-    return_code = archive_read_next_header(source, &entry);
-    if(return_code == ARCHIVE_EOF)
-      break;
-    if(return_code < ARCHIVE_OK)
+    if(!progress_node)
+      return;
+    const uint64_t read_bytes =
+      std::min<uint64_t>(std::max<la_int64_t>(archive_filter_bytes(source.get(), -1), 0),
+                         archive_size);
+    if(read_bytes > reported_bytes)
     {
-      sfs::current_path(working_dir);
-      throwCompressionError(source);
+      (*progress_node)->advance(read_bytes - reported_bytes);
+      reported_bytes = read_bytes;
     }
-    total_size += archive_entry_size(entry);
-  }
+  };
   if(progress_node)
-    (*progress_node)->setTotalSteps(total_size);
-  archive_read_close(source);
-  archive_read_free(source);
-  source = archive_read_new();
-  archive_read_support_format_all(source);
-  archive_read_support_filter_all(source);
-  if(archive_read_open_filename(source, file_name, buffer_size))
-  {
-    sfs::current_path(working_dir);
-    throw CompressionError("Could not open archive file.");
-  }
+    (*progress_node)->setTotalSteps(std::max<uint64_t>(archive_size, 1));
 
   while(true)
   {
-    return_code = archive_read_next_header(source, &entry);
+    if(progress_node)
+      (*progress_node)->checkStop();
+    return_code = archive_read_next_header(source.get(), &entry);
     if(return_code == ARCHIVE_EOF)
       break;
     if(return_code < ARCHIVE_OK)
-    {
-      sfs::current_path(working_dir);
-      throwCompressionError(source);
-    }
-    archive_entry_set_pathname(entry, archive_entry_pathname(entry));
-    if(archive_write_header(dest, entry) < ARCHIVE_OK)
-    {
-      sfs::current_path(working_dir);
-      throwCompressionError(dest);
-    }
+      throwCompressionError(source.get());
+    // entries are written to absolute paths instead of relative to the working directory,
+    // which allows multiple extractions to run at the same time
+    archive_entry_set_pathname(entry, getExtractionPath(absolute_dest_path,
+                                                        archive_entry_pathname(entry)).c_str());
+    const char* hard_link = archive_entry_hardlink(entry);
+    if(hard_link)
+      archive_entry_set_hardlink(entry, getExtractionPath(absolute_dest_path, hard_link).c_str());
+    if(archive_write_header(dest.get(), entry) < ARCHIVE_OK)
+      throwCompressionError(dest.get());
     const void* buff;
     size_t size;
     int64_t offset;
 
     while(true)
     {
-      return_code = archive_read_data_block(source, &buff, &size, &offset);
+      return_code = archive_read_data_block(source.get(), &buff, &size, &offset);
       if(return_code == ARCHIVE_EOF)
         break;
       if(return_code < ARCHIVE_OK)
+        throwCompressionError(source.get());
+      if(archive_write_data_block(dest.get(), buff, size, offset) != ARCHIVE_OK)
+        throwCompressionError(dest.get());
+      update_progress();
+    }
+    if(archive_write_finish_entry(dest.get()) < ARCHIVE_OK)
+      throwCompressionError(dest.get());
+    update_progress();
+  }
+  archive_read_close(source.get());
+  archive_write_close(dest.get());
+  if(progress_node && reported_bytes < archive_size)
+    (*progress_node)->advance(archive_size - reported_bytes);
+}
+
+sfs::path Installer::getExtractionPath(const sfs::path& dest_path, std::string_view entry_path)
+{
+  while(entry_path.starts_with('/'))
+    entry_path.remove_prefix(1);
+  return dest_path / entry_path;
+}
+
+void Installer::extractFomodFiles(const sfs::path& source_path,
+                                  const sfs::path& dest_path,
+                                  int root_level,
+                                  const std::vector<std::pair<sfs::path, sfs::path>>& fomod_files)
+{
+  log(Log::LOG_DEBUG, "Beginning selective fomod extraction");
+
+  auto normalize = [](std::string_view path)
+  {
+    while(path.starts_with('/'))
+      path.remove_prefix(1);
+    sfs::path normal_path = sfs::path(path).lexically_normal();
+    if(!normal_path.empty() && !normal_path.has_filename())
+      normal_path = normal_path.parent_path();
+    if(normal_path == ".")
+      normal_path.clear();
+    return normal_path;
+  };
+  auto get_entry_path = [&normalize, root_level](std::string_view path)
+  { return pu::removePathComponents(normalize(path), root_level).second.string(); };
+
+  // targets are absolute, which allows multiple extractions to run at the same time
+  const sfs::path dest_root = sfs::absolute(dest_path);
+  // maps every path in the archive, including implicit parent directories, to whether
+  // or not it is a directory
+  std::unordered_map<std::string, bool> archive_entries;
+  for(const auto& [file_name, is_directory] : getArchiveFileNames(source_path))
+  {
+    sfs::path entry_path = get_entry_path(file_name.string());
+    if(entry_path.empty())
+      continue;
+    archive_entries[entry_path.string()] = is_directory;
+    for(entry_path = entry_path.parent_path(); !entry_path.empty();
+        entry_path = entry_path.parent_path())
+      archive_entries.try_emplace(entry_path.string(), true);
+  }
+
+  std::unordered_map<std::string, std::vector<size_t>> sources;
+  for(size_t i = 0; i < fomod_files.size(); i++)
+  {
+    const std::string source = normalize(fomod_files[i].first.string()).string();
+    if(!source.empty() && !archive_entries.contains(source))
+      throw std::runtime_error("Could not find '" + fomod_files[i].first.string() + "'");
+    sources[source].push_back(i);
+  }
+
+  // files installed later overwrite files installed earlier, so every target is written
+  // by the last fomod file mapping to it
+  std::map<sfs::path, std::pair<size_t, std::string>> file_targets;
+  std::set<sfs::path> directory_targets;
+  for(const auto& [entry, is_directory] : archive_entries)
+  {
+    const sfs::path entry_path = entry;
+    sfs::path source = entry_path;
+    while(true)
+    {
+      if(auto iter = sources.find(source.string()); iter != sources.end())
       {
-        sfs::current_path(working_dir);
-        throwCompressionError(source);
-      }
-      if(archive_write_data_block(dest, buff, size, offset) != ARCHIVE_OK)
-      {
-        sfs::current_path(working_dir);
-        throwCompressionError(dest);
+        for(size_t i : iter->second)
+        {
+          const auto& [source_file, dest_file] = fomod_files[i];
+          sfs::path target;
+          if(source != entry_path)
+            target = dest_root / dest_file /
+                     (source.empty() ? entry_path : entry_path.lexically_relative(source));
+          else if(is_directory || dest_file.has_filename())
+            target = dest_root / dest_file;
+          else
+            target = dest_root / source_file.filename();
+          if(is_directory)
+            directory_targets.insert(target);
+          else
+          {
+            auto [target_iter, was_inserted] = file_targets.try_emplace(target, i, entry);
+            if(!was_inserted && target_iter->second.first <= i)
+              target_iter->second = { i, entry };
+          }
+        }
       }
-      if(progress_node)
-        (*progress_node)->advance(size);
+      if(source.empty())
+        break;
+      source = source.parent_path();
     }
-    if(archive_write_finish_entry(dest) < ARCHIVE_OK)
+  }
+  std::unordered_map<std::string, std::vector<sfs::path>> entry_targets;
+  for(const auto& [target, source] : file_targets)
+    entry_targets[source.second].push_back(target);
+
+  sfs::create_directories(dest_path);
+  for(const auto& dir : directory_targets)
+    sfs::create_directories(dir);
+  std::unique_ptr<struct archive, decltype(&archive_read_free)> source(archive_read_new(),
+                                                                      archive_read_free);
+  std::unique_ptr<struct archive, decltype(&archive_write_free)> dest(archive_write_disk_new(),
+                                                                     archive_write_free);
+  archive_read_support_format_all(source.get());
+  archive_read_support_filter_all(source.get());
+  archive_write_disk_set_options(dest.get(), ARCHIVE_EXTRACT_TIME);
+  archive_write_disk_set_standard_lookup(dest.get());
+  if(archive_read_open_filename(source.get(), source_path.c_str(), EXTRACT_BUFFER_SIZE))
+    throw CompressionError("Could not open archive file.");
+
+  const auto file_permissions = sfs::perms::owner_read | sfs::perms::owner_write |
+                                sfs::perms::group_read | sfs::perms::group_write |
+                                sfs::perms::others_read;
+  // first target every archive entry has been written to
+  std::unordered_map<std::string, sfs::path> extracted_files;
+  struct archive_entry* entry;
+  int return_code;
+  while((return_code = archive_read_next_header(source.get(), &entry)) == ARCHIVE_OK)
+  {
+    const std::string entry_path = get_entry_path(archive_entry_pathname(entry));
+    auto iter = entry_targets.find(entry_path);
+    if(iter == entry_targets.end())
+      continue;
+    const auto& targets = iter->second;
+    sfs::create_directories(targets.front().parent_path());
+    if(const char* hard_link = archive_entry_hardlink(entry))
     {
-      sfs::current_path(working_dir);
-      throwCompressionError(dest);
+      auto link_iter = extracted_files.find(get_entry_path(hard_link));
+      if(link_iter == extracted_files.end())
+        throw CompressionError("Hard link target has not been extracted.");
+      linkOrCopyFile(link_iter->second, targets.front());
+    }
+    else
+    {
+      archive_entry_set_pathname(entry, targets.front().c_str());
+      if(archive_write_header(dest.get(), entry) < ARCHIVE_OK)
+        throwCompressionError(dest.get());
+      copyArchive(source.get(), dest.get());
+      if(archive_write_finish_entry(dest.get()) < ARCHIVE_OK)
+        throwCompressionError(dest.get());
+      if(!sfs::is_symlink(targets.front()))
+        sfs::permissions(targets.front(), file_permissions);
+    }
+    // entries used more than once are only extracted once
+    for(const auto& target : targets | std::views::drop(1))
+    {
+      sfs::create_directories(target.parent_path());
+      sfs::remove(target);
+      linkOrCopyFile(targets.front(), target);
+    }
+    extracted_files[entry_path] = targets.front();
+  }
+  if(return_code != ARCHIVE_EOF)
+    throwCompressionError(source.get());
+  archive_read_close(source.get());
+  archive_write_close(dest.get());
+}
+
+void Installer::linkOrCopyFile(const sfs::path& source, const sfs::path& destination)
+{
+  if(!sfs::is_symlink(source))
+  {
+    const int source_fd = open(source.c_str(), O_RDONLY);
+    if(source_fd >= 0)
+    {
+      const int dest_fd = open(destination.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+      bool was_cloned = false;
+      if(dest_fd >= 0)
+      {
+        was_cloned = ioctl(dest_fd, FICLONE, source_fd) == 0;
+        close(dest_fd);
+        if(!was_cloned)
+          sfs::remove(destination);
+      }
+      close(source_fd);
+      if(was_cloned)
+      {
+        sfs::permissions(destination, sfs::status(source).permissions());
+        return;
+      }
     }
   }
-  archive_read_close(source);
-  archive_read_free(source);
-  archive_write_close(dest);
-  archive_write_free(dest);
-  sfs::current_path(working_dir);
+  std::error_code error;
+  sfs::create_hard_link(source, destination, error);
+  if(error)
+    sfs::copy(source, destination, sfs::copy_options::copy_symlinks);
 }
 
 void Installer::extractRarArchive(const sfs::path& source_path, const sfs::path& dest_path)
@@ -10,7 +10,9 @@
 #include <filesystem>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <optional>
+#include <string_view>
 #include <vector>
 
 
@@ -75,7 +77,8 @@ public:
                       std::optional<ProgressNode*> progress_node = {});
   /*!
    * \brief Extracts the archive, performs any actions specified by the installer type,
-   * then copies all files to given destination.
+   * then copies all files to given destination. Fomod installers only extract the
+   * selected files from archives.
    * \param path Path to the archive.
    * \param destination Destination directory for the installation.
    * \param options Sum of installation flags
@@ -100,6 +103,8 @@ public:
                         const std::string& type = SIMPLEINSTALLER);
   /*!
    * \brief Recursively reads all file and directory names from given archive.
+   * The names are cached for as long as the size and modification time of the archive
+   * do not change.
    * \param path Path to given archive.
    * \return Vector of paths within the archive and bools indicating whether that path points to
    * a directory.
@@ -108,7 +113,8 @@ public:
     const std::filesystem::path& path);
   /*!
    * \brief Identifies the appropriate installer type from given source archive or
-   * directory.
+   * directory. Archive headers are only read until a signature in the archives root
+   * directory has been found.
    * \param source Path to mod source.
    * \return Required root level and type of the installer.
    */
@@ -134,8 +140,30 @@ private:
   static inline std::string EXTRACT_TMP_DIR = "lmm_tmp_extract";
   /*! \brief Extension used for temporary storage during file movement. */
   static inline std::string MOVE_EXTENSION = "tmpmove";
+  /*! \brief Size of the buffer used to read archive files. */
+  static constexpr size_t EXTRACT_BUFFER_SIZE = 1 << 20;
   /*! \brief If true: The application is running as a flatpak. */
   static inline bool is_a_flatpak_ = false;
+  /*! \brief Maximum number of archives for which file names are cached. */
+  static constexpr size_t ARCHIVE_CACHE_SIZE = 8;
+
+  /*! \brief File names read from one archive. */
+  struct CachedArchive
+  {
+    /*! \brief Path to the archive. */
+    std::filesystem::path path;
+    /*! \brief Size of the archive when it was read. */
+    uintmax_t size;
+    /*! \brief Modification time of the archive when it was read. */
+    std::filesystem::file_time_type mtime;
+    /*! \brief Paths within the archive and whether or not they point to directories. */
+    std::vector<std::pair<std::filesystem::path, bool>> file_names;
+  };
+
+  /*! \brief Recently read archives, ordered from oldest to newest. */
+  static inline std::vector<CachedArchive> archive_cache_;
+  /*! \brief Protects archive_cache_. */
+  static inline std::mutex archive_cache_mutex_;
 
   /*!
    * \brief Throws a CompressionError containing the error message of given archive.
@@ -151,8 +179,8 @@ private:
   static void copyArchive(struct archive* source, struct archive* dest);
 
   /*!
-   * \brief Extracts the given archive to the given directory. Informs about
-   * extraction progress using the provided node.
+   * \brief Extracts the given archive to the given directory in a single pass. Informs about
+   * extraction progress, measured in bytes read from the archive, using the provided node.
    * \param source_path Path to the archive.
    * \param dest_path Destination directory for extraction.
    * \param progress_node Used to inform about extraction progress.
@@ -160,6 +188,68 @@ private:
   static void extractWithProgress(const std::filesystem::path& source_path,
                                   const std::filesystem::path& dest_path,
                                   std::optional<ProgressNode*> progress_node = {});
+  /*!
+   * \brief Returns the path to which the given archive entry is extracted.
+   * \param dest_path Absolute path to the destination directory.
+   * \param entry_path Path of the entry in the archive.
+   * \return The absolute target path.
+   */
+  static std::filesystem::path getExtractionPath(const std::filesystem::path& dest_path,
+                                                 std::string_view entry_path);
+  /*!
+   * \brief Extracts only the archive entries required by the given fomod files directly
+   * to their targets. Entries which are installed to more than one target are
+   * extracted once, then cloned or hard linked.
+   * Throws CompressionError if the archive could not be read.
+   * \param source_path Path to the archive.
+   * \param dest_path Destination directory for the installation.
+   * \param root_level Path components with depth < root_level are ignored.
+   * \param fomod_files Pairs of source paths in the archive and target paths.
+   */
+  static void extractFomodFiles(
+    const std::filesystem::path& source_path,
+    const std::filesystem::path& dest_path,
+    int root_level,
+    const std::vector<std::pair<std::filesystem::path, std::filesystem::path>>& fomod_files);
+  /*!
+   * \brief Creates a reflink copy of the given file, if supported by the filesystem.
+   * Otherwise creates a hard link or, if that fails, a copy.
+   * \param source File to copy.
+   * \param destination Target path.
+   */
+  static void linkOrCopyFile(const std::filesystem::path& source,
+                             const std::filesystem::path& destination);
+  /*!
+   * \brief Reads the headers of all entries in the given archive.
+   * \param path Path to the archive.
+   * \param callback Called with the path of every entry and whether it is a directory.
+   * Reading stops when this returns false.
+   * \return True if all headers have been read.
+   */
+  static bool readArchiveEntries(const std::filesystem::path& path,
+                                 std::function<bool(const char*, bool)> callback);
+  /*!
+   * \brief Checks if the given file is a fomod installer signature.
+   * \param file Path to the file.
+   * \return The number of directories containing the fomod directory, or -1 if the file is
+   * not a signature.
+   */
+  static int getSignatureRootLevel(const std::filesystem::path& file);
+  /*!
+   * \brief Returns the cached file names of the given archive, if the archive is unchanged.
+   * \param path Path to the archive.
+   * \return The file names, if they are in the cache.
+   */
+  static std::optional<std::vector<std::pair<std::filesystem::path, bool>>>
+  getCachedArchiveFileNames(const std::filesystem::path& path);
+  /*!
+   * \brief Adds the given file names to the cache.
+   * \param path Path to the archive.
+   * \param file_names File names read from the archive.
+   */
+  static void cacheArchiveFileNames(
+    const std::filesystem::path& path,
+    const std::vector<std::pair<std::filesystem::path, bool>>& file_names);
   /*!
    * \brief Libarchive sometime fails to extract certain rar archives when
    * using the method implemented in \ref extractWithProgress. This function
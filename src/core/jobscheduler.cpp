@@ -0,0 +1,222 @@
+#include "jobscheduler.h"
+#include <algorithm>
+
+
+JobScheduler::JobScheduler(size_t num_threads)
+{
+  if(num_threads == 0)
+    num_threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_THREADS);
+  for(size_t i = 0; i < num_threads; i++)
+    workers_.emplace_back([this](std::stop_token stop_token) { runWorker(stop_token); });
+}
+
+JobScheduler::~JobScheduler()
+{
+  {
+    std::lock_guard lock(mutex_);
+    queue_.clear();
+    for(auto& job : running_jobs_)
+      job.stop_source.request_stop();
+  }
+  for(auto& worker : workers_)
+    worker.request_stop();
+  for(auto& worker : workers_)
+    worker.join();
+}
+
+std::stop_source JobScheduler::submit(int app_id,
+                                      Access access,
+                                      std::function<void(std::stop_token, ProgressNode&)> job,
+                                      Priority priority)
+{
+  std::stop_source stop_source;
+  {
+    std::lock_guard lock(mutex_);
+    queue_.emplace_back(app_id, access, priority, std::move(job), stop_source);
+  }
+  condition_.notify_all();
+  return stop_source;
+}
+
+void JobScheduler::cancel(int app_id)
+{
+  {
+    std::lock_guard lock(mutex_);
+    for(auto& job : queue_)
+    {
+      if(job.app_id == app_id)
+        job.stop_source.request_stop();
+    }
+    for(auto& job : running_jobs_)
+    {
+      if(job.app_id == app_id)
+        job.stop_source.request_stop();
+    }
+  }
+  condition_.notify_all();
+}
+
+void JobScheduler::cancelAll()
+{
+  {
+    std::lock_guard lock(mutex_);
+    for(auto& job : queue_)
+      job.stop_source.request_stop();
+    for(auto& job : running_jobs_)
+      job.stop_source.request_stop();
+  }
+  condition_.notify_all();
+}
+
+void JobScheduler::waitForAll()
+{
+  std::unique_lock lock(mutex_);
+  condition_.wait(lock, [this]() { return queue_.empty() && running_jobs_.empty(); });
+}
+
+size_t JobScheduler::getNumJobs() const
+{
+  std::lock_guard lock(mutex_);
+  return queue_.size() + running_jobs_.size();
+}
+
+void JobScheduler::setLog(const std::function<void(Log::LogLevel, const std::string&)>& new_log)
+{
+  std::lock_guard lock(mutex_);
+  log_ = new_log;
+}
+
+void JobScheduler::runWorker(std::stop_token stop_token)
+{
+  std::unique_lock lock(mutex_);
+  while(true)
+  {
+    auto job_iter = queue_.end();
+    condition_.wait(lock,
+                    stop_token,
+                    [this, &job_iter]()
+                    {
+                      job_iter = findNextJob();
+                      return job_iter != queue_.end();
+                    });
+    if(stop_token.stop_requested())
+      return;
+
+    running_jobs_.splice(running_jobs_.end(), queue_, job_iter);
+    Job& job = *job_iter;
+    updateLocks(job, true);
+    const auto log = log_;
+    lock.unlock();
+
+    // releases the job on every path out of this iteration
+    struct JobGuard
+    {
+      JobScheduler& scheduler;
+      std::unique_lock<std::mutex>& lock;
+      std::list<Job>::iterator job_iter;
+
+      ~JobGuard()
+      {
+        lock.lock();
+        scheduler.updateLocks(*job_iter, false);
+        scheduler.running_jobs_.erase(job_iter);
+        scheduler.condition_.notify_all();
+      }
+    } job_guard{ *this, lock, job_iter };
+
+    try
+    {
+      // jobs report progress through their applications, the node only forwards cancellation
+      ProgressNode progress_node([](float progress) {}, {}, job.stop_source.get_token());
+      job.function(job.stop_source.get_token(), progress_node);
+    }
+    catch(std::exception& error)
+    {
+      log(Log::LOG_ERROR, error.what());
+    }
+    catch(...)
+    {
+      log(Log::LOG_ERROR, "A job failed with an unknown error.");
+    }
+  }
+}
+
+std::list<JobScheduler::Job>::iterator JobScheduler::findNextJob()
+{
+  const size_t num_erased =
+    std::erase_if(queue_, [](const Job& job) { return job.stop_source.stop_requested(); });
+  if(num_erased > 0)
+    condition_.notify_all();
+
+  auto next_job = queue_.end();
+  for(auto job = queue_.begin(); job != queue_.end(); job++)
+  {
+    if(next_job != queue_.end() && job->priority <= next_job->priority)
+      continue;
+    if(!canStart(*job))
+      continue;
+    const bool is_blocked =
+      std::any_of(queue_.begin(),
+                  job,
+                  [&job](const Job& earlier_job) { return conflicts(*job, earlier_job); });
+    if(!is_blocked)
+      next_job = job;
+  }
+  return next_job;
+}
+
+bool JobScheduler::canStart(const Job& job) const
+{
+  auto get_lock = [this](int app_id)
+  {
+    auto iter = app_locks_.find(app_id);
+    return iter == app_locks_.end() ? AppLock{} : iter->second;
+  };
+
+  if(job.app_id == NO_APP)
+    return true;
+  const AppLock global_lock = get_lock(ALL_APPS);
+  if(global_lock.is_writing)
+    return false;
+  if(job.app_id == ALL_APPS)
+  {
+    if(job.access == read_access)
+      return num_app_writers_ == 0;
+    return num_app_writers_ == 0 && num_app_readers_ == 0 && global_lock.num_readers == 0;
+  }
+  const AppLock app_lock = get_lock(job.app_id);
+  if(job.access == read_access)
+    return !app_lock.is_writing;
+  return !app_lock.is_writing && app_lock.num_readers == 0 && global_lock.num_readers == 0;
+}
+
+bool JobScheduler::conflicts(const Job& job, const Job& earlier_job)
+{
+  if(job.app_id == NO_APP || earlier_job.app_id == NO_APP)
+    return false;
+  if(job.access == read_access && earlier_job.access == read_access)
+    return false;
+  return job.app_id == ALL_APPS || earlier_job.app_id == ALL_APPS ||
+         job.app_id == earlier_job.app_id;
+}
+
+void JobScheduler::updateLocks(const Job& job, bool acquire)
+{
+  if(job.app_id == NO_APP)
+    return;
+  const int change = acquire ? 1 : -1;
+  AppLock& app_lock = app_locks_[job.app_id];
+  if(job.access == read_access)
+    app_lock.num_readers += change;
+  else
+    app_lock.is_writing = acquire;
+  if(job.app_id != ALL_APPS)
+  {
+    if(job.access == read_access)
+      num_app_readers_ += change;
+    else
+      num_app_writers_ += change;
+  }
+  if(app_lock.num_readers == 0 && !app_lock.is_writing)
+    app_locks_.erase(job.app_id);
+}
@@ -0,0 +1,183 @@
+/*!
+ * \file jobscheduler.h
+ * \brief Header for the JobScheduler class.
+ */
+
+#pragma once
+
+#include "log.h"
+#include "progressnode.h"
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+
+/*!
+ * \brief Runs jobs on a bounded pool of worker threads.
+ *
+ * Every job is associated with an application and declares whether it reads or modifies
+ * that application's state. Jobs reading the same application may run concurrently, while
+ * a job modifying an application runs exclusively. Jobs for the same application are
+ * started in the order in which they were submitted, unless both only read. Among all jobs
+ * which may be started, the one with the highest priority is started first.
+ * Every job receives a stop token, which is used to request its cancellation, and the root
+ * of a ProgressNode tree used to report its progress. The root node carries the same
+ * stop token.
+ */
+class JobScheduler
+{
+public:
+  /*! \brief Priority of a job. */
+  enum Priority
+  {
+    /*! \brief Background work. */
+    low_priority = 0,
+    /*! \brief Default priority. */
+    normal_priority = 1,
+    /*! \brief Used for queries on which the user is waiting. */
+    high_priority = 2
+  };
+  /*! \brief Describes how a job accesses the state of its application. */
+  enum Access
+  {
+    /*! \brief The job only reads state. */
+    read_access,
+    /*! \brief The job modifies state. */
+    write_access
+  };
+
+  /*! \brief Application id for jobs which do not access the state of any application. */
+  static constexpr int NO_APP = -1;
+  /*! \brief Application id for jobs which access the state of all applications. */
+  static constexpr int ALL_APPS = -2;
+
+  /*!
+   * \brief Starts the worker threads.
+   * \param num_threads Number of worker threads. If 0: Use one thread per core,
+   * up to MAX_THREADS.
+   */
+  JobScheduler(size_t num_threads = 0);
+  JobScheduler(const JobScheduler&) = delete;
+  JobScheduler& operator=(const JobScheduler&) = delete;
+  /*!
+   * \brief Requests cancellation of all jobs, discards all jobs which have not been started
+   * and waits for all running jobs to complete.
+   */
+  ~JobScheduler();
+
+  /*!
+   * \brief Adds a new job to the queue.
+   * \param app_id Application accessed by the job, or NO_APP or ALL_APPS.
+   * \param access How the job accesses its application.
+   * \param job The job.
+   * \param priority Priority of the job.
+   * \return Can be used to request cancellation of the job.
+   */
+  std::stop_source submit(int app_id,
+                          Access access,
+                          std::function<void(std::stop_token, ProgressNode&)> job,
+                          Priority priority = normal_priority);
+  /*!
+   * \brief Requests cancellation of all queued and running jobs for the given application.
+   * Queued jobs for which cancellation has been requested are discarded when they would
+   * otherwise be started.
+   * \param app_id Target application.
+   */
+  void cancel(int app_id);
+  /*! \brief Requests cancellation of all queued and running jobs. */
+  void cancelAll();
+  /*! \brief Blocks until all queued jobs have been completed or discarded. */
+  void waitForAll();
+  /*!
+   * \brief Returns the number of jobs which are either queued or running.
+   * \return The number of jobs.
+   */
+  size_t getNumJobs() const;
+  /*!
+   * \brief Sets the callback used to log errors thrown by jobs.
+   * \param new_log The new callback.
+   */
+  void setLog(const std::function<void(Log::LogLevel, const std::string&)>& new_log);
+
+private:
+  /*! \brief A queued or running job. */
+  struct Job
+  {
+    /*! \brief Application accessed by this job. */
+    int app_id;
+    /*! \brief How this job accesses its application. */
+    Access access;
+    /*! \brief Priority of this job. */
+    Priority priority;
+    /*! \brief The function to run. */
+    std::function<void(std::stop_token, ProgressNode&)> function;
+    /*! \brief Used to request cancellation. */
+    std::stop_source stop_source;
+  };
+  /*! \brief Tracks the running jobs for one application. */
+  struct AppLock
+  {
+    /*! \brief Number of running jobs reading the application state. */
+    int num_readers = 0;
+    /*! \brief True if a running job is modifying the application state. */
+    bool is_writing = false;
+  };
+
+  /*! \brief Maximum number of worker threads. */
+  static constexpr size_t MAX_THREADS = 8;
+
+  /*! \brief Jobs which have not been started, in submission order. */
+  std::list<Job> queue_;
+  /*! \brief Jobs which are currently running. */
+  std::list<Job> running_jobs_;
+  /*! \brief Maps application ids, including ALL_APPS, to the jobs running for them. */
+  std::map<int, AppLock> app_locks_;
+  /*! \brief Number of running jobs reading the state of a single application. */
+  int num_app_readers_ = 0;
+  /*! \brief Number of running jobs modifying the state of a single application. */
+  int num_app_writers_ = 0;
+  /*! \brief Protects all members. */
+  mutable std::mutex mutex_;
+  /*! \brief Signaled whenever a job is added, started or completed. */
+  std::condition_variable_any condition_;
+  /*! \brief Callback for logging. */
+  std::function<void(Log::LogLevel, const std::string&)> log_ = [](Log::LogLevel a,
+                                                                   const std::string& b) {};
+  /*! \brief The worker threads. Declared last, so that they are stopped first. */
+  std::vector<std::jthread> workers_;
+
+  /*!
+   * \brief Takes jobs from the queue and runs them until stop is requested.
+   * \param stop_token Used to stop the thread.
+   */
+  void runWorker(std::stop_token stop_token);
+  /*!
+   * \brief Finds the queued job which should be started next.
+   * \return An iterator to the job, or queue_.end() if no job can be started.
+   */
+  std::list<Job>::iterator findNextJob();
+  /*!
+   * \brief Checks if the given job conflicts with any running job.
+   * \param job Job to check.
+   * \return True if the job can be started.
+   */
+  bool canStart(const Job& job) const;
+  /*!
+   * \brief Checks if the given job has to wait for the given job, which was submitted earlier.
+   * \param job Job to check.
+   * \param earlier_job Job which was submitted before job.
+   * \return True if the jobs access the same state and at least one of them modifies it.
+   */
+  static bool conflicts(const Job& job, const Job& earlier_job);
+  /*!
+   * \brief Updates the locks for the given job.
+   * \param job Target job.
+   * \param acquire If true: Acquire locks, else: Release them.
+   */
+  void updateLocks(const Job& job, bool acquire);
+};
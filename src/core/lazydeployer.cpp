@@ -0,0 +1,156 @@
+#include "lazydeployer.h"
+#include "deployerfactory.h"
+#include <format>
+
+
+LazyDeployer::LazyDeployer(std::unique_ptr<Deployer> deployer) :
+  state_(std::make_shared<State>())
+{
+  state_->deployer = std::move(deployer);
+  state_->is_initialized = true;
+}
+
+LazyDeployer::LazyDeployer(std::function<std::unique_ptr<Deployer>()> factory,
+                           const Json::Value& settings) : state_(std::make_shared<State>())
+{
+  state_->factory = std::move(factory);
+  state_->settings = settings;
+}
+
+Deployer* LazyDeployer::get() const
+{
+  if(state_->is_initialized)
+    return state_->deployer.get();
+  return initialize(*state_);
+}
+
+Deployer* LazyDeployer::operator->() const
+{
+  return get();
+}
+
+bool LazyDeployer::isInitialized() const
+{
+  return state_->is_initialized;
+}
+
+const Json::Value& LazyDeployer::getSettings() const
+{
+  return state_->settings;
+}
+
+std::string LazyDeployer::getName() const
+{
+  if(state_->is_initialized)
+    return state_->deployer->getName();
+  return state_->settings["name"].asString();
+}
+
+std::string LazyDeployer::getType() const
+{
+  if(state_->is_initialized)
+    return state_->deployer->getType();
+  return state_->settings["type"].asString();
+}
+
+bool LazyDeployer::isAutonomous() const
+{
+  if(state_->is_initialized)
+    return state_->deployer->isAutonomous();
+  auto iter = DeployerFactory::AUTONOMOUS_DEPLOYERS.find(getType());
+  return iter != DeployerFactory::AUTONOMOUS_DEPLOYERS.end() && iter->second;
+}
+
+std::string LazyDeployer::getDestPath() const
+{
+  if(state_->is_initialized)
+    return state_->deployer->getDestPath();
+  return state_->settings["dest_path"].asString();
+}
+
+std::string LazyDeployer::getSourcePath() const
+{
+  if(state_->is_initialized)
+    return state_->deployer->getSourcePath();
+  return state_->settings["source_path"].asString();
+}
+
+int LazyDeployer::getNumMods() const
+{
+  if(state_->is_initialized)
+    return state_->deployer->getNumMods();
+  return state_->settings.get("num_mods", 0).asInt();
+}
+
+Deployer::DeployMode LazyDeployer::getDeployMode() const
+{
+  if(state_->is_initialized)
+    return state_->deployer->getDeployMode();
+  return static_cast<Deployer::DeployMode>(state_->settings["deploy_mode"].asInt());
+}
+
+bool LazyDeployer::isCaseInvariant() const
+{
+  if(state_->is_initialized)
+    return state_->deployer->isCaseInvariant();
+  return getType() == DeployerFactory::CASEMATCHINGDEPLOYER;
+}
+
+void LazyDeployer::setLog(const std::function<void(Log::LogLevel, const std::string&)>& new_log)
+{
+  {
+    std::lock_guard lock(state_->log_mutex);
+    state_->log = new_log;
+  }
+  if(state_->is_initialized)
+    state_->deployer->setLog(new_log);
+}
+
+std::function<void()> LazyDeployer::getInitializer() const
+{
+  return [state = state_]()
+  {
+    try
+    {
+      initialize(*state);
+    }
+    catch(std::exception& error)
+    {
+      // the error is thrown again once the deployer is accessed
+      std::function<void(Log::LogLevel, const std::string&)> log;
+      {
+        std::lock_guard lock(state->log_mutex);
+        log = state->log;
+      }
+      log(Log::LOG_ERROR,
+          std::format("Failed to load deployer '{}': {}",
+                      state->settings["name"].asString(),
+                      error.what()));
+    }
+    catch(...)
+    {
+      // non standard errors are only reported once the deployer is accessed
+    }
+  };
+}
+
+Deployer* LazyDeployer::initialize(State& state)
+{
+  std::lock_guard lock(state.mutex);
+  if(state.is_initialized)
+    return state.deployer.get();
+  auto deployer = state.factory();
+  deployer->setLog(
+    [&state](Log::LogLevel log_level, const std::string& message)
+    {
+      std::function<void(Log::LogLevel, const std::string&)> log;
+      {
+        std::lock_guard lock(state.log_mutex);
+        log = state.log;
+      }
+      log(log_level, message);
+    });
+  state.deployer = std::move(deployer);
+  state.is_initialized = true;
+  return state.deployer.get();
+}
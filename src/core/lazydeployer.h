@@ -0,0 +1,146 @@
+/*!
+ * \file lazydeployer.h
+ * \brief Header for the LazyDeployer class.
+ */
+
+#pragma once
+
+#include "deployer.h"
+#include <atomic>
+#include <functional>
+#include <json/json.h>
+#include <memory>
+#include <mutex>
+
+
+/*!
+ * \brief Owns a Deployer which is only constructed when it is first accessed.
+ *
+ * Constructing autonomous deployers reads plugin files, archives or file lists from disk.
+ * This class defers that work until the deployer is used, either by the thread accessing it
+ * or by a background thread running the function returned by \ref getInitializer.
+ * Copies of a LazyDeployer share the same deployer.
+ */
+class LazyDeployer
+{
+public:
+  /*!
+   * \brief Wraps an already constructed deployer.
+   * \param deployer The deployer.
+   */
+  LazyDeployer(std::unique_ptr<Deployer> deployer);
+  /*!
+   * \brief Defers construction of a deployer.
+   * \param factory Constructs the deployer.
+   * \param settings Serialized deployer from which the factory constructs the deployer.
+   * Used in place of the deployer while it has not been constructed. The deploy mode must be
+   * stored as "deploy_mode".
+   */
+  LazyDeployer(std::function<std::unique_ptr<Deployer>()> factory, const Json::Value& settings);
+
+  /*!
+   * \brief Returns the deployer, constructing it if necessary.
+   * Exceptions thrown during construction are passed on and construction is retried on the
+   * next access.
+   * \return The deployer.
+   */
+  Deployer* get() const;
+  /*!
+   * \brief Returns the deployer, constructing it if necessary.
+   * \return The deployer.
+   */
+  Deployer* operator->() const;
+  /*!
+   * \brief Checks if the deployer has been constructed.
+   * \return True if the deployer exists.
+   */
+  bool isInitialized() const;
+  /*!
+   * \brief Returns the serialized deployer passed to the constructor.
+   * \return The settings, or a null value if the deployer was constructed eagerly.
+   */
+  const Json::Value& getSettings() const;
+  /*!
+   * \brief Returns the name of the deployer without constructing it.
+   * \return The name.
+   */
+  std::string getName() const;
+  /*!
+   * \brief Returns the type of the deployer without constructing it.
+   * \return The type.
+   */
+  std::string getType() const;
+  /*!
+   * \brief Checks if the deployer is autonomous without constructing it.
+   * \return True if the deployer manages its own mods.
+   */
+  bool isAutonomous() const;
+  /*!
+   * \brief Returns the deployment target directory without constructing the deployer.
+   * \return The path.
+   */
+  std::string getDestPath() const;
+  /*!
+   * \brief Returns the source directory without constructing the deployer.
+   * \return The path.
+   */
+  std::string getSourcePath() const;
+  /*!
+   * \brief Returns the number of mods without constructing the deployer.
+   * \return The number of mods, as stored when the settings were last written.
+   */
+  int getNumMods() const;
+  /*!
+   * \brief Returns the deploy mode without constructing the deployer.
+   * \return The deploy mode.
+   */
+  Deployer::DeployMode getDeployMode() const;
+  /*!
+   * \brief Checks if the deployer is case invariant without constructing it.
+   * \return True if file names are adapted to the target directory.
+   */
+  bool isCaseInvariant() const;
+  /*!
+   * \brief Sets the callback used for logging by the deployer, without constructing it.
+   * \param new_log The new callback.
+   */
+  void setLog(const std::function<void(Log::LogLevel, const std::string&)>& new_log);
+  /*!
+   * \brief Returns a function which constructs the deployer. Errors during construction are
+   * logged once and thrown again on the next access to the deployer. The function remains
+   * valid when this object is moved or destroyed.
+   * \return The function.
+   */
+  std::function<void()> getInitializer() const;
+
+private:
+  /*! \brief State shared between all copies of one LazyDeployer. */
+  struct State
+  {
+    /*! \brief The deployer, or nullptr if it has not been constructed. */
+    std::unique_ptr<Deployer> deployer;
+    /*! \brief Set once deployer has been constructed. */
+    std::atomic<bool> is_initialized = false;
+    /*! \brief Constructs the deployer. */
+    std::function<std::unique_ptr<Deployer>()> factory;
+    /*! \brief Serialized deployer. */
+    Json::Value settings;
+    /*! \brief Serializes construction of the deployer. */
+    std::mutex mutex;
+    /*! \brief Callback for logging, forwarded to by the deployer. */
+    std::function<void(Log::LogLevel, const std::string&)> log = [](Log::LogLevel a,
+                                                                    const std::string& b) {};
+    /*! \brief Synchronizes access to log. */
+    std::mutex log_mutex;
+  };
+
+  /*! \brief State of this object. */
+  std::shared_ptr<State> state_;
+
+  /*!
+   * \brief Constructs the deployer stored in the given state, if necessary.
+   * \param state Target state.
+   * \return The deployer.
+   */
+  static Deployer* initialize(State& state);
+};
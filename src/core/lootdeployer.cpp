@@ -1,4 +1,5 @@
 #include "lootdeployer.h"
+#include "casefoldeddirectoryindex.h"
 #include "pathutils.h"
 #include <chrono>
 #include <cpr/cpr.h>
@@ -140,23 +141,52 @@ std::unordered_set<int> LootDeployer::getModConflicts(int mod_id,
                                                       std::optional<ProgressNode*> progress_node)
 {
   std::unordered_set<int> conflicts{ mod_id };
-  auto loot_handle = loot::CreateGameHandle(app_type_, source_path_, dest_path_);
-  std::vector<sfs::path> plugin_paths;
-  plugin_paths.reserve(plugins_.size());
-  for(const auto& [path, s] : plugins_)
-    plugin_paths.emplace_back(source_path_ / path);
-  loot_handle->LoadPlugins(plugin_paths, false);
-  auto plugin = loot_handle->GetPlugin(plugins_[mod_id].first);
+  updateLootHandle();
+  const auto& overlaps = getPluginOverlaps(plugins_[mod_id].first);
   for(int i = 0; i < plugins_.size(); i++)
   {
-    if(i == mod_id)
-      continue;
-    if(loot_handle->GetPlugin(plugins_[i].first)->DoRecordsOverlap(*plugin))
+    if(overlaps.contains(plugins_[i].first))
       conflicts.insert(i);
   }
   return conflicts;
 }
 
+std::vector<std::unordered_set<int>> LootDeployer::getConflictMatrix()
+{
+  updateLootHandle();
+  std::vector<std::shared_ptr<const loot::PluginInterface>> loaded_plugins;
+  loaded_plugins.reserve(plugins_.size());
+  for(const auto& [name, _] : plugins_)
+    loaded_plugins.push_back(loot_handle_->GetPlugin(name));
+  // every pair is only checked once, since overlaps are symmetric
+  std::vector<std::unordered_set<int>> conflicts(plugins_.size());
+  for(int i = 0; i < plugins_.size(); i++)
+  {
+    conflicts[i].insert(i);
+    if(!loaded_plugins[i])
+      continue;
+    for(int j = i + 1; j < plugins_.size(); j++)
+    {
+      if(loaded_plugins[j] && loaded_plugins[i]->DoRecordsOverlap(*loaded_plugins[j]))
+      {
+        conflicts[i].insert(j);
+        conflicts[j].insert(i);
+      }
+    }
+  }
+  for(int i = 0; i < plugins_.size(); i++)
+  {
+    auto& overlaps = plugin_overlaps_[plugins_[i].first];
+    overlaps.clear();
+    for(int j : conflicts[i])
+    {
+      if(j != i)
+        overlaps.insert(plugins_[j].first);
+    }
+  }
+  return conflicts;
+}
+
 void LootDeployer::sortModsByConflicts(std::optional<ProgressNode*> progress_node)
 {
   if(progress_node)
@@ -179,33 +209,28 @@ void LootDeployer::sortModsByConflicts(std::optional<ProgressNode*> progress_nod
                              "file and place it in '" + dest_path_.string() + "'.\nYou can " +
                              "disable auto updates in '" +
                              (dest_path_ / config_file_name_).string() + "'.");
-  auto loot_handle = loot::CreateGameHandle(app_type_, source_path_, dest_path_);
+  updateLootHandle();
   sfs::path user_list_path(dest_path_ / "userlist.yaml");
   if(!sfs::exists(user_list_path))
     user_list_path = "";
   sfs::path prelude_path(dest_path_ / "prelude.yaml");
   if(!sfs::exists(prelude_path))
     prelude_path = "";
-  loot_handle->GetDatabase().LoadLists(master_list_path, user_list_path, prelude_path);
+  updateLootLists(master_list_path, user_list_path, prelude_path);
   if(progress_node)
     (*progress_node)->child(1).advance();
 
-  std::vector<sfs::path> plugin_paths;
   std::vector<std::string> plugin_file_names;
-  plugin_paths.reserve(plugins_.size());
   plugin_file_names.reserve(plugins_.size());
   for(const auto& [path, s] : plugins_)
-  {
-    plugin_paths.emplace_back(source_path_ / path);
     plugin_file_names.emplace_back(path);
-  }
-  loot_handle->LoadPlugins(plugin_paths, false);
-  auto sorted_plugins = loot_handle->SortPlugins(plugin_file_names);
+  auto sorted_plugins = loot_handle_->SortPlugins(plugin_file_names);
   if(progress_node)
     (*progress_node)->child(2).advance();
 
   std::vector<std::pair<std::string, bool>> new_plugins;
   new_plugins.reserve(plugins_.size());
+  CaseFoldedDirectoryIndex source_files(source_path_);
   std::set<std::string> conflicting;
   int num_light_plugins = 0;
   int num_master_plugins = 0;
@@ -217,7 +242,7 @@ void LootDeployer::sortModsByConflicts(std::optional<ProgressNode*> progress_nod
     bool enabled = true;
     if(iter != plugins_.end())
       enabled = iter->second;
-    const auto cur_plugin = loot_handle->GetPlugin(plugin);
+    const auto cur_plugin = loot_handle_->GetPlugin(plugin);
     if(cur_plugin->IsLightPlugin())
     {
       num_light_plugins++;
@@ -237,18 +262,18 @@ void LootDeployer::sortModsByConflicts(std::optional<ProgressNode*> progress_nod
     auto masters = cur_plugin->GetMasters();
     for(const auto& master : masters)
     {
-      if(!pu::pathExists(master, source_path_) && enabled)
+      if(!source_files.resolve(master) && enabled)
         log_(Log::LOG_WARNING,
              "LOOT: Plugin '" + master + "' is missing but required" + " for '" + plugin + "'");
     }
-    auto meta_data = loot_handle->GetDatabase().GetPluginMetadata(plugin);
+    auto meta_data = loot_handle_->GetDatabase().GetPluginMetadata(plugin);
     if(!meta_data)
       continue;
     auto requirements = meta_data->GetRequirements();
     for(const auto& req : requirements)
     {
       std::string file = static_cast<std::string>(req.GetName());
-      if(!pu::pathExists(file, source_path_))
+      if(!source_files.resolve(file))
         log_(Log::LOG_WARNING, "LOOT: Requirement '" + file + "' not met for '" + plugin + "'");
     }
   }
@@ -349,9 +374,10 @@ void LootDeployer::loadSettings()
 
 void LootDeployer::updateAppType()
 {
+  CaseFoldedDirectoryIndex source_files(source_path_);
   for(const auto& [type, file] : TYPE_IDENTIFIERS)
   {
-    if(pu::pathExists(file, source_path_))
+    if(source_files.resolve(file))
     {
       app_type_ = type;
       if(APP_TYPE_WITH_FILE_MOD_ORDER.contains(type))
@@ -536,18 +562,13 @@ void LootDeployer::resetSettingsPrivate()
 void LootDeployer::updatePluginTagsPrivate()
 {
   tags_.clear();
-  auto loot_handle = loot::CreateGameHandle(app_type_, source_path_, dest_path_);
-  std::vector<sfs::path> plugin_paths;
-  plugin_paths.reserve(plugins_.size());
-  for(const auto& [path, s] : plugins_)
-    plugin_paths.emplace_back(source_path_ / path);
-  loot_handle->LoadPlugins(plugin_paths, false);
+  updateLootHandle();
   num_light_plugins_ = 0;
   num_master_plugins_ = 0;
   num_standard_plugins_ = 0;
   for(int i = 0; i < plugins_.size(); i++)
   {
-    auto plugin = loot_handle->GetPlugin(plugins_[i].first);
+    auto plugin = loot_handle_->GetPlugin(plugins_[i].first);
     if(plugin->IsLightPlugin())
     {
       num_light_plugins_++;
@@ -566,3 +587,69 @@ void LootDeployer::updatePluginTagsPrivate()
   }
   writePluginTags();
 }
+
+void LootDeployer::updateLootHandle()
+{
+  auto handle_key = std::make_tuple(app_type_, source_path_, dest_path_);
+  if(!loot_handle_ || loot_handle_key_ != handle_key)
+  {
+    loot_handle_ = loot::CreateGameHandle(app_type_, source_path_, dest_path_);
+    loot_handle_key_ = std::move(handle_key);
+    loaded_plugin_times_.clear();
+    loaded_list_times_.clear();
+    plugin_overlaps_.clear();
+  }
+
+  std::map<std::string, sfs::file_time_type> plugin_times;
+  std::vector<sfs::path> modified_plugins;
+  for(const auto& [plugin, _] : plugins_)
+  {
+    std::error_code error;
+    const auto time = sfs::last_write_time(source_path_ / plugin, error);
+    plugin_times[plugin] = time;
+    auto iter = loaded_plugin_times_.find(plugin);
+    if(error || iter == loaded_plugin_times_.end() || iter->second != time)
+      modified_plugins.push_back(source_path_ / plugin);
+  }
+  if(!modified_plugins.empty())
+  {
+    loot_handle_->LoadPlugins(modified_plugins, false);
+    plugin_overlaps_.clear();
+  }
+  loaded_plugin_times_ = std::move(plugin_times);
+}
+
+void LootDeployer::updateLootLists(const sfs::path& master_list_path,
+                                   const sfs::path& user_list_path,
+                                   const sfs::path& prelude_path)
+{
+  std::map<sfs::path, sfs::file_time_type> list_times;
+  for(const auto& path : { master_list_path, user_list_path, prelude_path })
+  {
+    if(!path.empty())
+      list_times[path] = sfs::last_write_time(path);
+  }
+  if(list_times == loaded_list_times_)
+    return;
+  loot_handle_->GetDatabase().LoadLists(master_list_path, user_list_path, prelude_path);
+  loaded_list_times_ = std::move(list_times);
+}
+
+const std::set<std::string>& LootDeployer::getPluginOverlaps(const std::string& plugin)
+{
+  if(auto iter = plugin_overlaps_.find(plugin); iter != plugin_overlaps_.end())
+    return iter->second;
+  auto& overlaps = plugin_overlaps_[plugin];
+  const auto loaded_plugin = loot_handle_->GetPlugin(plugin);
+  if(!loaded_plugin)
+    return overlaps;
+  for(const auto& [other_plugin, _] : plugins_)
+  {
+    if(other_plugin == plugin)
+      continue;
+    const auto other_loaded_plugin = loot_handle_->GetPlugin(other_plugin);
+    if(other_loaded_plugin && other_loaded_plugin->DoRecordsOverlap(*loaded_plugin))
+      overlaps.insert(other_plugin);
+  }
+  return overlaps;
+}
@@ -8,6 +8,8 @@
 #include "loot/api.h"
 #include "plugindeployer.h"
 #include <json/json.h>
+#include <memory>
+#include <tuple>
 
 
 /*!
@@ -99,6 +101,11 @@ public:
   virtual std::unordered_set<int> getModConflicts(
     int mod_id,
     std::optional<ProgressNode*> progress_node = {}) override;
+  /*!
+   * \brief Checks for conflicts between all plugins in the current load order.
+   * \return For every plugin: The indices of all plugins which conflict with it.
+   */
+  std::vector<std::unordered_set<int>> getConflictMatrix();
   /*!
    * \brief Sorts the current load order using LOOT. Uses a masterlist.yaml appropriate
    * for the game managed by this deployer and optionally a userlist.yaml in the target
@@ -165,6 +172,19 @@ protected:
   int num_master_plugins_ = 0;
   /*! \brief Current number of standard plugins. */
   int num_standard_plugins_ = 0;
+  /*!
+   * \brief Game handle used for all LOOT operations. This is kept between calls, so that
+   * only modified plugins and lists have to be loaded again.
+   */
+  std::unique_ptr<loot::GameInterface> loot_handle_;
+  /*! \brief App type, source path and target path used to create loot_handle_. */
+  std::tuple<loot::GameType, std::filesystem::path, std::filesystem::path> loot_handle_key_;
+  /*! \brief Maps plugins loaded by loot_handle_ to their modification times at loading. */
+  std::map<std::string, std::filesystem::file_time_type> loaded_plugin_times_;
+  /*! \brief Maps lists loaded by loot_handle_ to their modification times at loading. */
+  std::map<std::filesystem::path, std::filesystem::file_time_type> loaded_list_times_;
+  /*! \brief Maps plugin names to the names of all plugins sharing records with them. */
+  std::map<std::string, std::set<std::string>> plugin_overlaps_;
 
   /*! \brief Writes current load order to plugins.txt and loadorder.txt. */
   virtual void writePlugins() const override;
@@ -200,4 +220,26 @@ protected:
   void resetSettingsPrivate();
   /*! \brief Updates the loot plugin tags for every currently loaded plugin. */
   void updatePluginTagsPrivate();
+  /*!
+   * \brief Creates loot_handle_, if necessary, and loads all plugins which have been
+   * added or modified since they were last loaded.
+   */
+  void updateLootHandle();
+  /*!
+   * \brief Loads the masterlist, userlist and prelude into loot_handle_, if any of them
+   * changed since they were last loaded.
+   * \param master_list_path Path to the masterlist.
+   * \param user_list_path Path to the userlist, or an empty path.
+   * \param prelude_path Path to the prelude, or an empty path.
+   */
+  void updateLootLists(const std::filesystem::path& master_list_path,
+                       const std::filesystem::path& user_list_path,
+                       const std::filesystem::path& prelude_path);
+  /*!
+   * \brief Returns the names of all plugins sharing records with the given plugin.
+   * Requires an up to date loot_handle_.
+   * \param plugin Name of the plugin.
+   * \return The plugin names.
+   */
+  const std::set<std::string>& getPluginOverlaps(const std::string& plugin);
 };
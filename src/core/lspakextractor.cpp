@@ -1,41 +1,84 @@
 #include "lspakextractor.h"
+#include <cstring>
+#include <fcntl.h>
 #include <format>
-#include <fstream>
-#include <iostream>
 #include <lz4.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <vector>
-#include <zstd.h>
-#include <zlib.h>
 
 namespace sfs = std::filesystem;
 
 
 LsPakExtractor::LsPakExtractor(const sfs::path& source_path) : source_path_(source_path) {}
 
+LsPakExtractor::~LsPakExtractor()
+{
+  if(data_)
+    munmap(data_, data_size_);
+  ZSTD_freeDCtx(zstd_context_);
+  if(zlib_stream_initialized_)
+    inflateEnd(&zlib_stream_);
+}
+
 void LsPakExtractor::init()
 {
-  std::ifstream file(source_path_, std::ios::binary);
-  header_ = std::make_unique<LsPakHeader>();
-  file.read(reinterpret_cast<char*>(header_.get()), sizeof(LsPakHeader));
+  if(data_)
+  {
+    munmap(data_, data_size_);
+    data_ = nullptr;
+  }
+  const int fd = open(source_path_.c_str(), O_RDONLY);
+  if(fd == -1)
+    throw std::runtime_error("Could not read \"" + source_path_.string() + "\"");
+  struct stat file_stat;
+  if(fstat(fd, &file_stat) != 0)
+  {
+    close(fd);
+    throw std::runtime_error("Could not read \"" + source_path_.string() + "\"");
+  }
+  data_size_ = file_stat.st_size;
+  if(data_size_ < sizeof(LsPakHeader))
+  {
+    close(fd);
+    throw std::runtime_error(std::format("File is too small: {}B.", data_size_));
+  }
+  data_ = mmap(nullptr, data_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(data_ == MAP_FAILED)
+  {
+    data_ = nullptr;
+    throw std::runtime_error("Could not map \"" + source_path_.string() + "\"");
+  }
+  std::memcpy(&header_, data_, sizeof(LsPakHeader));
 
-  if(static_cast<unsigned int>(header_->magic_number) != LS_PAK_MAGIC_HEADER_NUMBER)
+  if(static_cast<unsigned int>(header_.magic_number) != LS_PAK_MAGIC_HEADER_NUMBER)
     throw std::runtime_error(std::format("Unknown file format with magic number: {}",
-                                         static_cast<unsigned int>(header_->magic_number)));
-  if(static_cast<unsigned int>(header_->version) != LS_PAK_SUPPORTED_VERSION)
+                                         static_cast<unsigned int>(header_.magic_number)));
+  if(static_cast<unsigned int>(header_.version) != LS_PAK_SUPPORTED_VERSION)
   {
     throw std::runtime_error(
-      std::format("Unsupported file version: {}", static_cast<unsigned int>(header_->version)));
+      std::format("Unsupported file version: {}", static_cast<unsigned int>(header_.version)));
   }
 
   auto compressed_size = readFileList();
-  if(compressed_size + 8 != header_->file_list_size)
+  if(compressed_size + 8 != header_.file_list_size)
   {
     throw std::runtime_error(std::format("Mismatch for file list size! Expected {}, found {}.",
-                                         static_cast<unsigned int>(header_->file_list_size - 8),
+                                         static_cast<unsigned int>(header_.file_list_size - 8),
                                          compressed_size));
   }
 }
 
+std::string_view LsPakExtractor::getData(unsigned long offset, unsigned long length) const
+{
+  if(!data_ || offset > data_size_ || length > data_size_ - offset)
+    throw std::runtime_error(
+      std::format("Data at offset {} with length {} exceeds the archive.", offset, length));
+  return { static_cast<const char*>(data_) + offset, length };
+}
+
 std::string LsPakExtractor::extractData(unsigned long offset,
                                         unsigned int length,
                                         unsigned int uncompressed_size,
@@ -45,64 +88,62 @@ std::string LsPakExtractor::extractData(unsigned long offset,
   if(uncompressed_size > 1 << 30)
     throw std::runtime_error(std::format("Uncompressed file size is too large: {}B.", uncompressed_size));
 
-  std::ifstream file(source_path_, std::ios::binary);
-  std::vector<char> input_buffer(length);
-  file.seekg(offset);
-  file.read(input_buffer.data(), length);
-
+  const std::string_view input = getData(offset, length);
   if(compression_type == COMPRESSION_NONE)
-    return { input_buffer.data(), length };
-  else if(compression_type == COMPRESSION_LZ4)
+    return std::string(input);
+
+  // data is decompressed directly into the returned string
+  std::string output(uncompressed_size, '\0');
+  if(compression_type == COMPRESSION_LZ4)
   {
-    std::vector<char> output_buffer(uncompressed_size);
     int ret_code = LZ4_decompress_safe_partial(
-      input_buffer.data(), output_buffer.data(), length, uncompressed_size, uncompressed_size);
+      input.data(), output.data(), length, uncompressed_size, uncompressed_size);
     if(ret_code < 0)
       throw std::runtime_error(std::format("LZ4 decompression failed with code: {}", ret_code));
-
-    return { output_buffer.data(), uncompressed_size };
   }
   else if(compression_type == COMPRESSION_ZSTD)
   {
-    std::vector<char> output_buffer(uncompressed_size);
-    const size_t actual_size = ZSTD_decompress(reinterpret_cast<void*>(output_buffer.data()),
-                                               uncompressed_size,
-                                               reinterpret_cast<const void*>(input_buffer.data()),
-                                               input_buffer.size());
+    if(!zstd_context_)
+      zstd_context_ = ZSTD_createDCtx();
+    if(!zstd_context_)
+      throw std::runtime_error("zstd initialization failed.");
+    const size_t actual_size =
+      ZSTD_decompressDCtx(zstd_context_, output.data(), uncompressed_size, input.data(), length);
     if(ZSTD_isError(actual_size))
       throw std::runtime_error(std::format("zstd decompression failed with code: {}", actual_size));
-    return { output_buffer.data(), uncompressed_size };
   }
   else if(compression_type == COMPRESSION_ZLIB)
   {
-    z_stream stream;
-    stream.zalloc = Z_NULL;
-    stream.zfree = Z_NULL;
-    stream.opaque = Z_NULL;
-    if (inflateInit(&stream) != Z_OK)
+    if(!zlib_stream_initialized_)
+    {
+      zlib_stream_.zalloc = Z_NULL;
+      zlib_stream_.zfree = Z_NULL;
+      zlib_stream_.opaque = Z_NULL;
+      if(inflateInit(&zlib_stream_) != Z_OK)
+        throw std::runtime_error("zlib initialization failed.");
+      zlib_stream_initialized_ = true;
+    }
+    else if(inflateReset(&zlib_stream_) != Z_OK)
       throw std::runtime_error("zlib initialization failed.");
-    stream.avail_in = input_buffer.size();
-    stream.next_in = reinterpret_cast<Bytef*>(input_buffer.data());
-
-    std::vector<char> output_buffer(uncompressed_size);
-    stream.avail_out = uncompressed_size;
-    stream.next_out = reinterpret_cast<Bytef*>(output_buffer.data());
-    inflateInit(&stream);
-    int code = inflate(&stream, Z_NO_FLUSH);
-    inflateEnd(&stream);
+    zlib_stream_.avail_in = length;
+    zlib_stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    zlib_stream_.avail_out = uncompressed_size;
+    zlib_stream_.next_out = reinterpret_cast<Bytef*>(output.data());
+    int code = inflate(&zlib_stream_, Z_NO_FLUSH);
     if(code < 0)
       throw std::runtime_error(std::format("zlib decompression failed with code: {}", code));
-    return { output_buffer.data(), uncompressed_size };
   }
   else
     throw std::runtime_error(std::format("Unsopported compression type: {}", compression_type));
+  return output;
 }
 
 std::vector<std::filesystem::path> LsPakExtractor::getFileList()
 {
   std::vector<sfs::path> path_list;
+  path_list.reserve(file_list_.size());
   for(const auto& f : file_list_)
-    path_list.emplace_back(f.path);
+    path_list.emplace_back(std::string_view(f.path, strnlen(f.path, sizeof(f.path))));
   return path_list;
 }
 
@@ -115,18 +156,17 @@ std::string LsPakExtractor::extractFile(int file_id)
 
 unsigned int LsPakExtractor::readFileList()
 {
-  std::ifstream file(source_path_, std::ios::binary);
-  file.seekg(header_->file_list_offset);
-  std::vector<char> buffer(4);
-  file.read(buffer.data(), 4);
-  unsigned int num_files = *reinterpret_cast<unsigned int*>(buffer.data());
-  file.read(buffer.data(), 4);
-  unsigned int compressed_size = *reinterpret_cast<unsigned int*>(buffer.data());
-  std::string data = extractData(
-    file.tellg(), compressed_size, sizeof(LsPakFileListEntry) * num_files, COMPRESSION_LZ4);
+  const std::string_view file_list_header = getData(header_.file_list_offset, 8);
+  unsigned int num_files;
+  unsigned int compressed_size;
+  std::memcpy(&num_files, file_list_header.data(), 4);
+  std::memcpy(&compressed_size, file_list_header.data() + 4, 4);
+  std::string data = extractData(header_.file_list_offset + 8,
+                                 compressed_size,
+                                 sizeof(LsPakFileListEntry) * num_files,
+                                 COMPRESSION_LZ4);
 
-  file_list_.clear();
-  for(int i = 0; i < sizeof(LsPakFileListEntry) * num_files; i += sizeof(LsPakFileListEntry))
-    file_list_.push_back(*reinterpret_cast<LsPakFileListEntry*>(data.data() + i));
+  file_list_.resize(num_files);
+  std::memcpy(file_list_.data(), data.data(), data.size());
   return compressed_size;
 }
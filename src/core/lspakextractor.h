@@ -8,11 +8,15 @@
 #include "lspakfilelistentry.h"
 #include "lspakheader.h"
 #include <filesystem>
+#include <string_view>
 #include <vector>
+#include <zlib.h>
+#include <zstd.h>
 
 
 /*!
  * \brief Class providing functions for extracting files from a .pak archive used for Baldurs Gate 3.
+ * The archive is memory mapped once in \ref init, all entries are read from that mapping.
  */
 class LsPakExtractor
 {
@@ -22,8 +26,12 @@ public:
    * \param source_path Target archive path.
    */
   LsPakExtractor(const std::filesystem::path& source_path);
+  LsPakExtractor(const LsPakExtractor&) = delete;
+  LsPakExtractor& operator=(const LsPakExtractor&) = delete;
+  /*! \brief Unmaps the archive and frees all decompression contexts. */
+  ~LsPakExtractor();
 
-  /*! \brief Initializes header and file list from the source archive. */
+  /*! \brief Maps the source archive and initializes header and file list from it. */
   void init();
   /*!
    * \brief Returns a vector of paths to files in the archive.
@@ -54,11 +62,29 @@ private:
   static constexpr unsigned int LS_PAK_SUPPORTED_VERSION = 18;
   /*! \brief Path to the source archive. */
   std::filesystem::path source_path_;
+  /*! \brief Start of the memory mapped archive. */
+  void* data_ = nullptr;
+  /*! \brief Size of the memory mapped archive. */
+  size_t data_size_ = 0;
   /*! \brief Contains the archive's header. */
-  std::unique_ptr<LsPakHeader> header_;
+  LsPakHeader header_;
   /*! \brief Contains all file list entries of the archive. */
   std::vector<LsPakFileListEntry> file_list_;
+  /*! \brief zstd decompression context, reused for every file. */
+  ZSTD_DCtx* zstd_context_ = nullptr;
+  /*! \brief zlib decompression stream, reused for every file. */
+  z_stream zlib_stream_{};
+  /*! \brief True if zlib_stream_ has been initialized. */
+  bool zlib_stream_initialized_ = false;
 
+  /*!
+   * \brief Returns the given range of the mapped archive.
+   * Throws std::runtime_error if the range exceeds the archive.
+   * \param offset Offset of the range.
+   * \param length Length of the range.
+   * \return The range.
+   */
+  std::string_view getData(unsigned long offset, unsigned long length) const;
   /*!
    * \brief Extracts and, if necessary, decompresses data from the source archive.
    * \param offset Offset from which to extract data.
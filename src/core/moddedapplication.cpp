@@ -1,13 +1,21 @@
 #include "moddedapplication.h"
+#include "casefoldeddirectoryindex.h"
 #include "deployerfactory.h"
 #include "installer.h"
+#include "modfilecatalog.h"
 #include "parseerror.h"
 #include "pathutils.h"
 #include "reversedeployer.h"
+#include "settingscache.h"
+#include "settingsjournal.h"
+#include "tagevaluationplan.h"
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <ranges>
 #include <regex>
+#include <thread>
+#include <utility>
 
 namespace sfs = std::filesystem;
 namespace str = std::ranges;
@@ -19,7 +27,8 @@ ModdedApplication::ModdedApplication(sfs::path staging_dir,
                                      std::string command,
                                      std::filesystem::path icon_path,
                                      std::string app_version) :
-  name_(name), staging_dir_(staging_dir), command_(command), icon_path_(icon_path)
+  name_(name), staging_dir_(staging_dir), command_(command), icon_path_(icon_path),
+  mod_file_catalog_(std::make_shared<ModFileCatalog>(staging_dir))
 {
   if(sfs::exists(staging_dir / CONFIG_FILE_NAME))
     updateState(true);
@@ -55,19 +64,20 @@ void ModdedApplication::deployModsFor(std::vector<int> deployers)
   {
     const int num_mods = deployers_[deployer]->getNumMods();
     // Reverse deployer operations are faster than other operations
-    if(deployers_[deployer]->getType() == DeployerFactory::REVERSEDEPLOYER)
+    if(deployers_[deployer].getType() == DeployerFactory::REVERSEDEPLOYER)
       weights.push_back((int)(num_mods / 8));
-    else if(deployers_[deployer]->isAutonomous() || num_mods == 0)
+    else if(deployers_[deployer].isAutonomous() || num_mods == 0)
       weights.push_back(1);
     else
       weights.push_back(num_mods);
   }
 
-  ProgressNode node(progress_callback_, weights);
+  ProgressNode node(progress_callback_, weights, stop_token_);
   for(auto [i, deployer] : str::enumerate_view(deployers))
   {
+    node.checkStop();
     const auto mod_sizes = deployers_[deployer]->deploy(&(node.child(i)));
-    if(!deployers_[deployer]->isAutonomous())
+    if(!deployers_[deployer].isAutonomous())
     {
       for(const auto [mod_id, mod_size] : mod_sizes)
       {
@@ -79,7 +89,7 @@ void ModdedApplication::deployModsFor(std::vector<int> deployers)
     }
   }
 
-  updateSettings(true);
+  updateSettings(true, mod_settings | deployer_settings);
 }
 
 void ModdedApplication::unDeployMods()
@@ -103,80 +113,208 @@ void ModdedApplication::unDeployModsFor(std::vector<int> deployers)
   for(int deployer : deployers)
   {
     const int num_mods = deployers_[deployer]->getNumMods();
-    if(deployers_[deployer]->isAutonomous() || num_mods == 0)
+    if(deployers_[deployer].isAutonomous() || num_mods == 0)
       weights.push_back(1);
     else
       weights.push_back(num_mods);
   }
 
-  ProgressNode node(progress_callback_, weights);
+  ProgressNode node(progress_callback_, weights, stop_token_);
   for(auto [i, deployer] : str::enumerate_view(deployers))
     deployers_[deployer]->unDeploy(&(node.child(i)));
 
-  updateSettings(true);
+  updateSettings(true, deployer_settings);
 }
 
 void ModdedApplication::installMod(const ImportModInfo& info)
 {
-  if(info.replace_mod && info.target_group_id != -1)
+  installMods({ info });
+}
+
+void ModdedApplication::installMods(const std::vector<ImportModInfo>& infos)
+{
+  // mods which failed to install are removed below, cleanupFailedInstallation must not
+  // remove mods which were installed successfully
+  last_mod_id_ = -1;
+  std::vector<const ImportModInfo*> new_mods;
+  for(const auto& info : infos)
   {
-    replaceMod(info);
-    return;
+    if(info.replace_mod && info.target_group_id != -1)
+      replaceMod(info);
+    else
+      new_mods.push_back(&info);
   }
-  ProgressNode progress_node(progress_callback_);
-  if(info.target_group_id >= 0 && !info.deployers.empty())
-    progress_node.addChildren({ 1.0f, 10.0f, info.deployers.size() > 1 ? 10.0f : 1.0f });
-  else if(info.target_group_id >= 0 || !info.deployers.empty())
-    progress_node.addChildren({ 1, 10 });
-  else
-    progress_node.addChildren({ 1 });
-  progress_node.child(0).setTotalSteps(1);
+  if(new_mods.empty())
+    return;
+
+  ProgressNode progress_node(progress_callback_, {}, stop_token_);
+  progress_node.addChildren({ 10.0f * new_mods.size(), 1.0f, 1.0f });
+  progress_node.child(0).setTotalSteps(new_mods.size());
+  std::vector<int> mod_ids;
   int mod_id = 0;
   if(!installed_mods_.empty())
     mod_id = std::max_element(installed_mods_.begin(), installed_mods_.end())->id + 1;
-  while(pu::exists(staging_dir_ / std::to_string(mod_id)) &&
-        mod_id < std::numeric_limits<int>().max())
-    mod_id++;
-  if(mod_id == std::numeric_limits<int>().max())
-    throw std::runtime_error("Error: Could not generate new mod id.");
-  last_mod_id_ = mod_id;
-  const auto mod_size = Installer::install(info.current_path,
-                                           staging_dir_ / std::to_string(mod_id),
-                                           info.installer_flags,
-                                           info.installer,
-                                           info.root_level,
-                                           info.files);
+  for(int i = 0; i < new_mods.size(); i++)
+  {
+    while(pu::exists(staging_dir_ / std::to_string(mod_id)) &&
+          mod_id < std::numeric_limits<int>().max())
+      mod_id++;
+    if(mod_id == std::numeric_limits<int>().max())
+      throw std::runtime_error("Error: Could not generate new mod id.");
+    mod_ids.push_back(mod_id++);
+  }
+
+  // extraction and installation of different mods are independent of each other
+  std::vector<unsigned long> mod_sizes(new_mods.size());
+  std::vector<std::exception_ptr> errors(new_mods.size());
+  std::atomic<size_t> next_mod = 0;
+  auto install_mods = [&]()
+  {
+    for(size_t i = next_mod++; i < new_mods.size(); i = next_mod++)
+    {
+      const ImportModInfo& info = *new_mods[i];
+      try
+      {
+        mod_sizes[i] = Installer::install(info.current_path,
+                                          staging_dir_ / std::to_string(mod_ids[i]),
+                                          info.installer_flags,
+                                          info.installer,
+                                          info.root_level,
+                                          info.files);
+      }
+      catch(...)
+      {
+        errors[i] = std::current_exception();
+        sfs::remove_all(staging_dir_ / std::to_string(mod_ids[i]));
+      }
+      progress_node.child(0).advance();
+    }
+  };
+  const size_t num_threads = std::clamp<size_t>(
+    std::min<size_t>(std::thread::hardware_concurrency(), new_mods.size()), 1, MAX_INSTALL_THREADS);
+  std::vector<std::jthread> threads;
+  for(size_t i = 1; i < num_threads; i++)
+    threads.emplace_back(install_mods);
+  install_mods();
+  threads.clear();
+
+  // all successfully installed mods are committed at once
+  std::exception_ptr first_error;
+  std::vector<int> installed_ids;
+  std::vector<std::vector<int>> deployer_mods(deployers_.size());
+  bool groups_changed = false;
   const auto time_now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-  installed_mods_.emplace_back(mod_id,
-                               info.name,
-                               info.version,
-                               time_now,
-                               info.local_source,
-                               info.remote_source,
-                               time_now,
-                               mod_size,
-                               time_now,
-                               info.remote_mod_id,
-                               info.remote_file_id,
-                               info.remote_type);
-  installer_map_[mod_id] = info.installer;
-  progress_node.child(0).advance();
-  if(info.target_group_id >= 0)
-  {
-    if(modHasGroup(info.target_group_id))
-      addModToGroup(mod_id, group_map_[info.target_group_id], &progress_node.child(1));
-    else
-      createGroup(mod_id, info.target_group_id, &progress_node.child(1));
+  for(int i = 0; i < new_mods.size(); i++)
+  {
+    const ImportModInfo& info = *new_mods[i];
+    if(errors[i])
+    {
+      if(!first_error)
+        first_error = errors[i];
+      try
+      {
+        std::rethrow_exception(errors[i]);
+      }
+      catch(const std::exception& error)
+      {
+        log_(Log::LOG_ERROR,
+             std::format("Failed to install mod '{}': {}", info.name, error.what()));
+      }
+      catch(...)
+      {
+        log_(Log::LOG_ERROR, std::format("Failed to install mod '{}'", info.name));
+      }
+      continue;
+    }
+    const int id = mod_ids[i];
+    mod_file_catalog_->invalidate(id);
+    installed_mods_.emplace_back(id,
+                                 info.name,
+                                 info.version,
+                                 time_now,
+                                 info.local_source,
+                                 info.remote_source,
+                                 time_now,
+                                 mod_sizes[i],
+                                 time_now,
+                                 info.remote_mod_id,
+                                 info.remote_file_id,
+                                 info.remote_type);
+    installer_map_[id] = info.installer;
+    installed_ids.push_back(id);
+    if(info.target_group_id >= 0 && !group_map_.contains(id))
+    {
+      if(modHasGroup(info.target_group_id))
+      {
+        const int group = group_map_[info.target_group_id];
+        groups_[group].push_back(id);
+        group_map_[id] = group;
+        active_group_members_[group] = id;
+      }
+      else
+      {
+        groups_.push_back({ id, info.target_group_id });
+        group_map_[id] = groups_.size() - 1;
+        group_map_[info.target_group_id] = groups_.size() - 1;
+        active_group_members_.push_back(id);
+      }
+      groups_changed = true;
+    }
+    for(int deployer : info.deployers)
+      deployer_mods[deployer].push_back(id);
   }
 
-  for(int deployer : info.deployers)
-    addModToDeployer(deployer, mod_id, true, &progress_node.child(info.target_group_id >= 0 ? 2 : 1));
+  // a single mod is removed by cleanupFailedInstallation if any of the following steps fails
+  if(new_mods.size() == 1 && installed_ids.size() == 1)
+    last_mod_id_ = installed_ids.front();
 
-  for(auto& tag : auto_tags_)
-    tag.updateMods(staging_dir_, std::vector<int>{ mod_id });
-  updateAutoTagMap();
+  if(groups_changed)
+    updateDeployerGroups(&progress_node.child(1));
+  else
+  {
+    progress_node.child(1).setTotalSteps(1);
+    progress_node.child(1).advance();
+  }
 
+  std::vector<int> changed_deployers;
+  std::vector<float> weights;
+  for(int depl = 0; depl < deployers_.size(); depl++)
+  {
+    if(deployers_[depl].isAutonomous())
+      continue;
+    bool was_added = false;
+    for(int id : deployer_mods[depl])
+      was_added |= deployers_[depl]->addMod(id);
+    if(was_added)
+    {
+      changed_deployers.push_back(depl);
+      weights.push_back(deployers_[depl]->getNumMods());
+    }
+  }
+  if(changed_deployers.empty())
+  {
+    progress_node.child(2).setTotalSteps(1);
+    progress_node.child(2).advance();
+  }
+  else
+    progress_node.child(2).addChildren(weights);
+  for(const auto& [i, depl] : str::enumerate_view(changed_deployers))
+    deployers_[depl]->updateConflictGroups(&progress_node.child(2).child(i));
+  for(int depl = 0; depl < deployers_.size(); depl++)
+  {
+    for(int id : deployer_mods[depl])
+      splitMod(id, depl);
+  }
+
+  if(!installed_ids.empty())
+  {
+    applyAutoTags(getAutoTagPointers(), installed_ids, false);
+    updateAutoTagMap();
+  }
   updateSettings(true);
+  last_mod_id_ = -1;
+  if(first_error)
+    std::rethrow_exception(first_error);
 }
 
 void ModdedApplication::uninstallMods(const std::vector<int>& mod_ids,
@@ -196,7 +334,7 @@ void ModdedApplication::uninstallMods(const std::vector<int>& mod_ids,
       continue;
     for(int depl = 0; depl < deployers_.size(); depl++)
     {
-      if(deployers_[depl]->isAutonomous())
+      if(deployers_[depl].isAutonomous())
         continue;
       for(int prof = 0; prof < profile_names_.size(); prof++)
       {
@@ -209,6 +347,7 @@ void ModdedApplication::uninstallMods(const std::vector<int>& mod_ids,
         }
       }
       deployers_[depl]->setProfile(current_profile_);
+      deployers_[depl]->invalidateModFiles(mod_id);
     }
 
     installed_mods_.erase(mod_iter);
@@ -216,12 +355,13 @@ void ModdedApplication::uninstallMods(const std::vector<int>& mod_ids,
     if(installer_type == "" && installer_map_.contains(mod_id))
       installer = installer_map_[mod_id];
     Installer::uninstall(staging_dir_ / std::to_string(mod_id), installer);
+    mod_file_catalog_->invalidate(mod_id);
 
     for(auto& tag : manual_tags_)
       tag.removeMod(mod_id);
   }
 
-  ProgressNode node(progress_callback_, weights);
+  ProgressNode node(progress_callback_, weights, stop_token_);
   int i = 0;
   for(int depl = 0; depl < update_targets.size(); depl++)
   {
@@ -240,7 +380,7 @@ void ModdedApplication::uninstallMods(const std::vector<int>& mod_ids,
 void ModdedApplication::changeLoadorder(int deployer, int from_index, int to_index)
 {
   deployers_[deployer]->changeLoadorder(from_index, to_index);
-  updateSettings(true);
+  updateSettings(true, deployer_settings);
 }
 
 void ModdedApplication::addModToDeployer(int deployer,
@@ -248,10 +388,10 @@ void ModdedApplication::addModToDeployer(int deployer,
                                          bool update_conflicts,
                                          std::optional<ProgressNode*> progress_node)
 {
-  if(!deployers_[deployer]->isAutonomous())
+  if(!deployers_[deployer].isAutonomous())
   {
     const bool was_added = deployers_[deployer]->addMod(mod_id);
-    ProgressNode node(progress_callback_);
+    ProgressNode node(progress_callback_, {}, stop_token_);
     if(update_conflicts && was_added)
       deployers_[deployer]->updateConflictGroups(progress_node ? progress_node : &node);
     else if(progress_node)
@@ -269,10 +409,10 @@ void ModdedApplication::removeModFromDeployer(int deployer,
                                               bool update_conflicts,
                                               std::optional<ProgressNode*> progress_node)
 {
-  if(!deployers_[deployer]->isAutonomous())
+  if(!deployers_[deployer].isAutonomous())
   {
     const bool was_removed = deployers_[deployer]->removeMod(mod_id);
-    ProgressNode node(progress_callback_);
+    ProgressNode node(progress_callback_, {}, stop_token_);
     if(update_conflicts && was_removed)
       deployers_[deployer]->updateConflictGroups(progress_node ? progress_node : &node);
     else if(progress_node)
@@ -280,14 +420,14 @@ void ModdedApplication::removeModFromDeployer(int deployer,
       (*progress_node)->setTotalSteps(1);
       (*progress_node)->advance();
     }
-    updateSettings(true);
+    updateSettings(true, deployer_settings);
   }
 }
 
 void ModdedApplication::setModStatus(int deployer, int mod_id, bool status)
 {
   deployers_[deployer]->setModStatus(mod_id, status);
-  updateSettings(true);
+  updateSettings(true, deployer_settings);
 }
 
 void ModdedApplication::addDeployer(const EditDeployerInfo& info)
@@ -315,6 +455,7 @@ void ModdedApplication::addDeployer(const EditDeployerInfo& info)
     deployers_.back()->addProfile();
   deployers_.back()->setProfile(current_profile_);
   deployers_.back()->setLog(log_);
+  deployers_.back()->setModFileCatalog(mod_file_catalog_);
   if(!is_autonomous)
   {
     for(int i = 0; i < installed_mods_.size(); i++)
@@ -334,14 +475,14 @@ void ModdedApplication::removeDeployer(int deployer, bool cleanup)
   if(cleanup)
     deployers_[deployer]->cleanup();
   deployers_.erase(deployers_.begin() + deployer);
-  updateSettings(true);
+  updateSettings(true, deployer_settings);
 }
 
 std::vector<std::string> ModdedApplication::getDeployerNames() const
 {
   std::vector<std::string> names;
   for(const auto& deployer : deployers_)
-    names.push_back(deployer->getName());
+    names.push_back(deployer.getName());
   return names;
 }
 
@@ -355,7 +496,7 @@ std::vector<ModInfo> ModdedApplication::getModInfo() const
     std::vector<bool> statuses;
     for(int i = 0; i < deployers_.size(); i++)
     {
-      if(deployers_[i]->isAutonomous())
+      if(deployers_[i].isAutonomous())
         continue;
       auto status = deployers_[i]->getModStatus(mod.id);
       if(status)
@@ -409,8 +550,13 @@ void ModdedApplication::setStagingDir(std::string staging_dir, bool move_existin
       sfs::rename(staging_dir_ / mod_dir, sfs::path(staging_dir) / mod_dir);
     }
     sfs::rename(staging_dir_ / CONFIG_FILE_NAME, sfs::path(staging_dir) / CONFIG_FILE_NAME);
+    if(sfs::exists(staging_dir_ / JOURNAL_FILE_NAME))
+      sfs::rename(staging_dir_ / JOURNAL_FILE_NAME, sfs::path(staging_dir) / JOURNAL_FILE_NAME);
+    if(sfs::exists(staging_dir_ / CACHE_FILE_NAME))
+      sfs::rename(staging_dir_ / CACHE_FILE_NAME, sfs::path(staging_dir) / CACHE_FILE_NAME);
   }
   staging_dir_ = staging_dir;
+  mod_file_catalog_ = std::make_shared<ModFileCatalog>(staging_dir_);
   updateState(true);
 }
 
@@ -422,7 +568,7 @@ const std::string& ModdedApplication::name() const
 void ModdedApplication::setName(const std::string& newName)
 {
   name_ = newName;
-  updateSettings(true);
+  updateSettings(true, general_settings);
 }
 
 int ModdedApplication::getNumDeployers() const
@@ -442,16 +588,16 @@ void ModdedApplication::changeModName(int mod_id, const std::string& new_name)
   if(iter == installed_mods_.end())
     throw std::runtime_error("Error: Unknown mod id: " + std::to_string(mod_id));
   iter->name = new_name;
-  updateSettings(true);
+  updateSettings(true, mod_settings);
 }
 
 std::vector<ConflictInfo> ModdedApplication::getFileConflicts(int deployer,
                                                               int mod_id,
                                                               bool show_disabled) const
 {
-  ProgressNode node(progress_callback_);
+  ProgressNode node(progress_callback_, {}, stop_token_);
   auto conflicts = deployers_[deployer]->getFileConflicts(mod_id, show_disabled, &node);
-  if(deployers_[deployer]->isAutonomous())
+  if(deployers_[deployer].isAutonomous())
     return conflicts;
   for(auto& [_, ids, names] : conflicts)
   {
@@ -472,13 +618,13 @@ AppInfo ModdedApplication::getAppInfo() const
   info.steam_app_id = steam_app_id_;
   for(const auto& deployer : deployers_)
   {
-    info.deployers.push_back(deployer->getName());
-    info.deployer_types.push_back(deployer->getType());
-    info.target_dirs.push_back(deployer->getDestPath());
-    info.deployer_source_dirs.push_back(deployer->getSourcePath());
-    info.deployer_mods.push_back(deployer->getNumMods());
-    info.deploy_modes.push_back(deployer->getDeployMode());
-    info.deployer_is_case_invariant.push_back(deployer->isCaseInvariant());
+    info.deployers.push_back(deployer.getName());
+    info.deployer_types.push_back(deployer.getType());
+    info.target_dirs.push_back(deployer.getDestPath());
+    info.deployer_source_dirs.push_back(deployer.getSourcePath());
+    info.deployer_mods.push_back(deployer.getNumMods());
+    info.deploy_modes.push_back(deployer.getDeployMode());
+    info.deployer_is_case_invariant.push_back(deployer.isCaseInvariant());
   }
   info.tools = tools_;
   for(const auto& tag : manual_tags_)
@@ -494,7 +640,7 @@ AppInfo ModdedApplication::getAppInfo() const
 void ModdedApplication::addTool(const Tool& tool)
 {
   tools_.push_back(tool);
-  updateSettings(true);
+  updateSettings(true, tool_settings);
 }
 
 void ModdedApplication::removeTool(int tool_id)
@@ -502,7 +648,7 @@ void ModdedApplication::removeTool(int tool_id)
   if(tool_id < tools_.size() && tool_id >= 0)
   {
     tools_.erase(tools_.begin() + tool_id);
-    updateSettings(true);
+    updateSettings(true, tool_settings);
   }
 }
 
@@ -519,12 +665,12 @@ const std::string& ModdedApplication::command() const
 void ModdedApplication::setCommand(const std::string& newCommand)
 {
   command_ = newCommand;
-  updateSettings(true);
+  updateSettings(true, general_settings);
 }
 
 void ModdedApplication::editDeployer(int deployer, const EditDeployerInfo& info)
 {
-  if(deployers_[deployer]->getType() == info.type)
+  if(deployers_[deployer].getType() == info.type)
   {
     deployers_[deployer]->setName(info.name);
     deployers_[deployer]->setDestPath(info.target_dir);
@@ -551,7 +697,7 @@ void ModdedApplication::editDeployer(int deployer, const EditDeployerInfo& info)
     json_settings_["deployers"][deployer]["enable_unsafe_sorting"] = info.enable_unsafe_sorting;
     updateState();
   }
-  if(deployers_[deployer]->isAutonomous() && info.type != DeployerFactory::REVERSEDEPLOYER)
+  if(deployers_[deployer].isAutonomous() && info.type != DeployerFactory::REVERSEDEPLOYER)
     deployers_[deployer]->setSourcePath(info.source_dir);
   if(info.type == DeployerFactory::REVERSEDEPLOYER)
   {
@@ -562,12 +708,12 @@ void ModdedApplication::editDeployer(int deployer, const EditDeployerInfo& info)
     else if(info.update_ignore_list && depl->getNumIgnoredFiles() == 0)
       depl->updateIgnoredFiles(true);
   }
-  updateSettings(true);
+  updateSettings(true, deployer_settings);
 }
 
 std::unordered_set<int> ModdedApplication::getModConflicts(int deployer, int mod_id)
 {
-  ProgressNode node(progress_callback_);
+  ProgressNode node(progress_callback_, {}, stop_token_);
   return deployers_[deployer]->getModConflicts(mod_id, &node);
 }
 
@@ -588,7 +734,7 @@ void ModdedApplication::addProfile(const EditProfileInfo& info)
   for(const auto& deployer : deployers_)
     deployer->addProfile(info.source);
   bak_man_.addProfile(info.source);
-  updateSettings(true);
+  updateSettings(true, profile_settings | deployer_settings);
 }
 
 void ModdedApplication::removeProfile(int profile)
@@ -604,7 +750,7 @@ void ModdedApplication::removeProfile(int profile)
     setProfile(0);
   else if(profile < current_profile_)
     setProfile(current_profile_ - 1);
-  updateSettings(true);
+  updateSettings(true, profile_settings | deployer_settings);
 }
 
 std::vector<std::string> ModdedApplication::getProfileNames() const
@@ -618,14 +764,14 @@ void ModdedApplication::editProfile(int profile, const EditProfileInfo& info)
     return;
   profile_names_[profile] = info.name;
   app_versions_[profile] = info.app_version;
-  updateSettings(true);
+  updateSettings(true, profile_settings | deployer_settings);
 }
 
 void ModdedApplication::editTool(int tool_id, const Tool& new_tool)
 {
   if(tool_id >= 0 && tool_id < tools_.size())
     tools_[tool_id] = new_tool;
-  updateSettings(true);
+  updateSettings(true, tool_settings);
 }
 
 std::tuple<int, std::string, std::string> ModdedApplication::verifyDeployerDirectories()
@@ -651,7 +797,7 @@ void ModdedApplication::addModToGroup(int mod_id,
   groups_[group].push_back(mod_id);
   group_map_[mod_id] = group;
   active_group_members_[group] = mod_id;
-  ProgressNode node(progress_callback_);
+  ProgressNode node(progress_callback_, {}, stop_token_);
   updateDeployerGroups(progress_node ? progress_node : &node);
   updateSettings(true);
 }
@@ -673,7 +819,7 @@ void ModdedApplication::removeModFromGroup(int mod_id,
     for(int depl = 0; depl < deployers_.size(); depl++)
     {
       update_targets.push_back({});
-      if(deployers_[depl]->isAutonomous())
+      if(deployers_[depl].isAutonomous())
         continue;
       for(int prof = 0; prof < profile_names_.size(); prof++)
       {
@@ -692,7 +838,8 @@ void ModdedApplication::removeModFromGroup(int mod_id,
       deployers_[depl]->setProfile(current_profile_);
     }
 
-    ProgressNode node = progress_node ? **progress_node : ProgressNode(progress_callback_);
+    ProgressNode own_node(progress_callback_, {}, stop_token_);
+    ProgressNode& node = progress_node ? **progress_node : own_node;
     if(!update_conflicts)
     {
       node.setTotalSteps(1);
@@ -750,7 +897,7 @@ void ModdedApplication::createGroup(int first_mod_id,
   group_map_[first_mod_id] = group;
   group_map_[second_mod_id] = group;
   active_group_members_.push_back(first_mod_id);
-  ProgressNode node(progress_callback_);
+  ProgressNode node(progress_callback_, {}, stop_token_);
   updateDeployerGroups(progress_node ? progress_node : &node);
   updateSettings(true);
 }
@@ -763,9 +910,9 @@ void ModdedApplication::changeActiveGroupMember(int group,
      std::find(groups_[group].begin(), groups_[group].end(), mod_id) == groups_[group].end())
     return;
   active_group_members_[group] = mod_id;
-  ProgressNode node(progress_callback_);
+  ProgressNode node(progress_callback_, {}, stop_token_);
   updateDeployerGroups(progress_node ? progress_node : &node);
-  updateSettings(true);
+  updateSettings(true, group_settings | deployer_settings);
 }
 
 void ModdedApplication::changeModVersion(int mod_id, const std::string& new_version)
@@ -775,7 +922,7 @@ void ModdedApplication::changeModVersion(int mod_id, const std::string& new_vers
   if(iter == installed_mods_.end())
     throw std::runtime_error("Error: Unknown mod id: " + std::to_string(mod_id));
   iter->version = new_version;
-  updateSettings(true);
+  updateSettings(true, mod_settings);
 }
 
 int ModdedApplication::getNumGroups()
@@ -797,9 +944,9 @@ int ModdedApplication::getModGroup(int mod_id)
 
 void ModdedApplication::sortModsByConflicts(int deployer)
 {
-  ProgressNode node(progress_callback_);
+  ProgressNode node(progress_callback_, {}, stop_token_);
   deployers_[deployer]->sortModsByConflicts(&node);
-  updateSettings(true);
+  updateSettings(true, deployer_settings);
 }
 
 std::vector<std::vector<int>> ModdedApplication::getConflictGroups(int deployer)
@@ -812,8 +959,8 @@ void ModdedApplication::updateModDeployers(const std::vector<int>& mod_ids,
 {
   std::vector<float> weights;
   for(const auto& depl : deployers_)
-    weights.push_back(depl->isAutonomous() ? 1 : depl->getNumMods());
-  ProgressNode node(progress_callback_, weights);
+    weights.push_back(depl.isAutonomous() ? 1 : depl->getNumMods());
+  ProgressNode node(progress_callback_, weights, stop_token_);
   std::optional<ProgressNode*> dummy_node{};
   for(int i = 0; i < mod_ids.size(); i++)
   {
@@ -821,7 +968,7 @@ void ModdedApplication::updateModDeployers(const std::vector<int>& mod_ids,
     const bool is_last_mod = i == (mod_ids.size() - 1);
     for(int depl = 0; depl < deployers.size(); depl++)
     {
-      if(deployers_[depl]->isAutonomous())
+      if(deployers_[depl].isAutonomous())
         continue;
       if(deployers[depl])
         addModToDeployer(depl, mod_id, is_last_mod, is_last_mod ? &node.child(depl) : dummy_node);
@@ -855,7 +1002,7 @@ int ModdedApplication::verifyStagingDir(sfs::path staging_dir)
 
 DeployerInfo ModdedApplication::getDeployerInfo(int deployer)
 {
-  if(!(deployers_[deployer]->isAutonomous()))
+  if(!(deployers_[deployer].isAutonomous()))
   {
     std::map<std::string, int> mods_per_tag;
     for(const auto& tag : manual_tags_)
@@ -903,7 +1050,7 @@ DeployerInfo ModdedApplication::getDeployerInfo(int deployer)
              deployers_[deployer]->supportsModConflicts(),
              deployers_[deployer]->supportsFileConflicts(),
              deployers_[deployer]->supportsFileBrowsing(),
-             deployers_[deployer]->getType(),
+             deployers_[deployer].getType(),
              deployers_[deployer]->idsAreSourceReferences(),
              {},
              deployers_[deployer]->getModActions(),
@@ -934,7 +1081,7 @@ DeployerInfo ModdedApplication::getDeployerInfo(int deployer)
     }
     bool separate_dirs = false;
     bool has_ignored_files = false;
-    if(deployers_[deployer]->getType() == DeployerFactory::REVERSEDEPLOYER)
+    if(deployers_[deployer].getType() == DeployerFactory::REVERSEDEPLOYER)
     {
       auto depl = static_cast<ReverseDeployer*>(deployers_[deployer].get());
       separate_dirs = depl->usesSeparateDirs();
@@ -954,7 +1101,7 @@ DeployerInfo ModdedApplication::getDeployerInfo(int deployer)
              deployers_[deployer]->supportsModConflicts(),
              deployers_[deployer]->supportsFileConflicts(),
              deployers_[deployer]->supportsFileBrowsing(),
-             deployers_[deployer]->getType(),
+             deployers_[deployer].getType(),
              deployers_[deployer]->idsAreSourceReferences(),
              mod_names,
              deployers_[deployer]->getModActions(),
@@ -967,7 +1114,7 @@ void ModdedApplication::setLog(const std::function<void(Log::LogLevel, const std
 {
   log_ = newLog;
   for(auto& deployer : deployers_)
-    deployer->setLog(newLog);
+    deployer.setLog(newLog);
 }
 
 void ModdedApplication::addBackupTarget(const sfs::path& path,
@@ -975,7 +1122,7 @@ void ModdedApplication::addBackupTarget(const sfs::path& path,
                                         const std::vector<std::string>& backup_names)
 {
   bak_man_.addTarget(path, name, backup_names);
-  updateSettings(true);
+  updateSettings(true, backup_settings);
 }
 
 void ModdedApplication::removeBackupTarget(int target_id)
@@ -983,7 +1130,7 @@ void ModdedApplication::removeBackupTarget(int target_id)
   if(target_id < 0 || target_id >= bak_man_.getNumTargets())
     return;
   bak_man_.removeTarget(target_id);
-  updateSettings(true);
+  updateSettings(true, backup_settings);
 }
 
 void ModdedApplication::removeAllBackupTargets()
@@ -1058,6 +1205,11 @@ void ModdedApplication::setProgressCallback(const std::function<void(float)>& pr
   progress_callback_ = progress_callback;
 }
 
+void ModdedApplication::setStopToken(std::stop_token stop_token)
+{
+  stop_token_ = stop_token;
+}
+
 void ModdedApplication::uninstallGroupMembers(const std::vector<int>& mod_ids)
 {
   std::vector<int> uninstall_targets;
@@ -1080,7 +1232,7 @@ void ModdedApplication::addManualTag(const std::string& tag_name)
     throw std::runtime_error(
       std::format("Error: A tag with the name '{}' already exists.", tag_name));
   manual_tags_.emplace_back(tag_name);
-  updateSettings(true);
+  updateSettings(true, tag_settings);
 }
 
 void ModdedApplication::removeManualTag(const std::string& tag_name, bool update_map)
@@ -1090,7 +1242,7 @@ void ModdedApplication::removeManualTag(const std::string& tag_name, bool update
     manual_tags_.erase(iter);
   if(update_map)
     updateManualTagMap();
-  updateSettings(true);
+  updateSettings(true, tag_settings);
 }
 
 void ModdedApplication::changeManualTagName(const std::string& old_name,
@@ -1109,7 +1261,7 @@ void ModdedApplication::changeManualTagName(const std::string& old_name,
   old_iter->setName(new_name);
   if(update_map)
     updateManualTagMap();
-  updateSettings(true);
+  updateSettings(true, tag_settings);
 }
 
 void ModdedApplication::addTagsToMods(const std::vector<std::string>& tag_names,
@@ -1124,7 +1276,7 @@ void ModdedApplication::addTagsToMods(const std::vector<std::string>& tag_names,
       tag->addMod(mod);
   }
   updateManualTagMap();
-  updateSettings(true);
+  updateSettings(true, tag_settings);
 }
 
 void ModdedApplication::removeTagsFromMods(const std::vector<std::string>& tag_names,
@@ -1139,7 +1291,7 @@ void ModdedApplication::removeTagsFromMods(const std::vector<std::string>& tag_n
       tag->removeMod(mod);
   }
   updateManualTagMap();
-  updateSettings(true);
+  updateSettings(true, tag_settings);
 }
 
 void ModdedApplication::setTagsForMods(const std::vector<std::string>& tag_names,
@@ -1159,7 +1311,7 @@ void ModdedApplication::setTagsForMods(const std::vector<std::string>& tag_names
     }
   }
   updateManualTagMap();
-  updateSettings(true);
+  updateSettings(true, tag_settings);
 }
 
 void ModdedApplication::editManualTags(const std::vector<EditManualTagAction>& actions)
@@ -1183,7 +1335,7 @@ void ModdedApplication::editManualTags(const std::vector<EditManualTagAction>& a
     throw e;
   }
   updateManualTagMap();
-  updateSettings(true);
+  updateSettings(true, tag_settings);
 }
 
 void ModdedApplication::addAutoTag(const std::string& tag_name,
@@ -1196,13 +1348,12 @@ void ModdedApplication::addAutoTag(const std::string& tag_name,
       std::format("Error: A tag with the name '{}' already exists.", tag_name));
 
   auto_tags_.emplace_back(tag_name, expression, conditions);
-  auto select_id = [](const auto& mod) { return mod.id; };
   if(expression != "")
-    auto_tags_.back().reapplyMods(staging_dir_, str::transform_view(installed_mods_, select_id));
+    applyAutoTags({ &auto_tags_.back() }, getInstalledModIds(), true);
   if(update)
   {
     updateAutoTagMap();
-    updateSettings(true);
+    updateSettings(true, tag_settings);
   }
 }
 
@@ -1214,13 +1365,12 @@ void ModdedApplication::addAutoTag(const Json::Value& json_tag, bool update)
       std::format("Error: A tag with the name '{}' already exists.", json_tag["name"].asString()));
 
   auto_tags_.emplace_back(json_tag);
-  auto select_id = [](const auto& mod) { return mod.id; };
   if(json_tag["expression"].asString() != "")
-    auto_tags_.back().reapplyMods(staging_dir_, str::transform_view(installed_mods_, select_id));
+    applyAutoTags({ &auto_tags_.back() }, getInstalledModIds(), true);
   if(update)
   {
     updateAutoTagMap();
-    updateSettings(true);
+    updateSettings(true, tag_settings);
   }
 }
 
@@ -1233,7 +1383,7 @@ void ModdedApplication::removeAutoTag(const std::string& tag_name, bool update)
   if(update)
   {
     updateAutoTagMap();
-    updateSettings(true);
+    updateSettings(true, tag_settings);
   }
 }
 
@@ -1254,7 +1404,7 @@ void ModdedApplication::renameAutoTag(const std::string& old_name,
   if(update)
   {
     updateAutoTagMap();
-    updateSettings(true);
+    updateSettings(true, tag_settings);
   }
 }
 
@@ -1268,12 +1418,11 @@ void ModdedApplication::changeAutoTagEvaluator(const std::string& tag_name,
     return;
 
   iter->setEvaluator(expression, conditions);
-  auto select_id = [](const auto& mod) { return mod.id; };
   if(update)
   {
-    iter->reapplyMods(staging_dir_, str::transform_view(installed_mods_, select_id));
+    applyAutoTags({ &(*iter) }, getInstalledModIds(), true);
     updateAutoTagMap();
-    updateSettings(true);
+    updateSettings(true, tag_settings);
   }
 }
 
@@ -1301,29 +1450,15 @@ void ModdedApplication::editAutoTags(const std::vector<EditAutoTagAction>& actio
     if(!reapply_targets.empty())
     {
       log_(Log::LOG_INFO, "Reapplying auto tags with edited conditions to all mods...");
-      ProgressNode node(progress_callback_);
-      node.addChildren({ 1.0f, std::min(8.0f, (float)reapply_targets.size()) });
-      node.child(0).setTotalSteps(installed_mods_.size());
-      std::vector<float> weights;
+      ProgressNode node(progress_callback_, {}, stop_token_);
+      std::vector<AutoTag*> tags;
       for(const auto& tag : reapply_targets)
       {
         auto iter = std::find(auto_tags_.begin(), auto_tags_.end(), tag);
         if(iter != auto_tags_.end())
-          weights.push_back(iter->getNumConditions());
-      }
-      node.child(1).addChildren(weights);
-      for(int i = 0; i < weights.size(); i++)
-        node.child(1).child(i).setTotalSteps(installed_mods_.size());
-
-      auto select_id = [](const auto& mod) { return mod.id; };
-      auto mods = str::transform_view(installed_mods_, select_id);
-      const auto files = AutoTag::readModFiles(staging_dir_, mods, &node.child(0));
-      for(int i = 0; i < reapply_targets.size(); i++)
-      {
-        auto iter = std::find(auto_tags_.begin(), auto_tags_.end(), reapply_targets[i]);
-        if(iter != auto_tags_.end())
-          iter->reapplyMods(files, mods, &node.child(1).child(i));
+          tags.push_back(&(*iter));
       }
+      applyAutoTags(tags, getInstalledModIds(), true, &node);
     }
   }
   catch(std::runtime_error& e)
@@ -1332,48 +1467,114 @@ void ModdedApplication::editAutoTags(const std::vector<EditAutoTagAction>& actio
     throw e;
   }
   updateAutoTagMap();
-  updateSettings(true);
+  updateSettings(true, tag_settings);
 }
 
 void ModdedApplication::reapplyAutoTags()
 {
   log_(Log::LOG_INFO, "Reapplying auto tags to all mods...");
-  ProgressNode node(progress_callback_);
-  node.addChildren({ 1.0f, 8.0f });
-  node.child(0).setTotalSteps(installed_mods_.size());
-  std::vector<float> weights;
-  for(auto& tag : auto_tags_)
-    weights.push_back(tag.getNumConditions());
-  node.child(1).addChildren(weights);
-  for(int i = 0; i < weights.size(); i++)
-    node.child(1).child(i).setTotalSteps(installed_mods_.size());
-  auto select_id = [](const auto& mod) { return mod.id; };
-  auto mods = str::transform_view(installed_mods_, select_id);
-  const auto files = AutoTag::readModFiles(staging_dir_, mods, &node.child(0));
-  for(int i = 0; i < auto_tags_.size(); i++)
-    auto_tags_[i].reapplyMods(files, mods, &node.child(1).child(i));
+  ProgressNode node(progress_callback_, {}, stop_token_);
+  applyAutoTags(getAutoTagPointers(), getInstalledModIds(), true, &node);
   updateAutoTagMap();
-  updateSettings(true);
+  updateSettings(true, tag_settings);
 }
 
 void ModdedApplication::updateAutoTags(const std::vector<int> mod_ids)
 {
   log_(Log::LOG_INFO, std::format("Reapplying auto tags to {} mods...", mod_ids.size()));
-  ProgressNode node(progress_callback_);
-  node.addChildren(
-    { 1.0f, std::max(1.0f, 8.0f * (float)mod_ids.size() / (float)installed_mods_.size()) });
-  node.child(0).setTotalSteps(mod_ids.size());
-  std::vector<float> weights;
-  for(auto& tag : auto_tags_)
-    weights.push_back(tag.getNumConditions());
-  node.child(1).addChildren(weights);
-  for(int i = 0; i < weights.size(); i++)
-    node.child(1).child(i).setTotalSteps(mod_ids.size());
-  const auto files = AutoTag::readModFiles(staging_dir_, mod_ids, &node.child(0));
-  for(int i = 0; i < auto_tags_.size(); i++)
-    auto_tags_[i].updateMods(files, mod_ids, &node.child(1).child(i));
+  ProgressNode node(progress_callback_, {}, stop_token_);
+  applyAutoTags(getAutoTagPointers(), mod_ids, false, &node);
   updateAutoTagMap();
-  updateSettings(true);
+  updateSettings(true, tag_settings);
+}
+
+void ModdedApplication::applyAutoTags(const std::vector<AutoTag*>& tags,
+                                      const std::vector<int>& mod_ids,
+                                      bool reapply,
+                                      std::optional<ProgressNode*> progress_node)
+{
+  if(progress_node)
+    (*progress_node)->setTotalSteps(mod_ids.size());
+  const TagEvaluationPlan plan(std::vector<const AutoTag*>(tags.begin(), tags.end()));
+  // for every mod: results for every tag
+  std::vector<std::vector<bool>> results(mod_ids.size());
+  std::vector<std::exception_ptr> errors(mod_ids.size());
+  std::atomic<size_t> next_mod = 0;
+  auto evaluate_mods = [&]()
+  {
+    for(size_t i = next_mod++; i < mod_ids.size(); i = next_mod++)
+    {
+      if(progress_node && (*progress_node)->stopRequested())
+        return;
+      try
+      {
+        const auto manifest = mod_file_catalog_->getManifest(mod_ids[i]);
+        TagEvaluationPlan::ModEvaluation evaluation(plan);
+        for(const auto& entry : manifest->getEntries())
+          evaluation.addFile(entry.path);
+        results[i] = evaluation.getResults();
+      }
+      catch(...)
+      {
+        errors[i] = std::current_exception();
+      }
+      if(progress_node)
+        (*progress_node)->advance();
+    }
+  };
+  const size_t num_threads = std::clamp<size_t>(
+    std::min<size_t>(std::thread::hardware_concurrency(), mod_ids.size()), 1, MAX_AUTO_TAG_THREADS);
+  std::vector<std::jthread> threads;
+  for(size_t i = 1; i < num_threads; i++)
+    threads.emplace_back(evaluate_mods);
+  evaluate_mods();
+  threads.clear();
+  for(const auto& error : errors)
+  {
+    if(error)
+      std::rethrow_exception(error);
+  }
+  // tags are only changed once all mods have been evaluated
+  if(progress_node)
+    (*progress_node)->checkStop();
+
+  const std::unordered_set<int> checked_mods(mod_ids.begin(), mod_ids.end());
+  for(const auto& [tag_index, tag] : str::enumerate_view(tags))
+  {
+    std::vector<int> mods;
+    if(!reapply)
+    {
+      for(int mod_id : tag->getMods())
+      {
+        if(!checked_mods.contains(mod_id))
+          mods.push_back(mod_id);
+      }
+    }
+    for(const auto& [mod_id, mod_results] : str::zip_view(mod_ids, results))
+    {
+      if(mod_results[tag_index])
+        mods.push_back(mod_id);
+    }
+    tag->setMods(mods);
+  }
+}
+
+std::vector<AutoTag*> ModdedApplication::getAutoTagPointers()
+{
+  std::vector<AutoTag*> tags;
+  tags.reserve(auto_tags_.size());
+  for(auto& tag : auto_tags_)
+    tags.push_back(&tag);
+  return tags;
+}
+
+std::vector<int> ModdedApplication::getInstalledModIds() const
+{
+  std::vector<int> mod_ids;
+  mod_ids.reserve(installed_mods_.size());
+  for(const auto& mod : installed_mods_)
+    mod_ids.push_back(mod.id);
+  return mod_ids;
 }
 
 void ModdedApplication::deleteAllData()
@@ -1383,13 +1584,16 @@ void ModdedApplication::deleteAllData()
   for(const auto& mod : installed_mods_)
     sfs::remove_all(staging_dir_ / std::to_string(mod.id));
   sfs::remove(staging_dir_ / CONFIG_FILE_NAME);
+  sfs::remove(staging_dir_ / JOURNAL_FILE_NAME);
+  sfs::remove(staging_dir_ / CACHE_FILE_NAME);
   sfs::remove_all(getDownloadDir());
+  mod_file_catalog_->clear();
 }
 
 void ModdedApplication::setAppVersion(const std::string& app_version)
 {
   app_versions_[current_profile_] = app_version;
-  updateSettings(true);
+  updateSettings(true, profile_settings);
 }
 
 void ModdedApplication::setModSources(int mod_id,
@@ -1402,7 +1606,7 @@ void ModdedApplication::setModSources(int mod_id,
     throw std::runtime_error("Error: Unknown mod id: " + std::to_string(mod_id));
   iter->local_source = local_source;
   iter->remote_source = remote_source;
-  updateSettings(true);
+  updateSettings(true, mod_settings);
 }
 
 nexus::Page ModdedApplication::getNexusPage(int mod_id)
@@ -1448,19 +1652,24 @@ void ModdedApplication::suppressUpdateNotification(const std::vector<int>& mod_i
       iter->suppress_update_time =
         std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
   }
-  updateSettings(true);
+  updateSettings(true, mod_settings);
 }
 
 ExternalChangesInfo ModdedApplication::getExternalChanges(int deployer)
 {
   ExternalChangesInfo info;
-  ProgressNode node(progress_callback_);
+  ProgressNode node(progress_callback_, {}, stop_token_);
   info.file_changes = deployers_[deployer]->getExternallyModifiedFiles({ &node });
   info.deployer_id = deployer;
   info.deployer_name = deployers_[deployer]->getName();
   return info;
 }
 
+DeploymentPlan ModdedApplication::getDeploymentPlan(int deployer) const
+{
+  return deployers_[deployer]->getDeploymentPlan();
+}
+
 void ModdedApplication::keepOrRevertFileModifications(
   int deployer,
   const FileChangeChoices& changes_to_keep) const
@@ -1532,7 +1741,7 @@ void ModdedApplication::exportConfiguration(const std::vector<int>& deployers,
 
 void ModdedApplication::updateIgnoredFiles(int deployer)
 {
-  if(deployers_[deployer]->getType() != DeployerFactory::REVERSEDEPLOYER)
+  if(deployers_[deployer].getType() != DeployerFactory::REVERSEDEPLOYER)
   {
     log_(Log::LOG_DEBUG, "Ignored files can only be updated for ReverseDeployers.");
     return;
@@ -1543,7 +1752,7 @@ void ModdedApplication::updateIgnoredFiles(int deployer)
 
 void ModdedApplication::addModToIgnoreList(int deployer, int mod_id)
 {
-  if(deployers_[deployer]->getType() != DeployerFactory::REVERSEDEPLOYER)
+  if(deployers_[deployer].getType() != DeployerFactory::REVERSEDEPLOYER)
   {
     log_(Log::LOG_DEBUG, "Ignored files can only be updated for ReverseDeployers.");
     return;
@@ -1555,7 +1764,7 @@ void ModdedApplication::addModToIgnoreList(int deployer, int mod_id)
 void ModdedApplication::applyModAction(int deployer, int action, int mod_id)
 {
   deployers_[deployer]->applyModAction(action, mod_id);
-  updateSettings(true);
+  updateSettings(true, deployer_settings);
 }
 
 std::filesystem::path ModdedApplication::getDownloadDir() const
@@ -1571,98 +1780,159 @@ sfs::path ModdedApplication::iconPath() const
 void ModdedApplication::setIconPath(const sfs::path& icon_path)
 {
   icon_path_ = icon_path;
-  updateSettings(true);
+  updateSettings(true, general_settings);
 }
 
-void ModdedApplication::updateSettings(bool write)
+void ModdedApplication::updateSettings(bool write, int sections)
 {
-  json_settings_.clear();
-  json_settings_["name"] = name_;
-  json_settings_["command"] = command_;
-  json_settings_["icon_path"] = icon_path_.string();
-  for(int group = 0; group < groups_.size(); group++)
+  Json::Value settings;
+  if(sections & general_settings)
   {
-    json_settings_["groups"][group]["active_member"] = active_group_members_[group];
-    for(int i = 0; i < groups_[group].size(); i++)
+    settings["name"] = name_;
+    settings["command"] = command_;
+    settings["icon_path"] = icon_path_.string();
+    settings["steam_app_id"] = steam_app_id_;
+  }
+
+  if(sections & group_settings)
+  {
+    for(int group = 0; group < groups_.size(); group++)
     {
-      json_settings_["groups"][group]["members"][i] = groups_[group][i];
+      settings["groups"][group]["active_member"] = active_group_members_[group];
+      for(int i = 0; i < groups_[group].size(); i++)
+      {
+        settings["groups"][group]["members"][i] = groups_[group][i];
+      }
     }
   }
 
-  for(int i = 0; i < profile_names_.size(); i++)
-    json_settings_["profiles"][i]["name"] = profile_names_[i];
+  if(sections & profile_settings)
+  {
+    for(int i = 0; i < profile_names_.size(); i++)
+      settings["profiles"][i]["name"] = profile_names_[i];
 
-  for(int i = 0; i < app_versions_.size(); i++)
-    json_settings_["profiles"][i]["app_version"] = app_versions_[i];
+    for(int i = 0; i < app_versions_.size(); i++)
+      settings["profiles"][i]["app_version"] = app_versions_[i];
+  }
 
-  for(int i = 0; i < installed_mods_.size(); i++)
+  if(sections & mod_settings)
   {
-    json_settings_["installed_mods"][i] = installed_mods_[i].toJson();
-    json_settings_["installed_mods"][i]["installer"] = installer_map_[installed_mods_[i].id];
+    for(int i = 0; i < installed_mods_.size(); i++)
+    {
+      settings["installed_mods"][i] = installed_mods_[i].toJson();
+      settings["installed_mods"][i]["installer"] = installer_map_[installed_mods_[i].id];
+    }
   }
 
-  for(int depl = 0; depl < deployers_.size(); depl++)
+  if(sections & deployer_settings)
   {
-    json_settings_["deployers"][depl]["dest_path"] = deployers_[depl]->getDestPath();
-    if(deployers_[depl]->isAutonomous())
-      json_settings_["deployers"][depl]["source_path"] = deployers_[depl]->sourcePath().string();
-    else
-      json_settings_["deployers"][depl]["source_path"] = staging_dir_.string();
-    json_settings_["deployers"][depl]["name"] = deployers_[depl]->getName();
-    json_settings_["deployers"][depl]["type"] = deployers_[depl]->getType();
-    json_settings_["deployers"][depl]["deploy_mode"] = deployers_[depl]->getDeployMode();
-    json_settings_["deployers"][depl]["enable_unsafe_sorting"] =
-      deployers_[depl]->getEnableUnsafeSorting();
-
-    if(!deployers_[depl]->isAutonomous())
+    for(int depl = 0; depl < deployers_.size(); depl++)
     {
-      for(int prof = 0; prof < profile_names_.size(); prof++)
+      if(!deployers_[depl].isInitialized())
       {
-        deployers_[depl]->setProfile(prof);
-        json_settings_["deployers"][depl]["profiles"][prof]["name"] = profile_names_[prof];
-        auto loadorder = deployers_[depl]->getLoadorder();
-        for(int mod = 0; mod < loadorder.size(); mod++)
-        {
-          json_settings_["deployers"][depl]["profiles"][prof]["loadorder"][mod]["id"] =
-            std::get<0>(loadorder[mod]);
-          json_settings_["deployers"][depl]["profiles"][prof]["loadorder"][mod]["enabled"] =
-            std::get<1>(loadorder[mod]);
-        }
-        auto conflict_groups = deployers_[depl]->getConflictGroups();
-        for(int group = 0; group < conflict_groups.size(); group++)
+        settings["deployers"][depl] = deployers_[depl].getSettings();
+        continue;
+      }
+      settings["deployers"][depl]["dest_path"] = deployers_[depl]->getDestPath();
+      if(deployers_[depl].isAutonomous())
+        settings["deployers"][depl]["source_path"] = deployers_[depl]->sourcePath().string();
+      else
+        settings["deployers"][depl]["source_path"] = staging_dir_.string();
+      settings["deployers"][depl]["name"] = deployers_[depl]->getName();
+      settings["deployers"][depl]["type"] = deployers_[depl].getType();
+      settings["deployers"][depl]["deploy_mode"] = deployers_[depl]->getDeployMode();
+      settings["deployers"][depl]["enable_unsafe_sorting"] =
+        deployers_[depl]->getEnableUnsafeSorting();
+      // allows showing the number of mods before the deployer is constructed
+      if(deployers_[depl].isAutonomous())
+        settings["deployers"][depl]["num_mods"] = deployers_[depl]->getNumMods();
+
+      if(!deployers_[depl].isAutonomous())
+      {
+        for(int prof = 0; prof < profile_names_.size(); prof++)
         {
-          for(int i = 0; i < conflict_groups[group].size(); i++)
-            json_settings_["deployers"][depl]["profiles"][prof]["conflict_groups"][group][i] =
-              conflict_groups[group][i];
+          deployers_[depl]->setProfile(prof);
+          settings["deployers"][depl]["profiles"][prof]["name"] = profile_names_[prof];
+          auto loadorder = deployers_[depl]->getLoadorder();
+          for(int mod = 0; mod < loadorder.size(); mod++)
+          {
+            settings["deployers"][depl]["profiles"][prof]["loadorder"][mod]["id"] =
+              std::get<0>(loadorder[mod]);
+            settings["deployers"][depl]["profiles"][prof]["loadorder"][mod]["enabled"] =
+              std::get<1>(loadorder[mod]);
+          }
+          auto conflict_groups = deployers_[depl]->getConflictGroups();
+          for(int group = 0; group < conflict_groups.size(); group++)
+          {
+            for(int i = 0; i < conflict_groups[group].size(); i++)
+              settings["deployers"][depl]["profiles"][prof]["conflict_groups"][group][i] =
+                conflict_groups[group][i];
+          }
         }
       }
+      deployers_[depl]->setProfile(current_profile_);
     }
-    deployers_[depl]->setProfile(current_profile_);
   }
 
-  for(int tool = 0; tool < tools_.size(); tool++)
-    json_settings_["tools"][tool] = tools_[tool].toJson();
-
-  const auto targets = bak_man_.getTargets();
-  for(int i = 0; i < targets.size(); i++)
-    json_settings_["backup_targets"][i]["path"] = targets[i].path.string();
+  if(sections & tool_settings)
+  {
+    for(int tool = 0; tool < tools_.size(); tool++)
+      settings["tools"][tool] = tools_[tool].toJson();
+  }
 
-  for(int i = 0; i < manual_tags_.size(); i++)
-    json_settings_["manual_tags"][i] = manual_tags_[i].toJson();
+  if(sections & backup_settings)
+  {
+    const auto targets = bak_man_.getTargets();
+    for(int i = 0; i < targets.size(); i++)
+      settings["backup_targets"][i]["path"] = targets[i].path.string();
+  }
 
-  for(int i = 0; i < auto_tags_.size(); i++)
+  if(sections & tag_settings)
   {
-    if(!auto_tags_[i].getExpression().empty())
-      json_settings_["auto_tags"][i] = auto_tags_[i].toJson();
+    for(int i = 0; i < manual_tags_.size(); i++)
+      settings["manual_tags"][i] = manual_tags_[i].toJson();
+
+    for(int i = 0; i < auto_tags_.size(); i++)
+    {
+      if(!auto_tags_[i].getExpression().empty())
+        settings["auto_tags"][i] = auto_tags_[i].toJson();
+    }
   }
 
-  json_settings_["steam_app_id"] = steam_app_id_;
+  SettingsJournal journal(staging_dir_ / JOURNAL_FILE_NAME);
+  const bool use_journal =
+    write && !settings_snapshot_is_stale_ && sfs::exists(staging_dir_ / CONFIG_FILE_NAME);
+  for(const auto& [section, keys] : SETTINGS_SECTION_KEYS)
+  {
+    if(!(sections & section))
+      continue;
+    for(const auto& key : keys)
+    {
+      if(use_journal)
+      {
+        Json::Value path;
+        path.append(key);
+        journal.record(path, std::as_const(json_settings_)[key], std::as_const(settings)[key]);
+      }
+      if(settings.isMember(key))
+        json_settings_[key] = std::move(settings[key]);
+      else
+        json_settings_.removeMember(key);
+    }
+  }
 
-  if(write)
+  if(!write)
+  {
+    settings_snapshot_is_stale_ = true;
+    return;
+  }
+  if(!use_journal ||
+     journal.size() > std::max(MIN_JOURNAL_COMPACTION_SIZE,
+                               sfs::file_size(staging_dir_ / CONFIG_FILE_NAME)))
     writeSettings();
 }
 
-void ModdedApplication::writeSettings() const
+void ModdedApplication::writeSettings()
 {
   sfs::path settings_file_path = staging_dir_ / (CONFIG_FILE_NAME + ".tmp");
   std::ofstream file(settings_file_path, std::fstream::binary);
@@ -1671,17 +1941,33 @@ void ModdedApplication::writeSettings() const
   file << json_settings_;
   file.close();
   sfs::rename(settings_file_path, staging_dir_ / CONFIG_FILE_NAME);
+  SettingsCache::write(
+    staging_dir_ / CACHE_FILE_NAME, json_settings_, staging_dir_ / CONFIG_FILE_NAME);
+  SettingsJournal(staging_dir_ / JOURNAL_FILE_NAME).clear();
+  settings_snapshot_is_stale_ = false;
 }
 
 void ModdedApplication::readSettings()
 {
   json_settings_.clear();
+  SettingsJournal journal(staging_dir_ / JOURNAL_FILE_NAME);
   sfs::path settings_file_path = staging_dir_ / CONFIG_FILE_NAME;
+  if(journal.size() == 0 &&
+     SettingsCache::read(staging_dir_ / CACHE_FILE_NAME, settings_file_path, json_settings_))
+  {
+    settings_snapshot_is_stale_ = false;
+    return;
+  }
   std::ifstream file(settings_file_path, std::fstream::binary);
   if(!file.is_open())
     throw std::runtime_error("Error: Could not read from \"" + settings_file_path.string() + "\".");
   file >> json_settings_;
   file.close();
+  settings_snapshot_is_stale_ = false;
+  if(journal.replay(json_settings_))
+    writeSettings();
+  else
+    SettingsCache::write(staging_dir_ / CACHE_FILE_NAME, json_settings_, settings_file_path);
 }
 
 void ModdedApplication::updateState(bool read)
@@ -1708,6 +1994,8 @@ void ModdedApplication::updateState(bool read)
       return;
     readSettings();
   }
+  else
+    settings_snapshot_is_stale_ = true;
 
   if(!json_settings_.isMember("name"))
     throw ParseError("Name is missing in \"" + (staging_dir_ / CONFIG_FILE_NAME).string() + "\"");
@@ -1773,7 +2061,8 @@ void ModdedApplication::updateState(bool read)
                        (staging_dir_ / CONFIG_FILE_NAME).string() + "\"");
     active_group_members_.push_back(groups[group]["active_member"].asInt());
   }
-  Json::Value deployers = json_settings_["deployers"];
+  const Json::Value& deployers = json_settings_["deployers"];
+  std::vector<std::function<void()>> deployer_initializers;
   for(int depl = 0; depl < deployers.size(); depl++)
   {
     std::vector<std::string> types = DeployerFactory::DEPLOYER_TYPES;
@@ -1788,6 +2077,53 @@ void ModdedApplication::updateState(bool read)
         deployers[depl]["use_copy_deployment"].asBool() ? Deployer::copy : Deployer::hard_link;
     else
       deploy_mode = static_cast<Deployer::DeployMode>(deployers[depl]["deploy_mode"].asInt());
+
+    // constructing autonomous deployers requires disk I/O, so defer it until they are used
+    if(DeployerFactory::AUTONOMOUS_DEPLOYERS.at(type))
+    {
+      Json::Value lazy_settings = deployers[depl];
+      lazy_settings["deploy_mode"] = deploy_mode;
+      deployers_.emplace_back(
+        [type,
+         deploy_mode,
+         settings = deployers[depl],
+         num_profiles = profile_names_.size(),
+         profile = current_profile_,
+         mod_file_catalog = mod_file_catalog_]()
+        {
+          auto deployer =
+            DeployerFactory::makeDeployer(type,
+                                          sfs::path(settings["source_path"].asString()),
+                                          sfs::path(settings["dest_path"].asString()),
+                                          settings["name"].asString(),
+                                          deploy_mode);
+          if(settings.isMember("enable_unsafe_sorting"))
+            deployer->setEnableUnsafeSorting(settings["enable_unsafe_sorting"].asBool());
+          deployer->setModFileCatalog(mod_file_catalog);
+          if(type == DeployerFactory::REVERSEDEPLOYER)
+          {
+            if(settings.get("update_profiles", false).asBool())
+            {
+              for(int i = 0; i < num_profiles; i++)
+                deployer->addProfile();
+            }
+            auto rev_depl = static_cast<ReverseDeployer*>(deployer.get());
+            if(rev_depl->getNumProfiles() != num_profiles)
+              throw ParseError(std::format(
+                "Mismatch in profile count for deployer '{}'. {} profiles found, expected {}.",
+                rev_depl->getName(),
+                rev_depl->getNumProfiles(),
+                num_profiles));
+          }
+          deployer->setProfile(profile);
+          return deployer;
+        },
+        lazy_settings);
+      deployers_.back().setLog(log_);
+      deployer_initializers.push_back(deployers_.back().getInitializer());
+      continue;
+    }
+
     deployers_.push_back(
       DeployerFactory::makeDeployer(type,
                                     sfs::path(deployers[depl]["source_path"].asString()),
@@ -1796,54 +2132,36 @@ void ModdedApplication::updateState(bool read)
                                     deploy_mode));
     if(deployers[depl].isMember("enable_unsafe_sorting"))
       deployers_.back()->setEnableUnsafeSorting(deployers[depl]["enable_unsafe_sorting"].asBool());
+    deployers_.back()->setModFileCatalog(mod_file_catalog_);
+    deployers_.back()->setLog(log_);
 
-    if(!deployers_[depl]->isAutonomous())
+    for(int prof = 0; prof < profile_names_.size(); prof++)
     {
-      for(int prof = 0; prof < profile_names_.size(); prof++)
+      deployers_[depl]->addProfile();
+      deployers_[depl]->setProfile(prof);
+      const Json::Value& loadorder = deployers[depl]["profiles"][prof]["loadorder"];
+      for(int mod = 0; mod < loadorder.size(); mod++)
       {
-        deployers_[depl]->addProfile();
-        deployers_[depl]->setProfile(prof);
-        Json::Value loadorder = deployers[depl]["profiles"][prof]["loadorder"];
-        for(int mod = 0; mod < loadorder.size(); mod++)
-        {
-          int mod_id = loadorder[mod]["id"].asInt();
-          if(std::find_if(installed_mods_.begin(),
-                          installed_mods_.end(),
-                          [mod_id](const Mod& m)
-                          { return m.id == mod_id; }) == installed_mods_.end())
-            throw ParseError("Unknown mod id in deployers: " + std::to_string(mod_id) + " in \"" +
-                             (staging_dir_ / CONFIG_FILE_NAME).string() + "\"");
-          if(!group_map_.contains(mod_id) || active_group_members_[group_map_[mod_id]] == mod_id &&
-                                               !(deployers_[depl]->isAutonomous()))
-            deployers_[depl]->addMod(mod_id, loadorder[mod]["enabled"].asBool(), false);
-        }
-        Json::Value conflict_groups_json = deployers[depl]["profiles"][prof]["conflict_groups"];
-        std::vector<std::vector<int>> conflict_groups;
-        for(int group = 0; group < conflict_groups_json.size(); group++)
-        {
-          std::vector<int> new_group;
-          for(int mod = 0; mod < conflict_groups_json[group].size(); mod++)
-            new_group.push_back(conflict_groups_json[group][mod].asInt());
-          conflict_groups.push_back(std::move(new_group));
-        }
-        deployers_[depl]->setConflictGroups(conflict_groups);
+        int mod_id = loadorder[mod]["id"].asInt();
+        if(std::find_if(installed_mods_.begin(),
+                        installed_mods_.end(),
+                        [mod_id](const Mod& m) { return m.id == mod_id; }) == installed_mods_.end())
+          throw ParseError("Unknown mod id in deployers: " + std::to_string(mod_id) + " in \"" +
+                           (staging_dir_ / CONFIG_FILE_NAME).string() + "\"");
+        if(!group_map_.contains(mod_id) || active_group_members_[group_map_[mod_id]] == mod_id)
+          deployers_[depl]->addMod(mod_id, loadorder[mod]["enabled"].asBool(), false);
       }
-    }
-    if(type == DeployerFactory::REVERSEDEPLOYER)
-    {
-      if(deployers[depl].get("update_profiles", false).asBool())
+      const Json::Value& conflict_groups_json =
+        deployers[depl]["profiles"][prof]["conflict_groups"];
+      std::vector<std::vector<int>> conflict_groups;
+      for(int group = 0; group < conflict_groups_json.size(); group++)
       {
-        json_settings_["deployers"][depl]["update_profiles"] = false;
-        for(int i = 0; i < profile_names_.size(); i++)
-          deployers_[depl]->addProfile();
+        std::vector<int> new_group;
+        for(int mod = 0; mod < conflict_groups_json[group].size(); mod++)
+          new_group.push_back(conflict_groups_json[group][mod].asInt());
+        conflict_groups.push_back(std::move(new_group));
       }
-      auto rev_depl = static_cast<ReverseDeployer*>(deployers_[depl].get());
-      if(rev_depl->getNumProfiles() != profile_names_.size())
-        throw ParseError(std::format(
-          "Mismatch in profile count for deployer '{}'. {} profiles found, expected {}.",
-          rev_depl->getName(),
-          rev_depl->getNumProfiles(),
-          profile_names_.size()));
+      deployers_[depl]->setConflictGroups(conflict_groups);
     }
     deployers_[depl]->setProfile(current_profile_);
   }
@@ -1894,6 +2212,18 @@ void ModdedApplication::updateState(bool read)
     updateSteamAppId();
 
   updateSteamIconPath();
+
+  if(!deployer_initializers.empty())
+    deployer_init_thread_ = std::jthread(
+      [deployer_initializers](std::stop_token stop_token)
+      {
+        for(const auto& initialize : deployer_initializers)
+        {
+          if(stop_token.stop_requested())
+            return;
+          initialize();
+        }
+      });
 }
 
 std::string ModdedApplication::getModName(int mod_id) const
@@ -1911,7 +2241,7 @@ void ModdedApplication::updateDeployerGroups(std::optional<ProgressNode*> progre
   for(int depl = 0; depl < deployers_.size(); depl++)
   {
     update_targets.push_back({});
-    if(deployers_[depl]->isAutonomous())
+    if(deployers_[depl].isAutonomous())
       continue;
     for(int profile = 0; profile < profile_names_.size(); profile++)
     {
@@ -1965,13 +2295,13 @@ void ModdedApplication::updateDeployerGroups(std::optional<ProgressNode*> progre
 
 void ModdedApplication::splitMod(int mod_id, int deployer)
 {
-  if(deployers_[deployer]->isAutonomous())
+  if(deployers_[deployer].isAutonomous())
     return;
 
   std::map<int, sfs::path> managed_sub_dirs;
   for(int i = 0; i < deployers_.size(); i++)
   {
-    if(i == deployer || deployers_[i]->isAutonomous())
+    if(i == deployer || deployers_[i].isAutonomous())
       continue;
     auto cur_depl_path = deployers_[i]->getDestPath();
     if(!cur_depl_path.ends_with("/"))
@@ -1991,12 +2321,14 @@ void ModdedApplication::splitMod(int mod_id, int deployer)
   if(managed_sub_dirs.empty())
     return;
 
+  const bool is_case_invariant =
+    deployers_[deployer].getType() == DeployerFactory::CASEMATCHINGDEPLOYER;
+  CaseFoldedDirectoryIndex mod_files(staging_dir_ / std::to_string(mod_id));
   for(const auto& [depl, dir] : managed_sub_dirs)
   {
-    const auto mod_dir_optional =
-      pu::pathExists(dir,
-                     staging_dir_ / std::to_string(mod_id),
-                     deployers_[deployer]->getType() == DeployerFactory::CASEMATCHINGDEPLOYER);
+    const auto mod_dir_optional = is_case_invariant
+                                    ? mod_files.resolve(dir)
+                                    : pu::pathExists(dir, mod_files.getRootPath(), false);
     if(!mod_dir_optional)
       continue;
     const auto mod_dir = staging_dir_ / std::to_string(mod_id) / mod_dir_optional->string();
@@ -2029,6 +2361,10 @@ void ModdedApplication::splitMod(int mod_id, int deployer)
         deployers_[depl]->getName()));
     installMod(info);
     sfs::remove_all(mod_dir);
+    mod_files.refresh();
+    mod_file_catalog_->invalidate(mod_id);
+    for(auto& deployer : deployers_)
+      deployer->invalidateModFiles(mod_id);
   }
 }
 
@@ -2064,6 +2400,9 @@ void ModdedApplication::replaceMod(const ImportModInfo& info)
   const sfs::path old_mod_path = staging_dir_ / std::to_string(info.target_group_id);
   sfs::remove_all(old_mod_path);
   sfs::rename(tmp_replace_dir, old_mod_path);
+  mod_file_catalog_->invalidate(info.target_group_id);
+  for(auto& deployer : deployers_)
+    deployer->invalidateModFiles(info.target_group_id);
 
   index->name = info.name;
   index->version = info.version;
@@ -2087,7 +2426,7 @@ void ModdedApplication::replaceMod(const ImportModInfo& info)
       weights_mods.push_back(deployers_[depl]->getNumMods());
     else
       weights_mods.push_back(0);
-    if(deployers_[depl]->isAutonomous())
+    if(deployers_[depl].isAutonomous())
       continue;
     for(int prof = 0; prof < profile_names_.size(); prof++)
     {
@@ -2106,7 +2445,7 @@ void ModdedApplication::replaceMod(const ImportModInfo& info)
     deployers_[depl]->setProfile(current_profile_);
   }
 
-  ProgressNode node(progress_callback_, { 10.0f, 6.0f });
+  ProgressNode node(progress_callback_, { 10.0f, 6.0f }, stop_token_);
   node.child(0).addChildren(weights_mods);
   node.child(1).addChildren(weights_profiles);
   int i = 0;
@@ -2122,8 +2461,7 @@ void ModdedApplication::replaceMod(const ImportModInfo& info)
     deployers_[depl]->setProfile(current_profile_);
   }
 
-  for(auto& tag : auto_tags_)
-    tag.updateMods(staging_dir_, std::vector<int>{ info.target_group_id });
+  applyAutoTags(getAutoTagPointers(), { info.target_group_id }, false);
   updateAutoTagMap();
 
   updateSettings(true);
@@ -2164,7 +2502,7 @@ void ModdedApplication::performUpdateCheck(const std::vector<int>& target_mod_in
        std::format("Checking for updates for {} mod{}...",
                    target_mod_indices.size(),
                    target_mod_indices.size() > 1 ? "s" : ""));
-  ProgressNode node(progress_callback_);
+  ProgressNode node(progress_callback_, {}, stop_token_);
   node.setTotalSteps(target_mod_indices.size());
   int num_available_updates = 0;
   for(int i : target_mod_indices)
@@ -2182,7 +2520,7 @@ void ModdedApplication::performUpdateCheck(const std::vector<int>& target_mod_in
                      num_available_updates == 1 ? "" : "s"));
   else
     log_(Log::LOG_INFO, "No mod updates found.");
-  updateSettings(true);
+  updateSettings(true, mod_settings);
 }
 
 std::string ModdedApplication::generalizeSteamPath(const std::string& path)
@@ -2223,7 +2561,7 @@ void ModdedApplication::updateSteamIconPath()
     if(std::regex_match(file_name, name_regex))
     {
       icon_path_ = steam_path / file_name;
-      updateSettings(true);
+      updateSettings(true, general_settings);
       return;
     }
   }
@@ -15,14 +15,18 @@
 #include "editmanualtagaction.h"
 #include "editprofileinfo.h"
 #include "externalchangesinfo.h"
+#include "lazydeployer.h"
 #include "log.h"
 #include "manualtag.h"
+#include "modfilecatalog.h"
 #include "modinfo.h"
 #include "nexus/api.h"
 #include "tool.h"
 #include <filesystem>
 #include <json/json.h>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 
@@ -74,6 +78,16 @@ public:
    * \param info Contains all data needed to install the mod.
    */
   void installMod(const ImportModInfo& info);
+  /*!
+   * \brief Installs all given mods. Archives are extracted in parallel, after which all
+   * successfully installed mods are added at once. Conflict groups, auto tags and settings
+   * are only updated once for the entire batch. Mods which replace existing mods are
+   * installed one after another before all other mods.
+   * If a mod could not be installed, its files are removed and the first error is rethrown
+   * after all other mods have been added.
+   * \param infos Contains all data needed to install the mods.
+   */
+  void installMods(const std::vector<ImportModInfo>& infos);
   /*!
    * \brief Uninstalls the given mods, this includes deleting all installed files.
    * \param mod_id Ids of the mods to be uninstalled.
@@ -454,6 +468,13 @@ public:
    * \param progress_callback The function.
    */
   void setProgressCallback(const std::function<void(float)>& progress_callback);
+  /*!
+   * \brief Sets the stop token passed to the progress nodes of all following operations.
+   * Long running operations stop at the next point where this leaves a consistent state
+   * and throw a CancellationError once cancellation is requested.
+   * \param stop_token The stop token.
+   */
+  void setStopToken(std::stop_token stop_token);
   /*!
    * \brief Uninstalls all mods which are inactive group members of any group which contains
    * any of the given mods.
@@ -603,6 +624,13 @@ public:
    * \return Contains data about overwritten files.
    */
   ExternalChangesInfo getExternalChanges(int deployer);
+  /*!
+   * \brief Determines which files would be changed by deploying the given deployer,
+   * without actually deploying.
+   * \param deployer Deployer to check.
+   * \return The deployment plan.
+   */
+  DeploymentPlan getDeploymentPlan(int deployer) const;
   /*!
    * \brief Currently only supports hard link deployment.
    * For every given file: Moves the modified file into the source mods directory and links
@@ -651,6 +679,50 @@ public:
 private:
   /*! \brief The subdirectory used to store downloads. */
   static inline constexpr std::string DOWNLOAD_DIR = "_download";
+  /*! \brief Maximum number of threads used to evaluate auto tags. */
+  static constexpr size_t MAX_AUTO_TAG_THREADS = 16;
+  /*! \brief Maximum number of mods installed at the same time. */
+  static constexpr size_t MAX_INSTALL_THREADS = 8;
+  /*! \brief Name of the file used to journal changes made since CONFIG_FILE_NAME was written. */
+  inline static const std::string JOURNAL_FILE_NAME = "." + CONFIG_FILE_NAME + ".journal";
+  /*! \brief Name of the file containing a binary copy of CONFIG_FILE_NAME. */
+  inline static const std::string CACHE_FILE_NAME = "." + CONFIG_FILE_NAME + ".cache";
+  /*! \brief Journals smaller than this are never compacted, regardless of the snapshot size. */
+  static constexpr uintmax_t MIN_JOURNAL_COMPACTION_SIZE = 1 << 20;
+
+  /*! \brief Sections of json_settings_ which can be updated independently. */
+  enum SettingsSection
+  {
+    /*! \brief Name, command, icon path and Steam app id. */
+    general_settings = 1 << 0,
+    /*! \brief Profile names and app versions. */
+    profile_settings = 1 << 1,
+    /*! \brief Mod groups and their active members. */
+    group_settings = 1 << 2,
+    /*! \brief Installed mods. */
+    mod_settings = 1 << 3,
+    /*! \brief Deployers including their load orders and conflict groups. */
+    deployer_settings = 1 << 4,
+    /*! \brief Tools. */
+    tool_settings = 1 << 5,
+    /*! \brief Backup targets. */
+    backup_settings = 1 << 6,
+    /*! \brief Manual and auto tags. */
+    tag_settings = 1 << 7,
+    /*! \brief Every section. */
+    all_settings = (1 << 8) - 1
+  };
+  /*! \brief Maps every section to the keys of its values in json_settings_. */
+  inline static const std::map<SettingsSection, std::vector<std::string>> SETTINGS_SECTION_KEYS = {
+    { general_settings, { "name", "command", "icon_path", "steam_app_id" } },
+    { profile_settings, { "profiles" } },
+    { group_settings, { "groups" } },
+    { mod_settings, { "installed_mods" } },
+    { deployer_settings, { "deployers" } },
+    { tool_settings, { "tools" } },
+    { backup_settings, { "backup_targets" } },
+    { tag_settings, { "manual_tags", "auto_tags" } }
+  };
 
   /*! \brief The name of this application. */
   std::string name_;
@@ -660,8 +732,11 @@ private:
   std::filesystem::path staging_dir_;
   /*! \brief Contains all currently installed mods. */
   std::vector<Mod> installed_mods_;
-  /*! \brief Contains every Deployer used by this application. */
-  std::vector<std::unique_ptr<Deployer>> deployers_;
+  /*!
+   * \brief Contains every Deployer used by this application. Autonomous deployers loaded from
+   * json_settings_ are only constructed once they are accessed.
+   */
+  std::vector<LazyDeployer> deployers_;
   /*! \brief Contains all tools for this application. */
   std::vector<Tool> tools_;
   /*! \brief The command used to run this application. */
@@ -680,12 +755,17 @@ private:
   std::map<int, std::string> installer_map_;
   /*! \brief Path to this applications icon. */
   std::filesystem::path icon_path_;
+  /*! \brief Caches the file listings of all installed mods. Shared with all deployers. */
+  std::shared_ptr<ModFileCatalog> mod_file_catalog_;
   /*! \brief Callback for logging. */
   std::function<void(Log::LogLevel, const std::string&)> log_ = [](Log::LogLevel a,
                                                                    const std::string& b) {};
   /*! \brief Manages all backups for this application. */
   BackupManager bak_man_;
-  /*! \brief Id of the most recently installed mod. */
+  /*!
+   * \brief Id of the mod removed by cleanupFailedInstallation. Only set while a single
+   * mod is being installed.
+   */
   int last_mod_id_ = -1;
   /*! \brief Contains all known manually managed tags. */
   std::vector<ManualTag> manual_tags_;
@@ -704,22 +784,39 @@ private:
   std::vector<std::string> app_versions_;
   /*! \brief Callback used to inform about the current task's progress. */
   std::function<void(float)> progress_callback_ = [](float f) {};
+  /*! \brief Passed to the progress nodes of all operations to allow cancellation. */
+  std::stop_token stop_token_;
   /*! \brief File name used to store exported deployers and auto tags. */
   std::string export_file_name = "exported_config";
   /*! \brief Steam app id. Or -1 if not a Steam app. */
   long steam_app_id_;
+  /*!
+   * \brief If true: json_settings_ has been changed without journaling the change,
+   * so the next write has to replace CONFIG_FILE_NAME.
+   */
+  bool settings_snapshot_is_stale_ = true;
+  /*! \brief Constructs all lazily loaded deployers in the background. */
+  std::jthread deployer_init_thread_;
 
   /*!
-   * \brief Updates json_settings_ with the current state of this object.
-   * \param write If true: write json_settings_ to a file after updating.
+   * \brief Updates the given sections of json_settings_ with the current state of this object.
+   *
+   * When writing, changes are appended to the journal at staging_dir_/JOURNAL_FILE_NAME.
+   * Once the journal grows larger than the settings file, both are compacted into a new
+   * settings file.
+   * \param write If true: write changes in json_settings_ to disk after updating.
+   * \param sections Bitwise or of all \ref SettingsSection "sections" which have changed.
    */
-  void updateSettings(bool write = false);
+  void updateSettings(bool write = false, int sections = all_settings);
   /*!
-   * \brief Writes json_settings_ to a file at app_mod_dir_/CONFIG_FILE_NAME.
+   * \brief Writes json_settings_ to a file at app_mod_dir_/CONFIG_FILE_NAME, updates the
+   * binary cache and deletes the journal.
    */
-  void writeSettings() const;
+  void writeSettings();
   /*!
-   * \brief Reads json_settings_ from a file at app_mod_dir_/CONFIG_FILE_NAME.
+   * \brief Reads json_settings_ from a file at app_mod_dir_/CONFIG_FILE_NAME, then applies
+   * all changes stored in the journal. If no changes have been journaled and the binary cache
+   * at app_mod_dir_/CACHE_FILE_NAME is up to date, it is read instead.
    */
   void readSettings();
   /*!
@@ -759,6 +856,29 @@ private:
   void updateManualTagMap();
   /*! \brief Updates auto_tag_map_ with the information contained in auto_tags_. */
   void updateAutoTagMap();
+  /*!
+   * \brief Evaluates the given auto tags for all given mods at once and updates which
+   * mods have those tags. Mods are evaluated in parallel, each one using only the file list
+   * from its manifest.
+   * \param tags Tags to evaluate.
+   * \param mod_ids Mods to check.
+   * \param reapply If true: Remove the tags from all mods not in mod_ids.
+   * \param progress_node Used to inform about progress.
+   */
+  void applyAutoTags(const std::vector<AutoTag*>& tags,
+                     const std::vector<int>& mod_ids,
+                     bool reapply,
+                     std::optional<ProgressNode*> progress_node = {});
+  /*!
+   * \brief Returns pointers to all auto tags.
+   * \return The pointers.
+   */
+  std::vector<AutoTag*> getAutoTagPointers();
+  /*!
+   * \brief Returns the ids of all installed mods.
+   * \return The ids.
+   */
+  std::vector<int> getInstalledModIds() const;
   /*!
    * \brief Checks for available updates for mods with the given index in installed_mods_.
    * \param target_mod_indices Target mod indices.
@@ -0,0 +1,59 @@
+#include "modfilecatalog.h"
+
+namespace sfs = std::filesystem;
+
+
+ModFileCatalog::ModFileCatalog(const sfs::path& staging_dir) : staging_dir_(staging_dir) {}
+
+std::shared_ptr<const ModFileManifest> ModFileCatalog::getManifest(int mod_id, bool persist)
+{
+  const sfs::path mod_path = staging_dir_ / std::to_string(mod_id);
+  std::shared_ptr<const ModFileManifest> manifest;
+  {
+    std::lock_guard lock(mutex_);
+    auto iter = manifests_.find(mod_id);
+    if(iter != manifests_.end())
+      manifest = iter->second;
+  }
+  // validation and scanning happen without holding the lock, so that different mods can be
+  // read in parallel
+  if(manifest && manifest->isValid(mod_path))
+    return manifest;
+  manifest = std::make_shared<const ModFileManifest>(ModFileManifest::get(mod_path, persist));
+  if(!persist)
+    return manifest;
+  std::lock_guard lock(mutex_);
+  manifests_[mod_id] = manifest;
+  return manifest;
+}
+
+std::vector<std::string> ModFileCatalog::getModFiles(int mod_id, bool include_directories)
+{
+  const auto manifest = getManifest(mod_id);
+  std::vector<std::string> files;
+  files.reserve(manifest->getEntries().size());
+  for(const auto& entry : manifest->getEntries())
+  {
+    if(!entry.is_directory || include_directories)
+      files.push_back(entry.path);
+  }
+  return files;
+}
+
+void ModFileCatalog::invalidate(int mod_id)
+{
+  std::lock_guard lock(mutex_);
+  manifests_.erase(mod_id);
+  ModFileManifest::invalidate(staging_dir_ / std::to_string(mod_id));
+}
+
+void ModFileCatalog::clear()
+{
+  std::lock_guard lock(mutex_);
+  manifests_.clear();
+}
+
+sfs::path ModFileCatalog::getStagingDir() const
+{
+  return staging_dir_;
+}
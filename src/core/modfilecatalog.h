@@ -0,0 +1,70 @@
+/*!
+ * \file modfilecatalog.h
+ * \brief Header for the ModFileCatalog class.
+ */
+
+#pragma once
+
+#include "modfilemanifest.h"
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+/*!
+ * \brief Caches the file listings of all mods in one staging directory.
+ * Listings are kept in memory and persisted as ModFileManifest objects, so every subsystem
+ * working on the same staging directory can share them. A cached listing is checked against
+ * the modification times of its directories before it is returned, which detects files being
+ * added, removed or renamed without walking the mod. Files edited in place are not detected.
+ * All member functions are thread safe.
+ */
+class ModFileCatalog
+{
+public:
+  /*!
+   * \brief Constructor.
+   * \param staging_dir Directory containing all mod directories.
+   */
+  ModFileCatalog(const std::filesystem::path& staging_dir);
+
+  /*!
+   * \brief Returns the file listing of the given mod. The listing is loaded from memory or
+   * disk if it is still valid, otherwise the mod directory is scanned.
+   * \param mod_id Target mod.
+   * \param persist If false: A newly scanned listing is neither cached nor written to disk.
+   * \return The listing.
+   */
+  std::shared_ptr<const ModFileManifest> getManifest(int mod_id, bool persist = true);
+  /*!
+   * \brief Returns the paths of all files of the given mod.
+   * \param mod_id Target mod.
+   * \param include_directories If true: Also include paths to directories.
+   * \return The paths, relative to the mods root directory.
+   */
+  std::vector<std::string> getModFiles(int mod_id, bool include_directories = false);
+  /*!
+   * \brief Discards the cached listing of the given mod, both in memory and on disk.
+   * This must be called whenever the contents of a mod directory are changed.
+   * \param mod_id Target mod.
+   */
+  void invalidate(int mod_id);
+  /*! \brief Discards all listings cached in memory. */
+  void clear();
+  /*!
+   * \brief Getter for the staging directory.
+   * \return The path.
+   */
+  std::filesystem::path getStagingDir() const;
+
+private:
+  /*! \brief Directory containing all mod directories. */
+  std::filesystem::path staging_dir_;
+  /*! \brief Maps mod ids to their cached listings. */
+  std::unordered_map<int, std::shared_ptr<const ModFileManifest>> manifests_;
+  /*! \brief Protects manifests_. */
+  mutable std::mutex mutex_;
+};
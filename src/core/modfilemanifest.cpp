@@ -0,0 +1,166 @@
+#include "modfilemanifest.h"
+#include "pathutils.h"
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <sys/stat.h>
+
+namespace sfs = std::filesystem;
+namespace pu = path_utils;
+
+
+ModFileManifest::ModFileManifest(const sfs::path& mod_path)
+{
+  scan_time_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::system_clock::now().time_since_epoch())
+                 .count();
+  root_mtime_ = getModificationTime(mod_path);
+  for(const auto& dir_entry : sfs::recursive_directory_iterator(mod_path))
+  {
+    struct stat file_stat;
+    if(stat(dir_entry.path().c_str(), &file_stat) != 0)
+      continue;
+    const bool is_directory = S_ISDIR(file_stat.st_mode);
+    if(!is_directory && !S_ISREG(file_stat.st_mode))
+      continue;
+    const uint64_t size = is_directory ? 0 : file_stat.st_size;
+    const int64_t mtime = file_stat.st_mtim.tv_sec * 1000000000ll + file_stat.st_mtim.tv_nsec;
+    entries_.push_back({ pu::getRelativePath(dir_entry.path(), mod_path),
+                         is_directory,
+                         size,
+                         mtime,
+                         static_cast<uint64_t>(file_stat.st_ino) });
+    mod_size_ += size;
+  }
+}
+
+ModFileManifest::ModFileManifest(const Json::Value& json_value)
+{
+  if(json_value["version"].asInt() != MANIFEST_VERSION)
+    throw std::runtime_error("Unsupported manifest version.");
+  root_mtime_ = json_value["root_mtime"].asInt64();
+  scan_time_ = json_value["scan_time"].asInt64();
+  const Json::Value& files = json_value["files"];
+  entries_.reserve(files.size());
+  for(int i = 0; i < files.size(); i++)
+  {
+    entries_.push_back({ files[i][0].asString(),
+                         files[i][1].asBool(),
+                         files[i][2].asUInt64(),
+                         files[i][3].asInt64(),
+                         files[i][4].asUInt64() });
+    mod_size_ += entries_.back().size;
+  }
+}
+
+ModFileManifest ModFileManifest::get(const sfs::path& mod_path, bool save)
+{
+  const sfs::path manifest_path = getManifestPath(mod_path);
+  if(sfs::exists(manifest_path))
+  {
+    try
+    {
+      std::ifstream file(manifest_path, std::fstream::binary);
+      Json::Value json_value;
+      file >> json_value;
+      file.close();
+      ModFileManifest manifest(json_value);
+      if(manifest.isValid(mod_path))
+        return manifest;
+    }
+    catch(...)
+    {
+      // invalid manifests are regenerated below
+    }
+  }
+  ModFileManifest manifest(mod_path);
+  if(save)
+    manifest.save(mod_path);
+  return manifest;
+}
+
+void ModFileManifest::invalidate(const sfs::path& mod_path)
+{
+  sfs::remove(getManifestPath(mod_path));
+}
+
+sfs::path ModFileManifest::getManifestPath(const sfs::path& mod_path)
+{
+  return mod_path.parent_path() / MANIFEST_DIR_NAME / (mod_path.filename().string() + ".json");
+}
+
+bool ModFileManifest::isValid(const sfs::path& mod_path) const
+{
+  if(!directoryIsUnchanged(mod_path, root_mtime_))
+    return false;
+  for(const auto& entry : entries_)
+  {
+    if(entry.is_directory && !directoryIsUnchanged(mod_path / entry.path, entry.mtime))
+      return false;
+  }
+  return true;
+}
+
+void ModFileManifest::save(const sfs::path& mod_path) const
+{
+  const sfs::path manifest_path = getManifestPath(mod_path);
+  sfs::create_directories(manifest_path.parent_path());
+  const sfs::path tmp_path = manifest_path.string() + ".tmp";
+  std::ofstream file(tmp_path, std::fstream::binary);
+  if(!file.is_open())
+    throw std::runtime_error("Error: Could not write to \"" + tmp_path.string() + "\".");
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+  writer->write(toJson(), &file);
+  file.close();
+  sfs::rename(tmp_path, manifest_path);
+}
+
+Json::Value ModFileManifest::toJson() const
+{
+  Json::Value json_value;
+  json_value["version"] = MANIFEST_VERSION;
+  json_value["root_mtime"] = static_cast<Json::Int64>(root_mtime_);
+  json_value["scan_time"] = static_cast<Json::Int64>(scan_time_);
+  json_value["files"] = Json::Value(Json::arrayValue);
+  for(const auto& entry : entries_)
+  {
+    Json::Value json_entry(Json::arrayValue);
+    json_entry.append(entry.path);
+    json_entry.append(entry.is_directory);
+    json_entry.append(static_cast<Json::UInt64>(entry.size));
+    json_entry.append(static_cast<Json::Int64>(entry.mtime));
+    json_entry.append(static_cast<Json::UInt64>(entry.inode));
+    json_value["files"].append(json_entry);
+  }
+  return json_value;
+}
+
+const std::vector<ModFileManifest::Entry>& ModFileManifest::getEntries() const
+{
+  return entries_;
+}
+
+unsigned long ModFileManifest::getModSize() const
+{
+  return mod_size_;
+}
+
+int64_t ModFileManifest::getScanTime() const
+{
+  return scan_time_;
+}
+
+int64_t ModFileManifest::getModificationTime(const sfs::path& path)
+{
+  struct stat file_stat;
+  if(stat(path.c_str(), &file_stat) != 0)
+    return -1;
+  return file_stat.st_mtim.tv_sec * 1000000000ll + file_stat.st_mtim.tv_nsec;
+}
+
+bool ModFileManifest::directoryIsUnchanged(const sfs::path& path, int64_t mtime) const
+{
+  return mtime != -1 && mtime + RACY_INTERVAL < scan_time_ && getModificationTime(path) == mtime;
+}
@@ -0,0 +1,147 @@
+/*!
+ * \file modfilemanifest.h
+ * \brief Header for the ModFileManifest class.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <json/json.h>
+#include <string>
+#include <vector>
+
+
+/*!
+ * \brief Stores a listing of all files and directories in one mods installation directory.
+ * Manifests are persisted in a hidden directory next to the mod directories, which allows
+ * deployers to determine a mods files without walking its directory tree. A stored manifest is
+ * considered valid as long as the modification times of all directories it contains match
+ * those on disk.
+ * Editing a file in place does not change the modification time of its directory. The sizes
+ * and modification times stored for such files, and with them the mod size, remain stale until
+ * the manifest is invalidated. Only the set of files in a mod is always up to date.
+ */
+class ModFileManifest
+{
+public:
+  /*! \brief Describes one file or directory in a mod. */
+  struct Entry
+  {
+    /*! \brief Path relative to the mods root directory. */
+    std::string path;
+    /*! \brief True if this entry is a directory. */
+    bool is_directory;
+    /*! \brief File size in bytes. Always 0 for directories. */
+    uint64_t size;
+    /*! \brief Modification time in nanoseconds since epoch. */
+    int64_t mtime;
+    /*! \brief Inode of the file. */
+    uint64_t inode;
+  };
+
+  /*! \brief Name of the directory in which manifests are stored. */
+  static constexpr std::string MANIFEST_DIR_NAME = ".lmm_manifests";
+
+  /*! \brief Default constructor. Creates an empty manifest. */
+  ModFileManifest() = default;
+  /*!
+   * \brief Creates a new manifest by scanning all files in the given mod directory.
+   * \param mod_path Path to the mods installation directory.
+   */
+  ModFileManifest(const std::filesystem::path& mod_path);
+  /*!
+   * \brief Deserializes a manifest from the given json object.
+   * \param json_value Source json object.
+   */
+  ModFileManifest(const Json::Value& json_value);
+
+  /*!
+   * \brief Returns the manifest for the given mod directory. If a stored manifest exists and is
+   * still valid, it is loaded from disk. Otherwise the mod directory is scanned and the new
+   * manifest is stored.
+   * \param mod_path Path to the mods installation directory.
+   * \param save If false: A newly scanned manifest is not stored.
+   * \return The manifest.
+   */
+  static ModFileManifest get(const std::filesystem::path& mod_path, bool save = true);
+  /*!
+   * \brief Deletes the stored manifest for the given mod directory, if it exists. This
+   * must be called whenever the contents of a mod directory are changed.
+   * \param mod_path Path to the mods installation directory.
+   */
+  static void invalidate(const std::filesystem::path& mod_path);
+  /*!
+   * \brief Returns the path to the file in which the manifest for the given mod is stored.
+   * \param mod_path Path to the mods installation directory.
+   * \return The path.
+   */
+  static std::filesystem::path getManifestPath(const std::filesystem::path& mod_path);
+
+  /*!
+   * \brief Checks if all directory modification times stored in this manifest match those
+   * in the given mod directory.
+   * Directories which had been modified shortly before the manifest was created are always
+   * considered to be changed. Files are not checked, so in place edits are not detected.
+   * \param mod_path Path to the mods installation directory.
+   * \return True if the manifest is up to date.
+   */
+  bool isValid(const std::filesystem::path& mod_path) const;
+  /*!
+   * \brief Writes this manifest to the manifest directory of the given mod.
+   * \param mod_path Path to the mods installation directory.
+   */
+  void save(const std::filesystem::path& mod_path) const;
+  /*!
+   * \brief Serializes this object.
+   * \return Json object containing serialized data.
+   */
+  Json::Value toJson() const;
+  /*!
+   * \brief Getter for all entries in this manifest.
+   * \return The entries.
+   */
+  const std::vector<Entry>& getEntries() const;
+  /*!
+   * \brief Returns the total size of all files in this manifest.
+   * \return The size in bytes.
+   */
+  unsigned long getModSize() const;
+  /*!
+   * \brief Returns the time at which the mod directory was scanned.
+   * \return The time in nanoseconds since epoch.
+   */
+  int64_t getScanTime() const;
+
+private:
+  /*! \brief Version of the manifest format. Manifests with a different version are ignored. */
+  static constexpr int MANIFEST_VERSION = 1;
+  /*!
+   * \brief Directories modified less than this many nanoseconds before a scan may still be
+   * changed without affecting their modification time, due to timestamp granularity.
+   */
+  static constexpr int64_t RACY_INTERVAL = 2000000000ll;
+  /*! \brief Modification time of the mods root directory in nanoseconds since epoch. */
+  int64_t root_mtime_ = 0;
+  /*! \brief Time at which the mod directory was scanned in nanoseconds since epoch. */
+  int64_t scan_time_ = 0;
+  /*! \brief All files and directories in the mod. */
+  std::vector<Entry> entries_;
+  /*! \brief Total size of all files in the mod. */
+  unsigned long mod_size_ = 0;
+
+  /*!
+   * \brief Reads the modification time of the given path.
+   * \param path Path to check.
+   * \return The modification time in nanoseconds since epoch or -1 if the path does not exist.
+   */
+  static int64_t getModificationTime(const std::filesystem::path& path);
+  /*!
+   * \brief Checks if the given directory has not been modified since the given time and
+   * was scanned safely.
+   * \param path Directory to check.
+   * \param mtime Modification time stored for that directory.
+   * \return True if the directory is unchanged.
+   */
+  bool directoryIsUnchanged(const std::filesystem::path& path, int64_t mtime) const;
+};
@@ -0,0 +1,91 @@
+#include "multipatternmatcher.h"
+#include <algorithm>
+#include <queue>
+
+
+MultiPatternMatcher::MultiPatternMatcher() : nodes_(1) {}
+
+int MultiPatternMatcher::addPattern(std::string_view pattern)
+{
+  int state = 0;
+  for(const unsigned char c : pattern)
+  {
+    int child = getChild(state, c);
+    if(child == -1)
+    {
+      child = nodes_.size();
+      nodes_.emplace_back();
+      auto& children = nodes_[state].children;
+      children.insert(std::ranges::lower_bound(children, std::pair<unsigned char, int>(c, -1)),
+                      { c, child });
+    }
+    state = child;
+  }
+  if(nodes_[state].pattern_id == -1)
+  {
+    nodes_[state].pattern_id = pattern_lengths_.size();
+    pattern_lengths_.push_back(pattern.size());
+  }
+  return nodes_[state].pattern_id;
+}
+
+void MultiPatternMatcher::compile()
+{
+  // breadth first traversal ensures failure links always point to already processed states
+  std::queue<int> states;
+  for(const auto& [c, child] : nodes_[0].children)
+  {
+    nodes_[child].failure_link = 0;
+    states.push(child);
+  }
+  while(!states.empty())
+  {
+    const int state = states.front();
+    states.pop();
+    for(const auto& [c, child] : nodes_[state].children)
+    {
+      int failure = nodes_[state].failure_link;
+      while(failure != 0 && getChild(failure, c) == -1)
+        failure = nodes_[failure].failure_link;
+      const int failure_child = getChild(failure, c);
+      nodes_[child].failure_link =
+        failure_child != -1 && failure_child != child ? failure_child : 0;
+      const Node& failure_node = nodes_[nodes_[child].failure_link];
+      nodes_[child].output_link = failure_node.pattern_id != -1 ? nodes_[child].failure_link
+                                                                : failure_node.output_link;
+      states.push(child);
+    }
+  }
+}
+
+int MultiPatternMatcher::getNumPatterns() const
+{
+  return pattern_lengths_.size();
+}
+
+int MultiPatternMatcher::getPatternLength(int pattern_id) const
+{
+  return pattern_lengths_[pattern_id];
+}
+
+int MultiPatternMatcher::getChild(int state, unsigned char c) const
+{
+  const auto& children = nodes_[state].children;
+  auto iter = std::ranges::lower_bound(children, std::pair<unsigned char, int>(c, -1));
+  if(iter == children.end() || iter->first != c)
+    return -1;
+  return iter->second;
+}
+
+int MultiPatternMatcher::getNextState(int state, unsigned char c) const
+{
+  while(true)
+  {
+    const int child = getChild(state, c);
+    if(child != -1)
+      return child;
+    if(state == 0)
+      return 0;
+    state = nodes_[state].failure_link;
+  }
+}
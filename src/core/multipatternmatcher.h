@@ -0,0 +1,99 @@
+/*!
+ * \file multipatternmatcher.h
+ * \brief Header for the MultiPatternMatcher class.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+/*!
+ * \brief Finds all occurrences of a set of patterns in a text in a single pass, using the
+ * Aho-Corasick algorithm.
+ */
+class MultiPatternMatcher
+{
+public:
+  /*! \brief Creates a matcher without patterns. */
+  MultiPatternMatcher();
+
+  /*!
+   * \brief Adds the given pattern. Patterns can not be added after \ref compile has been called.
+   * \param pattern Pattern to add. Must not be empty.
+   * \return Id of the pattern. Adding the same pattern multiple times returns the same id.
+   */
+  int addPattern(std::string_view pattern);
+  /*! \brief Prepares the matcher for searching. Must be called after all patterns were added. */
+  void compile();
+  /*!
+   * \brief Returns the number of distinct patterns.
+   * \return The number of patterns.
+   */
+  int getNumPatterns() const;
+  /*!
+   * \brief Returns the length of the pattern with the given id.
+   * \param pattern_id Target pattern.
+   * \return The length.
+   */
+  int getPatternLength(int pattern_id) const;
+  /*!
+   * \brief Calls the given function for every occurrence of every pattern in the given text.
+   * Occurrences are reported in order of their end position.
+   * \param text Text to search.
+   * \param callback Called with the pattern id and the start position of every occurrence.
+   */
+  template<typename Callback>
+  void findAll(std::string_view text, Callback&& callback) const
+  {
+    int state = 0;
+    for(size_t i = 0; i < text.size(); i++)
+    {
+      state = getNextState(state, text[i]);
+      for(int node = nodes_[state].pattern_id != -1 ? state : nodes_[state].output_link;
+          node != -1;
+          node = nodes_[node].output_link)
+      {
+        const int pattern_id = nodes_[node].pattern_id;
+        callback(pattern_id, static_cast<int>(i + 1) - pattern_lengths_[pattern_id]);
+      }
+    }
+  }
+
+private:
+  /*! \brief One state of the automaton, representing a prefix of at least one pattern. */
+  struct Node
+  {
+    /*! \brief Transitions to child states, sorted by character. */
+    std::vector<std::pair<unsigned char, int>> children;
+    /*! \brief State representing the longest proper suffix of this prefix. */
+    int failure_link = 0;
+    /*! \brief Nearest state along the failure links which represents a complete pattern. */
+    int output_link = -1;
+    /*! \brief Id of the pattern ending in this state, or -1. */
+    int pattern_id = -1;
+  };
+
+  /*! \brief All states. The first state is the root. */
+  std::vector<Node> nodes_;
+  /*! \brief Length of every pattern. */
+  std::vector<int> pattern_lengths_;
+
+  /*!
+   * \brief Finds the child of the given state for the given character.
+   * \param state Parent state.
+   * \param c Transition character.
+   * \return The child state or -1 if no such child exists.
+   */
+  int getChild(int state, unsigned char c) const;
+  /*!
+   * \brief Computes the state following the given state for the given character.
+   * \param state Current state.
+   * \param c Next character in the text.
+   * \return The next state.
+   */
+  int getNextState(int state, unsigned char c) const;
+};
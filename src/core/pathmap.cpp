@@ -0,0 +1,224 @@
+#include "pathmap.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace str = std::ranges;
+
+
+PathMap::PathMap(const PathMap& other)
+{
+  *this = other;
+}
+
+PathMap::PathMap(PathMap&& other) noexcept
+{
+  *this = std::move(other);
+}
+
+PathMap& PathMap::operator=(PathMap&& other) noexcept
+{
+  if(this == &other)
+    return *this;
+  entries_ = std::exchange(other.entries_, {});
+  blocks_ = std::exchange(other.blocks_, {});
+  current_block_ = std::exchange(other.current_block_, nullptr);
+  block_used_ = std::exchange(other.block_used_, BLOCK_SIZE);
+  arena_size_ = std::exchange(other.arena_size_, 0);
+  sorted_ = std::exchange(other.sorted_, true);
+  return *this;
+}
+
+PathMap& PathMap::operator=(const PathMap& other)
+{
+  if(this == &other)
+    return *this;
+  entries_ = other.entries_;
+  blocks_.clear();
+  arena_size_ = 0;
+  shareBlocks(other);
+  sorted_ = other.sorted_;
+  return *this;
+}
+
+int PathMap::compare(std::string_view first, std::string_view second)
+{
+  const size_t length = std::min(first.size(), second.size());
+  for(size_t i = 0; i < length; i++)
+  {
+    if(first[i] == second[i])
+      continue;
+    if(first[i] == '/')
+      return -1;
+    if(second[i] == '/')
+      return 1;
+    return static_cast<unsigned char>(first[i]) < static_cast<unsigned char>(second[i]) ? -1 : 1;
+  }
+  if(first.size() == second.size())
+    return 0;
+  return first.size() < second.size() ? -1 : 1;
+}
+
+bool PathMap::less(std::string_view first, std::string_view second)
+{
+  return compare(first, second) < 0;
+}
+
+PathMap PathMap::difference(const PathMap& first, const PathMap& second)
+{
+  first.checkIsSorted();
+  second.checkIsSorted();
+  PathMap result;
+  result.shareBlocks(first);
+  auto second_iter = second.begin();
+  for(const auto& [path, value] : first)
+  {
+    while(second_iter != second.end() && compare(second_iter->first, path) < 0)
+      second_iter++;
+    if(second_iter == second.end() || compare(second_iter->first, path) != 0)
+      result.entries_.emplace_back(path, value);
+  }
+  return result;
+}
+
+PathMap PathMap::intersection(const PathMap& first, const PathMap& second)
+{
+  first.checkIsSorted();
+  second.checkIsSorted();
+  PathMap result;
+  result.shareBlocks(first);
+  auto second_iter = second.begin();
+  for(const auto& [path, value] : first)
+  {
+    while(second_iter != second.end() && compare(second_iter->first, path) < 0)
+      second_iter++;
+    if(second_iter != second.end() && compare(second_iter->first, path) == 0)
+      result.entries_.emplace_back(path, value);
+  }
+  return result;
+}
+
+void PathMap::add(std::string_view path, int value)
+{
+  if(sorted_ && !entries_.empty())
+  {
+    const int comparison = compare(entries_.back().first, path);
+    if(comparison == 0)
+    {
+      entries_.back().second = value;
+      return;
+    }
+    if(comparison > 0)
+      sorted_ = false;
+  }
+  entries_.emplace_back(storeString(path), value);
+}
+
+void PathMap::sort()
+{
+  if(sorted_)
+    return;
+  str::stable_sort(entries_, less, &value_type::first);
+  // keep the last of all equal entries
+  auto out = entries_.begin();
+  for(auto iter = entries_.begin(); iter != entries_.end(); iter++)
+  {
+    auto next = std::next(iter);
+    if(next != entries_.end() && compare(iter->first, next->first) == 0)
+      continue;
+    *out++ = *iter;
+  }
+  entries_.erase(out, entries_.end());
+  sorted_ = true;
+}
+
+void PathMap::reserve(size_t size)
+{
+  entries_.reserve(size);
+}
+
+PathMap::const_iterator PathMap::find(std::string_view path) const
+{
+  checkIsSorted();
+  auto iter = str::lower_bound(entries_, path, less, &value_type::first);
+  if(iter != entries_.end() && compare(iter->first, path) == 0)
+    return iter;
+  return entries_.end();
+}
+
+bool PathMap::contains(std::string_view path) const
+{
+  return find(path) != entries_.end();
+}
+
+size_t PathMap::size() const
+{
+  return entries_.size();
+}
+
+bool PathMap::empty() const
+{
+  return entries_.empty();
+}
+
+PathMap::const_iterator PathMap::begin() const
+{
+  return entries_.begin();
+}
+
+PathMap::const_iterator PathMap::end() const
+{
+  return entries_.end();
+}
+
+size_t PathMap::getMemoryUsage() const
+{
+  return sizeof(PathMap) + entries_.capacity() * sizeof(value_type) +
+         blocks_.capacity() * sizeof(std::shared_ptr<char[]>) + arena_size_;
+}
+
+bool PathMap::operator==(const PathMap& other) const
+{
+  return str::equal(entries_, other.entries_);
+}
+
+std::string_view PathMap::storeString(std::string_view path)
+{
+  if(path.empty())
+    return {};
+  if(path.size() > BLOCK_SIZE / 4)
+  {
+    // large strings get their own block
+    blocks_.push_back(std::make_shared_for_overwrite<char[]>(path.size()));
+    std::memcpy(blocks_.back().get(), path.data(), path.size());
+    arena_size_ += path.size();
+    return { blocks_.back().get(), path.size() };
+  }
+  if(block_used_ + path.size() > BLOCK_SIZE)
+  {
+    blocks_.push_back(std::make_shared_for_overwrite<char[]>(BLOCK_SIZE));
+    current_block_ = blocks_.back().get();
+    arena_size_ += BLOCK_SIZE;
+    block_used_ = 0;
+  }
+  char* data = current_block_ + block_used_;
+  std::memcpy(data, path.data(), path.size());
+  block_used_ += path.size();
+  return { data, path.size() };
+}
+
+void PathMap::shareBlocks(const PathMap& other)
+{
+  blocks_.insert(blocks_.end(), other.blocks_.begin(), other.blocks_.end());
+  arena_size_ += other.arena_size_;
+  // new paths must never be written to a block which is still used by the other map
+  current_block_ = nullptr;
+  block_used_ = BLOCK_SIZE;
+}
+
+void PathMap::checkIsSorted() const
+{
+  if(!sorted_)
+    throw std::logic_error("PathMap must be sorted before it can be searched.");
+}
@@ -0,0 +1,187 @@
+/*!
+ * \file pathmap.h
+ * \brief Header for the PathMap class.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+/*!
+ * \brief Maps relative file paths to integer values, usually mod ids.
+ *
+ * Entries are stored in a flat vector which is sorted by path. All path strings are copied
+ * into an arena of large memory blocks, which are never reallocated. This uses only a fraction
+ * of the memory of a std::map<std::filesystem::path, int> and allows lookups and set
+ * operations without any allocations.
+ * Path strings are interned across maps: Copies, differences and intersections share the
+ * memory blocks of their source maps instead of copying their strings. Blocks are only ever
+ * appended to by the map which allocated them, so shared blocks remain immutable.
+ *
+ * Paths are ordered like std::filesystem::path, i.e. component wise, which is equivalent to
+ * a byte wise comparison in which '/' is considered smaller than every other character. Paths
+ * must be relative and must not contain empty components.
+ */
+class PathMap
+{
+public:
+  /*! \brief Type of the stored entries. */
+  using value_type = std::pair<std::string_view, int>;
+  /*! \brief Iterator type. */
+  using const_iterator = std::vector<value_type>::const_iterator;
+
+  /*! \brief Creates an empty map. */
+  PathMap() = default;
+  /*!
+   * \brief Copies all entries from the given map. Paths are shared with the other map.
+   * \param other Source map.
+   */
+  PathMap(const PathMap& other);
+  /*!
+   * \brief Moves all entries and paths from the given map, which is left empty.
+   * \param other Source map.
+   */
+  PathMap(PathMap&& other) noexcept;
+  /*!
+   * \brief Copies all entries from the given map. Paths are shared with the other map.
+   * \param other Source map.
+   * \return This map.
+   */
+  PathMap& operator=(const PathMap& other);
+  /*!
+   * \brief Moves all entries and paths from the given map, which is left empty.
+   * \param other Source map.
+   * \return This map.
+   */
+  PathMap& operator=(PathMap&& other) noexcept;
+
+  /*!
+   * \brief Compares two paths using the order used by this map.
+   * \param first First path.
+   * \param second Second path.
+   * \return A negative value if first < second, 0 if they are equal, else a positive value.
+   */
+  static int compare(std::string_view first, std::string_view second);
+  /*!
+   * \brief Checks if the first path is ordered before the second path.
+   * \param first First path.
+   * \param second Second path.
+   * \return True if first < second.
+   */
+  static bool less(std::string_view first, std::string_view second);
+  /*!
+   * \brief Creates a map containing all entries from first whose paths are not contained
+   * in second. Paths are shared with first.
+   * \param first First map.
+   * \param second Second map.
+   * \return The new map.
+   */
+  static PathMap difference(const PathMap& first, const PathMap& second);
+  /*!
+   * \brief Creates a map containing all entries from first whose paths are also contained
+   * in second. Paths are shared with first.
+   * \param first First map.
+   * \param second Second map.
+   * \return The new map.
+   */
+  static PathMap intersection(const PathMap& first, const PathMap& second);
+
+  /*!
+   * \brief Adds the given entry. If the map already contains the given path, its value
+   * is replaced. Adding paths in sorted order is done in constant time, otherwise sort
+   * has to be called before the map can be searched.
+   * \param path Path to add.
+   * \param value Value for the path.
+   */
+  void add(std::string_view path, int value);
+  /*!
+   * \brief Sorts all entries added out of order. For duplicate paths, only the most
+   * recently added value is kept.
+   */
+  void sort();
+  /*!
+   * \brief Reserves space for the given number of entries.
+   * \param size Number of entries.
+   */
+  void reserve(size_t size);
+  /*!
+   * \brief Searches for the given path. Requires the map to be sorted.
+   * \param path Path to search for.
+   * \return Iterator to the entry or end() if the path was not found.
+   */
+  const_iterator find(std::string_view path) const;
+  /*!
+   * \brief Checks if the given path is contained in this map. Requires the map to be sorted.
+   * \param path Path to search for.
+   * \return True if the path exists.
+   */
+  bool contains(std::string_view path) const;
+  /*!
+   * \brief Returns the number of entries in this map.
+   * \return The number of entries.
+   */
+  size_t size() const;
+  /*!
+   * \brief Checks if this map is empty.
+   * \return True if the map contains no entries.
+   */
+  bool empty() const;
+  /*!
+   * \brief Returns an iterator to the first entry.
+   * \return The iterator.
+   */
+  const_iterator begin() const;
+  /*!
+   * \brief Returns an iterator past the last entry.
+   * \return The iterator.
+   */
+  const_iterator end() const;
+  /*!
+   * \brief Returns the number of bytes used by this map, including blocks shared with
+   * other maps.
+   * \return The number of bytes.
+   */
+  size_t getMemoryUsage() const;
+  /*!
+   * \brief Compares the entries of two maps.
+   * \param other Map to compare to.
+   * \return True if both maps contain the same entries.
+   */
+  bool operator==(const PathMap& other) const;
+
+private:
+  /*! \brief Size of the memory blocks used to store paths. */
+  static constexpr size_t BLOCK_SIZE = 1 << 16;
+
+  /*! \brief All entries. Sorted by path, unless sorted_ is false. */
+  std::vector<value_type> entries_;
+  /*! \brief Memory blocks containing all paths, possibly shared with other maps. */
+  std::vector<std::shared_ptr<char[]>> blocks_;
+  /*! \brief Block into which new paths are copied. Always owned by this map. */
+  char* current_block_ = nullptr;
+  /*! \brief Number of bytes used in the current block. */
+  size_t block_used_ = BLOCK_SIZE;
+  /*! \brief Total size of all blocks. */
+  size_t arena_size_ = 0;
+  /*! \brief True if entries_ is sorted and contains no duplicates. */
+  bool sorted_ = true;
+
+  /*!
+   * \brief Copies the given string into the arena.
+   * \param path String to copy.
+   * \return A view of the copy.
+   */
+  std::string_view storeString(std::string_view path);
+  /*!
+   * \brief Makes all blocks of the given map part of this map, without allowing this map to
+   * write to them.
+   * \param other Map containing the blocks.
+   */
+  void shareBlocks(const PathMap& other);
+  /*! \brief Throws std::logic_error if this map is not sorted. */
+  void checkIsSorted() const;
+};
@@ -29,14 +29,13 @@ std::optional<sfs::path> pathExists(const sfs::path& path_to_check,
       continue;
     }
 
-    std::string lower_part = toLowerCase(*iter);
+    const std::string folded_part = toCaseFolded(iter->string());
     bool found = false;
     for(const auto& dir_entry : sfs::directory_iterator(base_path / actual_path))
     {
       const sfs::path path_end = *(std::prev(dir_entry.path().end()));
-      std::string lower_case_path_end = toLowerCase(path_end);
       std::string actual_case_path_end = path_end.string();
-      if(lower_case_path_end == lower_part)
+      if(toCaseFolded(actual_case_path_end) == folded_part)
       {
         actual_path /= actual_case_path_end;
         found = true;
@@ -59,6 +58,104 @@ std::string toLowerCase(const sfs::path& path)
   return path_string;
 }
 
+std::string toCaseFolded(std::string_view string)
+{
+  std::string result;
+  result.reserve(string.size());
+  for(size_t i = 0; i < string.size();)
+  {
+    const unsigned char byte = string[i];
+    if(byte < 0x80)
+    {
+      result += byte >= 'A' && byte <= 'Z' ? byte + 0x20 : byte;
+      i++;
+      continue;
+    }
+    int length = 0;
+    char32_t code_point = 0;
+    if((byte & 0xe0) == 0xc0)
+    {
+      length = 2;
+      code_point = byte & 0x1f;
+    }
+    else if((byte & 0xf0) == 0xe0)
+    {
+      length = 3;
+      code_point = byte & 0x0f;
+    }
+    else if((byte & 0xf8) == 0xf0)
+    {
+      length = 4;
+      code_point = byte & 0x07;
+    }
+    bool is_valid = length > 0 && i + length <= string.size();
+    for(int j = 1; is_valid && j < length; j++)
+    {
+      const unsigned char continuation = string[i + j];
+      is_valid = (continuation & 0xc0) == 0x80;
+      code_point = code_point << 6 | (continuation & 0x3f);
+    }
+    if(!is_valid)
+    {
+      result += byte;
+      i++;
+      continue;
+    }
+
+    const bool is_even = code_point % 2 == 0;
+    if(code_point >= 0xc0 && code_point <= 0xde && code_point != 0xd7 ||
+       code_point >= 0x391 && code_point <= 0x3ab && code_point != 0x3a2 ||
+       code_point >= 0x410 && code_point <= 0x42f || code_point >= 0xff21 && code_point <= 0xff3a)
+      code_point += 0x20;
+    // U+0130 has no simple case folding, mapping it to U+0131 would merge distinct names
+    else if(code_point >= 0x100 && code_point <= 0x137 && is_even && code_point != 0x130 ||
+            code_point >= 0x139 && code_point <= 0x148 && !is_even ||
+            code_point >= 0x14a && code_point <= 0x177 && is_even ||
+            code_point >= 0x179 && code_point <= 0x17e && !is_even ||
+            code_point >= 0x460 && code_point <= 0x481 && is_even ||
+            code_point >= 0x48a && code_point <= 0x4bf && is_even ||
+            code_point >= 0x4d0 && code_point <= 0x52f && is_even ||
+            code_point >= 0x1e00 && code_point <= 0x1e95 && is_even ||
+            code_point >= 0x1ea0 && code_point <= 0x1eff && is_even)
+      code_point += 1;
+    else if(code_point >= 0x400 && code_point <= 0x40f)
+      code_point += 0x50;
+    else if(code_point >= 0x531 && code_point <= 0x556)
+      code_point += 0x30;
+    else if(code_point == 0x178)
+      code_point = 0xff;
+    else if(code_point == 0x386)
+      code_point = 0x3ac;
+    else if(code_point >= 0x388 && code_point <= 0x38a)
+      code_point += 0x25;
+    else if(code_point == 0x38c)
+      code_point = 0x3cc;
+    else if(code_point == 0x38e || code_point == 0x38f)
+      code_point += 0x3f;
+
+    if(code_point < 0x800)
+    {
+      result += static_cast<char>(0xc0 | code_point >> 6);
+      result += static_cast<char>(0x80 | code_point & 0x3f);
+    }
+    else if(code_point < 0x10000)
+    {
+      result += static_cast<char>(0xe0 | code_point >> 12);
+      result += static_cast<char>(0x80 | code_point >> 6 & 0x3f);
+      result += static_cast<char>(0x80 | code_point & 0x3f);
+    }
+    else
+    {
+      result += static_cast<char>(0xf0 | code_point >> 18);
+      result += static_cast<char>(0x80 | code_point >> 12 & 0x3f);
+      result += static_cast<char>(0x80 | code_point >> 6 & 0x3f);
+      result += static_cast<char>(0x80 | code_point & 0x3f);
+    }
+    i += length;
+  }
+  return result;
+}
+
 void moveFilesToDirectory(const sfs::path& source, const sfs::path& destination, bool move)
 {
   if(!sfs::exists(destination))
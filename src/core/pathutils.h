@@ -32,6 +32,15 @@ std::optional<std::filesystem::path> pathExists(const std::filesystem::path& pat
  * \return The lower case path.
  */
 std::string toLowerCase(const std::filesystem::path& path);
+/*!
+ * \brief Converts the given UTF-8 string to a case folded form, which is identical for
+ * strings differing only in case. Unlike \ref toLowerCase, this supports upper case
+ * characters in the Latin, Greek, Cyrillic and Armenian scripts as well as full width
+ * Latin letters. Invalid UTF-8 sequences are copied unchanged.
+ * \param string String to be converted.
+ * \return The case folded string.
+ */
+std::string toCaseFolded(std::string_view string);
 /*!
  * \brief Recursively moves all files from the source directory to the target directory.
  * \param source Source directory.
@@ -45,6 +45,11 @@ std::map<int, unsigned long> PluginDeployer::deploy(const std::vector<int>& load
   return {};
 }
 
+DeploymentPlan PluginDeployer::getDeploymentPlan() const
+{
+  return {};
+}
+
 void PluginDeployer::changeLoadorder(int from_index, int to_index)
 {
   if(to_index == from_index)
@@ -214,7 +219,7 @@ bool PluginDeployer::swapMod(int old_id, int new_id)
 std::vector<ConflictInfo> PluginDeployer::getFileConflicts(
   int mod_id,
   bool show_disabled,
-  std::optional<ProgressNode*> progress_node) const
+  std::optional<ProgressNode*> progress_node)
 {
   if(progress_node)
   {
@@ -41,6 +41,11 @@ public:
   virtual std::map<int, unsigned long> deploy(
     const std::vector<int>& loadorder,
     std::optional<ProgressNode*> progress_node = {}) override;
+  /*!
+   * \brief Deploying only updates the plugin files, no mod files are linked.
+   * \return An empty plan.
+   */
+  virtual DeploymentPlan getDeploymentPlan() const override;
   /*!
    * \brief Moves a mod from one position in the load order to another. Saves changes to disk.
    * \param from_index Index of mod to be moved.
@@ -133,7 +138,7 @@ public:
   virtual std::vector<ConflictInfo> getFileConflicts(
     int mod_id,
     bool show_disabled = false,
-    std::optional<ProgressNode*> progress_node = {}) const override;
+    std::optional<ProgressNode*> progress_node = {}) override;
   /*!
    * \brief Not supported by this type.
    * \param mod_id The mod to be checked.
@@ -1,17 +1,23 @@
 #include "progressnode.h"
+#include "cancellationerror.h"
+#include <cmath>
 #include <limits>
 #include <numeric>
 
 
 ProgressNode::ProgressNode(int id,
                            const std::vector<float>& weights,
-                           std::optional<ProgressNode*> parent) : id_(id), parent_(parent)
+                           std::optional<ProgressNode*> parent) :
+  id_(id), root_(parent ? (*parent)->root_ : this)
 {
+  if(parent)
+    stop_token_ = (*parent)->stop_token_;
   addChildren(weights);
 }
 
 ProgressNode::ProgressNode(std::function<void(float)> progress_callback,
-                           const std::vector<float>& weights)
+                           const std::vector<float>& weights,
+                           std::stop_token stop_token) : root_(this), stop_token_(stop_token)
 {
   addChildren(weights);
   setProgressCallback(progress_callback);
@@ -21,24 +27,24 @@ void ProgressNode::advance(uint64_t num_steps)
 {
   if(!children_.empty())
     throw std::runtime_error("Cannot advance progress for a node with children.");
-  cur_step_ += num_steps;
-  if(total_steps_ == 0)
-    progress_ = 1.0f;
-  else
-    progress_ = std::min(static_cast<float>(cur_step_) / total_steps_, 1.0f);
-  propagateProgress();
+  const uint64_t total_steps = total_steps_.load(std::memory_order_relaxed);
+  const uint64_t prev_step = cur_step_.fetch_add(num_steps, std::memory_order_relaxed);
+  // completing a sub-task always triggers a sample, so that completion of the root is reported
+  const bool is_completed =
+    total_steps == 0 || prev_step < total_steps && prev_step + num_steps >= total_steps;
+  root_->sample(is_completed);
 }
 
 int ProgressNode::totalSteps() const
 {
-  return total_steps_;
+  return total_steps_.load(std::memory_order_relaxed);
 }
 
 void ProgressNode::setTotalSteps(uint64_t total_steps)
 {
   if(!children_.empty())
     throw std::runtime_error("Cannot set total steps for a node with children.");
-  total_steps_ = total_steps;
+  total_steps_.store(total_steps, std::memory_order_relaxed);
 }
 
 int ProgressNode::id() const
@@ -57,18 +63,18 @@ void ProgressNode::addChildren(const std::vector<float>& weights)
   for(float& weight : weights_)
     weight /= sum;
   for(int i = 0; i < weights_.size(); i++)
-    children_.push_back({ i, {}, this });
+    children_.push_back(std::make_unique<ProgressNode>(i, std::vector<float>{}, this));
 }
 
 ProgressNode& ProgressNode::child(int id)
 {
-  return children_[id];
+  return *children_[id];
 }
 
 void ProgressNode::setProgressCallback(std::function<void(float)> progress_callback)
 {
   set_progress_ = progress_callback;
-  set_progress_(progress_);
+  set_progress_(getProgress());
 }
 
 float ProgressNode::updateStepSize() const
@@ -81,28 +87,65 @@ void ProgressNode::setUpdateStepSize(float step_size)
   update_step_size_ = step_size;
 }
 
-float ProgressNode::getProgress() const
+std::chrono::steady_clock::duration ProgressNode::updateInterval() const
+{
+  return update_interval_;
+}
+
+void ProgressNode::setUpdateInterval(std::chrono::steady_clock::duration interval)
 {
-  return progress_;
+  update_interval_ = interval;
 }
 
-void ProgressNode::updateProgress()
+float ProgressNode::getProgress() const
 {
-  progress_ = 0.0f;
+  if(children_.empty())
+  {
+    const uint64_t cur_step = cur_step_.load(std::memory_order_relaxed);
+    const uint64_t total_steps = total_steps_.load(std::memory_order_relaxed);
+    if(total_steps == 0)
+      return cur_step > 0 ? 1.0f : 0.0f;
+    return std::min(static_cast<float>(cur_step) / total_steps, 1.0f);
+  }
+  float progress = 0.0f;
   for(int i = 0; i < weights_.size(); i++)
-    progress_ += weights_[i] * children_[i].progress_;
-  propagateProgress();
+    progress += weights_[i] * children_[i]->getProgress();
+  return progress;
 }
 
-void ProgressNode::propagateProgress()
+bool ProgressNode::stopRequested() const
 {
-  if(parent_)
-    (*parent_)->updateProgress();
-  else if(progress_ - prev_progress_ > update_step_size_ ||
-          std::abs(1.0f - progress_) <= std::numeric_limits<float>::epsilon() &&
-            std::abs(1.0f - prev_progress_) > std::numeric_limits<float>::epsilon())
+  return stop_token_.stop_requested();
+}
+
+void ProgressNode::checkStop() const
+{
+  if(stop_token_.stop_requested())
+    throw CancellationError();
+}
+
+void ProgressNode::sample(bool force)
+{
+  std::unique_lock lock(update_mutex_, std::defer_lock);
+  if(force)
+    lock.lock();
+  else
+  {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    auto next_update_time = next_update_time_.load(std::memory_order_relaxed);
+    if(now < next_update_time ||
+       !next_update_time_.compare_exchange_strong(
+         next_update_time, now + update_interval_.count(), std::memory_order_relaxed) ||
+       !lock.try_lock())
+      return;
+  }
+
+  const float progress = getProgress();
+  if(progress - prev_progress_ > update_step_size_ ||
+     std::abs(1.0f - progress) <= std::numeric_limits<float>::epsilon() &&
+       std::abs(1.0f - prev_progress_) > std::numeric_limits<float>::epsilon())
   {
-    set_progress_(progress_);
-    prev_progress_ = progress_;
+    set_progress_(progress);
+    prev_progress_ = progress;
   }
 }
@@ -5,9 +5,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <stop_token>
 #include <vector>
 
 
@@ -17,6 +21,14 @@
  * Each node in the tree represents the progress in a sub-task. Each sub-task has
  * a weight associated to it, which should be proportional to the time this task takes
  * to be completed.
+ * Only leaf nodes store progress, in the form of atomic step counters. The progress of inner
+ * nodes is computed on demand, when the root node is sampled. Sampling happens at most once
+ * per update interval, or when a leaf node completes its task. Leaf nodes may therefore be
+ * advanced concurrently from multiple threads, as long as the structure of the tree is no
+ * longer changed.
+ * A root node can also carry a stop token, which is shared with all of its children. Long
+ * running tasks use this to check for cancellation at points where stopping leaves a
+ * consistent state.
  */
 class ProgressNode
 {
@@ -33,13 +45,17 @@ public:
    * \param progress_callback a callback function used by the root node to inform about
    * changes in the task progress.
    * \param weights If not empty: Weights of sub-tasks.
+   * \param stop_token Used to request cancellation of the task.
    */
   ProgressNode(std::function<void(float)> progress_callback,
-               const std::vector<float>& weights = {});
+               const std::vector<float>& weights = {},
+               std::stop_token stop_token = {});
+  ProgressNode(const ProgressNode&) = delete;
+  ProgressNode& operator=(const ProgressNode&) = delete;
 
   /*!
    * \brief Advances the current progress of this node by the given amount of steps.
-   * This must be a leaf node.
+   * This must be a leaf node. Thread safe.
    * \param num_steps Number steps to advance.
    */
   void advance(uint64_t num_steps = 1);
@@ -86,30 +102,56 @@ public:
    */
   void setUpdateStepSize(float step_size);
   /*!
-   * \brief Returns the current progress.
+   * \brief Returns the minimal time between two samples of the progress of the root node.
+   * \return The interval.
+   */
+  std::chrono::steady_clock::duration updateInterval() const;
+  /*!
+   * \brief Sets the minimal time between two samples of the progress of the root node.
+   * \param interval The interval.
+   */
+  void setUpdateInterval(std::chrono::steady_clock::duration interval);
+  /*!
+   * \brief Computes the current progress from the progress of all leaf nodes in this subtree.
+   * Thread safe.
    * \return The progress.
    */
   float getProgress() const;
+  /*!
+   * \brief Checks if cancellation of the task has been requested.
+   * \return True if the task should be stopped.
+   */
+  bool stopRequested() const;
+  /*!
+   * \brief Throws a CancellationError if cancellation of the task has been requested.
+   */
+  void checkStop() const;
 
 private:
   /*! \brief This nodes id. */
   int id_;
   /*! \brief Current step in this task. Only used for leaf nodes. */
-  uint64_t cur_step_ = 0;
+  std::atomic<uint64_t> cur_step_ = 0;
   /*! \brief Number of total steps in this task. Only used for leaf nodes. */
-  uint64_t total_steps_;
-  /*! \brief Current progress in this task. */
-  float progress_ = 0.0f;
+  std::atomic<uint64_t> total_steps_ = 0;
   /*! \brief Progress at the time of the last call to \ref set_progress_. */
   float prev_progress_ = 0.0f;
   /*! \brief minimal progress interval after which \ref set_progress_ is called. */
   float update_step_size_ = 0.01f;
-  /*! \brief The parent of this, if this is not the root. */
-  std::optional<ProgressNode*> parent_;
+  /*! \brief Minimal time between two samples of the progress. Only used for the root. */
+  std::chrono::steady_clock::duration update_interval_ = std::chrono::milliseconds(50);
+  /*! \brief Earliest time, in ticks of the steady clock, at which the next sample is taken. */
+  std::atomic<std::chrono::steady_clock::rep> next_update_time_ = 0;
+  /*! \brief Serializes samples and calls to \ref set_progress_. Only used for the root. */
+  std::mutex update_mutex_;
+  /*! \brief The root of the tree containing this node. */
+  ProgressNode* root_;
   /*! \brief Weights of children. */
   std::vector<float> weights_;
   /*! \brief Children representing sub-tasks of this task. */
-  std::vector<ProgressNode> children_;
+  std::vector<std::unique_ptr<ProgressNode>> children_;
+  /*! \brief Used to request cancellation of the task. Passed on to all children. */
+  std::stop_token stop_token_;
 
   /*!
    * \brief Callback function used by the root node to inform about changes in the
@@ -117,15 +159,12 @@ private:
    */
   std::function<void(float)> set_progress_ = [](float f) {};
   /*!
-   * \brief Sets the current progress of this node to the weighted sum of the current
-   * progresses of its children.
-   */
-  void updateProgress();
-  /*!
-   * \brief Informs this nodes parent of a change in progress.
+   * \brief Samples the progress of this root node.
    *
-   * If this is a root node and the change of progress since the last update exceeds
-   * \ref update_step_size_ : Call \ref set_progress_.
+   * If the change of progress since the last call to \ref set_progress_ exceeds
+   * \ref update_step_size_ or the task has been completed: Call \ref set_progress_.
+   * \param force If false: Only take a sample if \ref update_interval_ has passed since the
+   * last one.
    */
-  void propagateProgress();
+  void sample(bool force);
 };
@@ -1,4 +1,5 @@
 #include "reversedeployer.h"
+#include "cancellationerror.h"
 #include "pathutils.h"
 #include "json/json.h"
 #include <algorithm>
@@ -41,7 +42,22 @@ void ReverseDeployer::updateManagedFiles(bool write, std::optional<ProgressNode*
   log_(Log::LOG_INFO, std::format("Deployer '{}': Updating managed files...", name_));
   if(progress_node)
     (*progress_node)->setTotalSteps(std::max(number_of_files_in_target_, 0));
-  number_of_files_in_target_ = updateFilesInDir(dest_path_, {}, dest_path_, false, progress_node);
+  // scanning can be cancelled through the progress node, so changes are only applied afterwards
+  std::vector<sfs::path> new_files;
+  std::vector<sfs::path> unmanaged_files;
+  number_of_files_in_target_ =
+    updateFilesInDir(dest_path_, {}, dest_path_, new_files, unmanaged_files, progress_node);
+  removeManagedFiles(unmanaged_files);
+  for(const auto& path : new_files)
+  {
+    if(!separate_profile_dirs_)
+    {
+      for(auto& profile_files : managed_files_)
+        profile_files.try_emplace(path, true);
+    }
+    else
+      managed_files_[current_profile_].try_emplace(path, true);
+  }
   updateCurrentLoadorder();
   moveFilesFromTargetToSource();
   if(write)
@@ -84,6 +100,11 @@ std::map<int, unsigned long> ReverseDeployer::deploy(const std::vector<int>& loa
   return deploy(progress_node);
 }
 
+DeploymentPlan ReverseDeployer::getDeploymentPlan() const
+{
+  return {};
+}
+
 void ReverseDeployer::unDeploy(std::optional<ProgressNode*> progress_node)
 {
   if(deployed_profile_ < 0 || deployed_profile_ >= managed_files_.size())
@@ -243,7 +264,7 @@ bool ReverseDeployer::swapMod(int old_id, int new_id)
 std::vector<ConflictInfo> ReverseDeployer::getFileConflicts(
   int mod_id,
   bool show_disabled,
-  std::optional<ProgressNode*> progress_node) const
+  std::optional<ProgressNode*> progress_node)
 {
   if(progress_node)
   {
@@ -410,7 +431,12 @@ void ReverseDeployer::updateIgnoredFiles(bool write)
 {
   log_(Log::LOG_DEBUG, std::format("Deployer {}: Updating ignored files...", name_));
   ignored_files_.clear();
-  updateFilesInDir(dest_path_, {}, {}, true);
+  std::vector<sfs::path> new_files;
+  std::vector<sfs::path> unmanaged_files;
+  updateFilesInDir(dest_path_, {}, {}, new_files, unmanaged_files);
+  removeManagedFiles(unmanaged_files);
+  for(const auto& path : new_files)
+    ignored_files_.insert(path.string());
   if(write)
     writeIgnoredFiles();
 }
@@ -675,9 +701,12 @@ void ReverseDeployer::writeManagedFiles() const
 int ReverseDeployer::updateFilesInDir(const sfs::path& target_dir,
                                       const std::unordered_set<sfs::path>& deployed_files,
                                       sfs::path current_deployer_path,
-                                      bool update_ignored_files,
+                                      std::vector<sfs::path>& new_files,
+                                      std::vector<sfs::path>& unmanaged_files,
                                       std::optional<ProgressNode*> progress_node)
 {
+  if(progress_node)
+    (*progress_node)->checkStop();
   std::vector<sfs::path> dirs;
   std::vector<sfs::path> files;
 
@@ -709,39 +738,34 @@ int ReverseDeployer::updateFilesInDir(const sfs::path& target_dir,
     const sfs::path file_name = file.filename();
     const sfs::path path_relative_to_target = pu::getRelativePath(file, dest_path_);
     if(file_name == deployed_files_name_ || file_name == ignore_list_file_name_ ||
-       file_name.extension() == backup_extension_ || file_name == managed_dir_file_name_)
+       file_name.extension() == backup_extension_ || file_name == managed_dir_file_name_ ||
+       file_name == deployment_journal_name_)
       continue;
     if(ignored_files_.contains(path_relative_to_target) || current_deployed_files.contains(file))
-    {
-      if(current_profile_ > -1 && current_profile_ < managed_files_.size() &&
-         managed_files_[current_profile_].contains(path_relative_to_target))
-        managed_files_[current_profile_].erase(path_relative_to_target);
-      continue;
-    }
-    if(update_ignored_files)
-      ignored_files_.insert(path_relative_to_target);
+      unmanaged_files.push_back(path_relative_to_target);
     else
-    {
-      if(!separate_profile_dirs_)
-      {
-        for(int prof = 0; prof < managed_files_.size(); prof++)
-        {
-          if(!managed_files_[prof].contains(path_relative_to_target))
-            managed_files_[prof][path_relative_to_target] = true;
-        }
-      }
-      else if(!managed_files_[current_profile_].contains(path_relative_to_target))
-        managed_files_[current_profile_][path_relative_to_target] = true;
-    }
+      new_files.push_back(path_relative_to_target);
   }
 
   int total_num_files = files.size();
   for(const auto& dir : dirs)
-    total_num_files += updateFilesInDir(
-      dir, current_deployed_files, current_deployer_path, update_ignored_files, progress_node);
+    total_num_files += updateFilesInDir(dir,
+                                        current_deployed_files,
+                                        current_deployer_path,
+                                        new_files,
+                                        unmanaged_files,
+                                        progress_node);
   return total_num_files;
 }
 
+void ReverseDeployer::removeManagedFiles(const std::vector<sfs::path>& files)
+{
+  if(current_profile_ < 0 || current_profile_ >= managed_files_.size())
+    return;
+  for(const auto& path : files)
+    managed_files_[current_profile_].erase(path);
+}
+
 void ReverseDeployer::moveFilesFromTargetToSource() const
 {
   bool move_failed = false;
@@ -55,6 +55,12 @@ public:
    */
   std::map<int, unsigned long> deploy(const std::vector<int>& loadorder,
                                       std::optional<ProgressNode*> progress_node = {}) override;
+  /*!
+   * \brief The files linked by this deployer are only known after scanning the target
+   * directory during deployment, so no plan can be created in advance.
+   * \return An empty plan.
+   */
+  DeploymentPlan getDeploymentPlan() const override;
   /*!
    * \brief Unlinks all managed files
    * \param progress_node Used to inform about the current progress.
@@ -151,7 +157,7 @@ public:
   std::vector<ConflictInfo> getFileConflicts(
     int mod_id,
     bool show_disabled = false,
-    std::optional<ProgressNode*> progress_node = {}) const override;
+    std::optional<ProgressNode*> progress_node = {}) override;
   /*!
    * \brief Checks for conflicts with other mods.
    * Two mods are conflicting if they share at least one record.
@@ -323,19 +329,28 @@ private:
   /*! \brief Writes all files for every profile to a file in source_path_. */
   void writeManagedFiles() const;
   /*!
-   * \brief Recursively adds all files not ignored or handled by other deployers in
-   * dir to profile_files_ for the current profile.
+   * \brief Recursively collects all files in dir. Does not modify this object, so that
+   * the scan can be cancelled without affecting the current state.
    * \param target_dir Directory in which to search for files.
    * \param deployed_files Contains relative paths to all files deployed by another deployer.
    * \param current_deployer_path Target directory of another deployer managing this directory.
-   * \param update_ignored_files If true: Update the list of ignored files instead.
+   * \param new_files Receives the paths of all files not ignored or handled by other deployers,
+   * relative to dest_path_.
+   * \param unmanaged_files Receives the paths of all other files, relative to dest_path_.
    * \param progress_node Used to inform about progress.
+   * \return The number of files in dir.
    */
   int updateFilesInDir(const std::filesystem::path& target_dir,
                        const std::unordered_set<std::filesystem::path>& deployed_files,
                        std::filesystem::path current_deployer_path,
-                       bool update_ignored_files = false,
+                       std::vector<std::filesystem::path>& new_files,
+                       std::vector<std::filesystem::path>& unmanaged_files,
                        std::optional<ProgressNode*> progress_node = {});
+  /*!
+   * \brief Removes the given files from the managed files of the current profile.
+   * \param files Paths relative to dest_path_.
+   */
+  void removeManagedFiles(const std::vector<std::filesystem::path>& files);
   /*! \brief Moves all managed files from dest_path_ to source_path_. */
   void moveFilesFromTargetToSource() const;
   /*! \brief Updates current_loadorder_ to reflect managed_files_[current_profile_]. */
@@ -0,0 +1,232 @@
+#include "settingscache.h"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sfs = std::filesystem;
+
+
+void SettingsCache::write(const sfs::path& path,
+                          const Json::Value& settings,
+                          const sfs::path& source_file)
+{
+  const Header header = makeHeader(source_file);
+  std::string data;
+  encode(settings, data);
+
+  const sfs::path tmp_path = path.string() + ".tmp";
+  std::ofstream file(tmp_path, std::fstream::binary);
+  if(!file.is_open())
+    throw std::runtime_error("Could not write \"" + tmp_path.string() + "\"");
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(data.data(), data.size());
+  file.close();
+  if(!file)
+    throw std::runtime_error("Could not write \"" + tmp_path.string() + "\"");
+  sfs::rename(tmp_path, path);
+}
+
+bool SettingsCache::read(const sfs::path& path,
+                         const sfs::path& source_file,
+                         Json::Value& settings)
+{
+  if(!sfs::exists(path) || !sfs::exists(source_file))
+    return false;
+  const int fd = open(path.c_str(), O_RDONLY);
+  if(fd == -1)
+    return false;
+  struct stat file_stat;
+  if(fstat(fd, &file_stat) != 0 || file_stat.st_size < sizeof(Header))
+  {
+    close(fd);
+    return false;
+  }
+  const size_t data_size = file_stat.st_size;
+  void* data = mmap(nullptr, data_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(data == MAP_FAILED)
+    return false;
+
+  Header header;
+  std::memcpy(&header, data, sizeof(Header));
+  const Header expected_header = makeHeader(source_file);
+  bool was_read = false;
+  if(std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION &&
+     header.source_size == expected_header.source_size &&
+     header.source_time == expected_header.source_time)
+  {
+    try
+    {
+      size_t pos = sizeof(Header);
+      Json::Value value = decode(static_cast<const char*>(data), data_size, pos);
+      if(pos == data_size)
+      {
+        settings = std::move(value);
+        was_read = true;
+      }
+    }
+    catch(std::out_of_range& error)
+    {
+      was_read = false;
+    }
+  }
+  munmap(data, data_size);
+  return was_read;
+}
+
+SettingsCache::Header SettingsCache::makeHeader(const sfs::path& source_file)
+{
+  Header header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.source_size = sfs::file_size(source_file);
+  header.source_time = sfs::last_write_time(source_file).time_since_epoch().count();
+  return header;
+}
+
+void SettingsCache::encode(const Json::Value& value, std::string& data)
+{
+  auto append = [&data](const auto& number)
+  { data.append(reinterpret_cast<const char*>(&number), sizeof(number)); };
+  auto append_string = [&data, &append](const char* begin, const char* end)
+  {
+    append(static_cast<uint32_t>(end - begin));
+    data.append(begin, end);
+  };
+
+  switch(value.type())
+  {
+    case Json::nullValue:
+      data.push_back(null_tag);
+      break;
+    case Json::intValue:
+      data.push_back(int_tag);
+      append(value.asInt64());
+      break;
+    case Json::uintValue:
+      data.push_back(uint_tag);
+      append(value.asUInt64());
+      break;
+    case Json::realValue:
+      data.push_back(real_tag);
+      append(value.asDouble());
+      break;
+    case Json::stringValue:
+    {
+      data.push_back(string_tag);
+      const char* begin;
+      const char* end;
+      value.getString(&begin, &end);
+      append_string(begin, end);
+      break;
+    }
+    case Json::booleanValue:
+      data.push_back(value.asBool() ? true_tag : false_tag);
+      break;
+    case Json::arrayValue:
+      data.push_back(array_tag);
+      append(static_cast<uint32_t>(value.size()));
+      for(const auto& element : value)
+        encode(element, data);
+      break;
+    case Json::objectValue:
+      data.push_back(object_tag);
+      append(static_cast<uint32_t>(value.size()));
+      for(auto iter = value.begin(); iter != value.end(); iter++)
+      {
+        const char* end;
+        const char* begin = iter.memberName(&end);
+        append_string(begin, end);
+        encode(*iter, data);
+      }
+      break;
+  }
+}
+
+Json::Value SettingsCache::decode(const char* data, size_t size, size_t& pos, int depth)
+{
+  auto read = [data, size, &pos]<typename T>(T& number)
+  {
+    if(size - pos < sizeof(T))
+      throw std::out_of_range("Unexpected end of settings cache");
+    std::memcpy(&number, data + pos, sizeof(T));
+    pos += sizeof(T);
+  };
+  auto read_string = [data, size, &pos, &read]()
+  {
+    uint32_t length;
+    read(length);
+    if(size - pos < length)
+      throw std::out_of_range("Unexpected end of settings cache");
+    pos += length;
+    return std::string_view(data + pos - length, length);
+  };
+
+  if(depth > MAX_DEPTH)
+    throw std::out_of_range("Settings cache is nested too deeply");
+  uint8_t tag;
+  read(tag);
+  switch(tag)
+  {
+    case null_tag:
+      return Json::Value();
+    case int_tag:
+    {
+      Json::Int64 number;
+      read(number);
+      return Json::Value(number);
+    }
+    case uint_tag:
+    {
+      Json::UInt64 number;
+      read(number);
+      return Json::Value(number);
+    }
+    case real_tag:
+    {
+      double number;
+      read(number);
+      return Json::Value(number);
+    }
+    case string_tag:
+    {
+      const auto string = read_string();
+      return Json::Value(string.data(), string.data() + string.size());
+    }
+    case false_tag:
+      return Json::Value(false);
+    case true_tag:
+      return Json::Value(true);
+    case array_tag:
+    {
+      uint32_t num_elements;
+      read(num_elements);
+      if(num_elements > size - pos)
+        throw std::out_of_range("Invalid size in settings cache");
+      Json::Value array(Json::arrayValue);
+      for(uint32_t i = 0; i < num_elements; i++)
+        array.append(decode(data, size, pos, depth + 1));
+      return array;
+    }
+    case object_tag:
+    {
+      uint32_t num_members;
+      read(num_members);
+      if(num_members > size - pos)
+        throw std::out_of_range("Invalid size in settings cache");
+      Json::Value object(Json::objectValue);
+      for(uint32_t i = 0; i < num_members; i++)
+      {
+        const auto key = read_string();
+        object[std::string(key)] = decode(data, size, pos, depth + 1);
+      }
+      return object;
+    }
+    default:
+      throw std::out_of_range("Invalid type in settings cache");
+  }
+}
@@ -0,0 +1,104 @@
+/*!
+ * \file settingscache.h
+ * \brief Header for the SettingsCache class.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <json/json.h>
+#include <string>
+
+
+/*!
+ * \brief Stores a versioned binary copy of a JSON settings file, which can be loaded by
+ * memory mapping it instead of parsing JSON.
+ *
+ * The file starts with a header identifying the size and modification time of the JSON
+ * file it was created from. Values follow in depth first order, each consisting of a type
+ * tag and, depending on the type, a fixed size number or a length prefixed list of elements.
+ */
+class SettingsCache
+{
+public:
+  /*!
+   * \brief Writes the given settings to a new cache file. The target file is replaced
+   * atomically.
+   * \param path Path to the cache file.
+   * \param settings Settings to store.
+   * \param source_file JSON file containing the given settings.
+   */
+  static void write(const std::filesystem::path& path,
+                    const Json::Value& settings,
+                    const std::filesystem::path& source_file);
+  /*!
+   * \brief Reads settings from the given cache file, if it is valid and was created from
+   * the current version of the given source file.
+   * \param path Path to the cache file.
+   * \param source_file JSON file from which the cache was created.
+   * \param settings Target for the settings.
+   * \return True if settings were read, false if the cache is missing, outdated or invalid.
+   */
+  static bool read(const std::filesystem::path& path,
+                   const std::filesystem::path& source_file,
+                   Json::Value& settings);
+
+private:
+  /*! \brief Fixed size header at the start of every cache file. */
+  struct Header
+  {
+    /*! \brief File signature. */
+    char magic[4];
+    /*! \brief Version of the file format. */
+    uint32_t version;
+    /*! \brief Size of the source file. */
+    uint64_t source_size;
+    /*! \brief Modification time of the source file, in ticks of the file clock. */
+    int64_t source_time;
+  };
+
+  /*! \brief Type tags preceding every value. */
+  enum Tag : uint8_t
+  {
+    null_tag,
+    int_tag,
+    uint_tag,
+    real_tag,
+    string_tag,
+    false_tag,
+    true_tag,
+    array_tag,
+    object_tag
+  };
+
+  /*! \brief Signature identifying cache files. */
+  static constexpr char MAGIC[4] = { 'L', 'M', 'M', 'S' };
+  /*! \brief Version of the file format. */
+  static constexpr uint32_t VERSION = 1;
+  /*! \brief Nesting depth at which decoding is aborted. */
+  static constexpr int MAX_DEPTH = 256;
+
+  /*!
+   * \brief Creates the header for the given source file.
+   * \param source_file Source JSON file.
+   * \return The header.
+   */
+  static Header makeHeader(const std::filesystem::path& source_file);
+  /*!
+   * \brief Appends the binary representation of the given value to the given string.
+   * \param value Value to encode.
+   * \param data Target string.
+   */
+  static void encode(const Json::Value& value, std::string& data);
+  /*!
+   * \brief Decodes the value starting at the given position.
+   * Throws std::out_of_range if the data is malformed.
+   * \param data Start of the data.
+   * \param size Size of the data.
+   * \param pos Position of the value, is advanced past its end.
+   * \param depth Current nesting depth.
+   * \return The value.
+   */
+  static Json::Value decode(const char* data, size_t size, size_t& pos, int depth = 0);
+};
@@ -0,0 +1,190 @@
+#include "settingsjournal.h"
+#include <fstream>
+#include <memory>
+
+namespace sfs = std::filesystem;
+
+
+SettingsJournal::SettingsJournal(const sfs::path& path) : path_(path) {}
+
+int SettingsJournal::record(const Json::Value& path,
+                            const Json::Value& old_value,
+                            const Json::Value& new_value)
+{
+  Json::StreamWriterBuilder writer;
+  writer["indentation"] = "";
+  std::string lines;
+  int num_operations = 0;
+  if(new_value.isNull() && !old_value.isNull())
+  {
+    Json::Value operation;
+    operation["op"] = REMOVE_OPERATION;
+    operation["path"] = path;
+    lines = Json::writeString(writer, operation) + "\n";
+    num_operations = 1;
+  }
+  else
+  {
+    Json::Value mutable_path = path;
+    num_operations = diff(mutable_path, old_value, new_value, writer, lines);
+  }
+  if(num_operations == 0)
+    return 0;
+  std::ofstream file(path_, std::ios::binary | std::ios::app);
+  if(!file.is_open())
+    throw std::runtime_error("Error: Could not write to \"" + path_.string() + "\".");
+  file << lines;
+  file.close();
+  if(file.fail())
+    throw std::runtime_error("Error: Could not write to \"" + path_.string() + "\".");
+  return num_operations;
+}
+
+bool SettingsJournal::replay(Json::Value& settings) const
+{
+  std::ifstream file(path_, std::ios::binary);
+  if(!file.is_open())
+    return false;
+  std::unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
+  bool was_applied = false;
+  std::string line;
+  while(std::getline(file, line))
+  {
+    Json::Value operation;
+    if(!reader->parse(line.data(), line.data() + line.size(), &operation, nullptr) ||
+       !operation.isObject() || !operation["path"].isArray())
+      break;
+    const std::string type = operation["op"].asString();
+    const Json::Value& path = operation["path"];
+    if(type == SET_OPERATION)
+      *resolve(settings, path, true) = operation["value"];
+    else if(type == RESIZE_OPERATION)
+    {
+      Json::Value* target = resolve(settings, path, false);
+      if(target && target->isArray())
+        target->resize(operation["size"].asUInt());
+    }
+    else if(type == REMOVE_OPERATION && path.size() > 0)
+    {
+      Json::Value parent_path(Json::arrayValue);
+      for(int i = 0; i < path.size() - 1; i++)
+        parent_path.append(path[i]);
+      Json::Value* parent = resolve(settings, parent_path, false);
+      if(parent && parent->isObject() && path[path.size() - 1].isString())
+        parent->removeMember(path[path.size() - 1].asString());
+    }
+    else
+      break;
+    was_applied = true;
+  }
+  return was_applied;
+}
+
+uintmax_t SettingsJournal::size() const
+{
+  std::error_code error;
+  const auto file_size = sfs::file_size(path_, error);
+  return error ? 0 : file_size;
+}
+
+void SettingsJournal::clear()
+{
+  sfs::remove(path_);
+}
+
+int SettingsJournal::diff(Json::Value& path,
+                          const Json::Value& old_value,
+                          const Json::Value& new_value,
+                          Json::StreamWriterBuilder& writer,
+                          std::string& lines) const
+{
+  if(old_value == new_value)
+    return 0;
+  auto write_operation = [&path, &writer, &lines](const std::string& type, const Json::Value& value)
+  {
+    Json::Value operation;
+    operation["op"] = type;
+    operation["path"] = path;
+    if(type == SET_OPERATION)
+      operation["value"] = value;
+    else if(type == RESIZE_OPERATION)
+      operation["size"] = value;
+    lines += Json::writeString(writer, operation) + "\n";
+    return 1;
+  };
+
+  if(old_value.type() != new_value.type() || (!new_value.isArray() && !new_value.isObject()))
+    return write_operation(SET_OPERATION, new_value);
+
+  int num_operations = 0;
+  if(new_value.isArray())
+  {
+    const Json::ArrayIndex common_size = std::min(old_value.size(), new_value.size());
+    Json::ArrayIndex num_changed = 0;
+    for(Json::ArrayIndex i = 0; i < common_size; i++)
+    {
+      if(old_value[i] != new_value[i])
+        num_changed++;
+    }
+    // e.g. removing the first element shifts all others, which is cheaper to store as a whole
+    if(old_value.size() != new_value.size() && 2 * num_changed > common_size)
+      return write_operation(SET_OPERATION, new_value);
+    for(Json::ArrayIndex i = 0; i < common_size; i++)
+    {
+      path.append(i);
+      num_operations += diff(path, old_value[i], new_value[i], writer, lines);
+      path.resize(path.size() - 1);
+    }
+    if(new_value.size() < old_value.size())
+      num_operations += write_operation(RESIZE_OPERATION, new_value.size());
+    for(Json::ArrayIndex i = common_size; i < new_value.size(); i++)
+    {
+      path.append(i);
+      num_operations += write_operation(SET_OPERATION, new_value[i]);
+      path.resize(path.size() - 1);
+    }
+    return num_operations;
+  }
+
+  for(const auto& name : old_value.getMemberNames())
+  {
+    if(!new_value.isMember(name))
+    {
+      path.append(name);
+      num_operations += write_operation(REMOVE_OPERATION, {});
+      path.resize(path.size() - 1);
+    }
+  }
+  for(const auto& name : new_value.getMemberNames())
+  {
+    path.append(name);
+    if(!old_value.isMember(name))
+      num_operations += write_operation(SET_OPERATION, new_value[name]);
+    else
+      num_operations += diff(path, old_value[name], new_value[name], writer, lines);
+    path.resize(path.size() - 1);
+  }
+  return num_operations;
+}
+
+Json::Value* SettingsJournal::resolve(Json::Value& root, const Json::Value& path, bool create)
+{
+  Json::Value* value = &root;
+  for(const auto& key : path)
+  {
+    if(key.isString())
+    {
+      if(!create && (!value->isObject() || !value->isMember(key.asString())))
+        return nullptr;
+      value = &(*value)[key.asString()];
+    }
+    else
+    {
+      const Json::ArrayIndex index = key.asUInt();
+      if(!create && (!value->isArray() || index >= value->size()))
+        return nullptr;
+      value = &(*value)[index];
+    }
+  }
+  return value;
+}
@@ -0,0 +1,90 @@
+/*!
+ * \file settingsjournal.h
+ * \brief Header for the SettingsJournal class.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <json/json.h>
+#include <string>
+
+
+/*!
+ * \brief Append only journal of changes to a JSON settings file.
+ *
+ * Every change is stored as one line containing an operation, a path of member names and
+ * array indices into the settings and, for assignments, the new value. Replaying all lines on
+ * top of the last written snapshot of the settings restores the current state. Replaying a
+ * journal more than once yields the same result, so the journal only has to be removed after
+ * a new snapshot has been written.
+ */
+class SettingsJournal
+{
+public:
+  /*!
+   * \brief Constructor.
+   * \param path Path to the journal file.
+   */
+  SettingsJournal(const std::filesystem::path& path);
+
+  /*!
+   * \brief Appends all operations required to transform the given old value into the given
+   * new value to the journal.
+   * \param path Array of member names and indices pointing to the value in the settings.
+   * \param old_value Value at the given path, as it is currently stored.
+   * \param new_value New value at the given path.
+   * \return The number of recorded operations.
+   */
+  int record(const Json::Value& path, const Json::Value& old_value, const Json::Value& new_value);
+  /*!
+   * \brief Applies all operations stored in the journal to the given settings.
+   * Reading stops at the first incomplete line, which can be the result of an interrupted write.
+   * \param settings Target settings.
+   * \return True if at least one operation has been applied.
+   */
+  bool replay(Json::Value& settings) const;
+  /*!
+   * \brief Returns the size of the journal file.
+   * \return The size in bytes, or 0 if the file does not exist.
+   */
+  uintmax_t size() const;
+  /*! \brief Deletes the journal file. */
+  void clear();
+
+private:
+  /*! \brief Operation which assigns a value. */
+  static constexpr std::string SET_OPERATION = "set";
+  /*! \brief Operation which removes an object member. */
+  static constexpr std::string REMOVE_OPERATION = "remove";
+  /*! \brief Operation which shrinks an array. */
+  static constexpr std::string RESIZE_OPERATION = "resize";
+
+  /*! \brief Path to the journal file. */
+  std::filesystem::path path_;
+
+  /*!
+   * \brief Recursively compares the given values and serializes one operation per
+   * difference. Arrays which changed in size and in which more than half of all elements
+   * changed are replaced as a whole.
+   * \param path Path to the compared values.
+   * \param old_value Old value.
+   * \param new_value New value.
+   * \param writer Used to serialize operations.
+   * \param lines Operations are appended to this.
+   * \return The number of operations.
+   */
+  int diff(Json::Value& path,
+           const Json::Value& old_value,
+           const Json::Value& new_value,
+           Json::StreamWriterBuilder& writer,
+           std::string& lines) const;
+  /*!
+   * \brief Returns the value at the given path.
+   * \param root Settings containing the value.
+   * \param path Array of member names and indices.
+   * \param create If true: Create all missing values along the path.
+   * \return A pointer to the value, or nullptr if it does not exist and create is false.
+   */
+  static Json::Value* resolve(Json::Value& root, const Json::Value& path, bool create);
+};
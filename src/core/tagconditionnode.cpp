@@ -64,7 +64,9 @@ TagConditionNode::TagConditionNode(std::string expression,
     condition_strings_ = splitString(condition_);
     invert_ = conditions[condition_index].invert ? !invert_ : invert_;
     use_regex_ = conditions[condition_index].use_regex;
-    if(!use_regex_)
+    if(use_regex_)
+      regex_ = std::make_shared<const std::regex>(condition_);
+    else
       std::transform(condition_.begin(),
                      condition_.end(),
                      condition_.begin(),
@@ -86,6 +88,24 @@ bool TagConditionNode::evaluate(const std::vector<std::pair<std::string, std::st
   return evaluateOnce(files, results);
 }
 
+bool TagConditionNode::evaluate(const std::function<bool(int)>& condition_result) const
+{
+  bool result = false;
+  if(type_ == Type::file_matcher || type_ == Type::path_matcher)
+    result = condition_result(condition_id_);
+  else if(type_ == Type::or_connector)
+    result = str::any_of(children_,
+                         [&condition_result](const auto& child)
+                         { return child.evaluate(condition_result); });
+  else if(type_ == Type::and_connector)
+    result = str::all_of(children_,
+                         [&condition_result](const auto& child)
+                         { return child.evaluate(condition_result); });
+  else // type_ == Type::empty
+    return false;
+  return invert_ ? !result : result;
+}
+
 bool TagConditionNode::evaluateOnce(const std::vector<std::pair<std::string, std::string>>& files,
                                     std::map<int, bool>& results) const
 {
@@ -107,7 +127,7 @@ bool TagConditionNode::evaluateWithoutInversion(
     {
       std::string target = type_ == Type::file_matcher ? file_name : path;
       if(use_regex_)
-        result = std::regex_match(target, std::regex(condition_));
+        result = std::regex_match(target, *regex_);
       else
       {
         std::transform(target.begin(),
@@ -7,7 +7,10 @@
 
 #include "tagcondition.h"
 #include <filesystem>
+#include <functional>
 #include <map>
+#include <memory>
+#include <regex>
 #include <vector>
 
 
@@ -50,6 +53,14 @@ public:
    * \return True if the directory satisfies the expression.
    */
   bool evaluate(const std::vector<std::pair<std::string, std::string>>& files) const;
+  /*!
+   * \brief Evaluates the boolean expression modeled by this tree for the given results of
+   * its conditions. Inversions of conditions are applied by this tree.
+   * \param condition_result Returns whether or not any file matches the condition with the
+   * given index.
+   * \return True if the expression is satisfied.
+   */
+  bool evaluate(const std::function<bool(int)>& condition_result) const;
   /*!
    * \brief Removes all outer parentheses that serve no semantic purpose in the given expression.
    * \param expression Expression to be modified.
@@ -86,6 +97,8 @@ private:
    *  Else: Use a simple string matcher with * as a wildcard.
    */
   bool use_regex_;
+  /*! \brief If use_regex_ is true: The compiled regex, shared between copies of this node. */
+  std::shared_ptr<const std::regex> regex_;
 
   /*!
    * \brief Checks if files in the given vector satisfy
@@ -0,0 +1,159 @@
+#include "tagevaluationplan.h"
+#include "wildcardmatching.h"
+#include <algorithm>
+#include <ranges>
+
+namespace str = std::ranges;
+
+
+TagEvaluationPlan::ModEvaluation::ModEvaluation(const TagEvaluationPlan& plan) :
+  plan_(plan), condition_results_(plan.num_conditions_, false),
+  num_unsatisfied_conditions_(plan.num_conditions_), occurrences_(plan.matcher_.getNumPatterns())
+{}
+
+void TagEvaluationPlan::ModEvaluation::addFile(std::string_view path)
+{
+  if(num_unsatisfied_conditions_ == 0)
+    return;
+  auto satisfy = [this](int condition_id)
+  {
+    if(condition_results_[condition_id])
+      return;
+    condition_results_[condition_id] = true;
+    num_unsatisfied_conditions_--;
+  };
+  for(int condition_id : plan_.match_all_conditions_)
+    satisfy(condition_id);
+
+  const size_t separator = path.rfind('/');
+  const int name_start = separator == std::string_view::npos ? 0 : separator + 1;
+  lower_case_path_.assign(path);
+  str::transform(lower_case_path_,
+                 lower_case_path_.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  plan_.matcher_.findAll(lower_case_path_,
+                         [this](int pattern_id, int start)
+                         {
+                           if(occurrences_[pattern_id].empty())
+                             found_patterns_.push_back(pattern_id);
+                           occurrences_[pattern_id].push_back(start);
+                         });
+  for(int pattern_id : found_patterns_)
+  {
+    for(int index : plan_.conditions_by_first_pattern_[pattern_id])
+    {
+      const auto& condition = plan_.wildcard_conditions_[index];
+      if(condition_results_[condition.condition_id])
+        continue;
+      const int target_start = condition.use_file_name ? name_start : 0;
+      if(plan_.wildcardConditionMatches(
+           condition, occurrences_, target_start, lower_case_path_.size()))
+        satisfy(condition.condition_id);
+    }
+  }
+  for(int pattern_id : found_patterns_)
+    occurrences_[pattern_id].clear();
+  found_patterns_.clear();
+
+  for(const auto& condition : plan_.regex_conditions_)
+  {
+    if(condition_results_[condition.condition_id])
+      continue;
+    const auto target_begin = path.begin() + (condition.use_file_name ? name_start : 0);
+    if(std::regex_match(target_begin, path.end(), *condition.regex))
+      satisfy(condition.condition_id);
+  }
+}
+
+std::vector<bool> TagEvaluationPlan::ModEvaluation::getResults() const
+{
+  std::vector<bool> results;
+  results.reserve(plan_.evaluators_.size());
+  for(int tag = 0; tag < plan_.evaluators_.size(); tag++)
+  {
+    const int offset = plan_.condition_offsets_[tag];
+    results.push_back(plan_.evaluators_[tag].evaluate(
+      [this, offset](int condition_id) { return condition_results_[offset + condition_id]; }));
+  }
+  return results;
+}
+
+TagEvaluationPlan::TagEvaluationPlan(const std::vector<const AutoTag*>& tags)
+{
+  for(const AutoTag* tag : tags)
+  {
+    evaluators_.push_back(tag->getEvaluator());
+    condition_offsets_.push_back(num_conditions_);
+    for(const auto& condition : tag->getConditions())
+    {
+      const int condition_id = num_conditions_++;
+      const bool use_file_name = condition.condition_type == TagCondition::Type::file_name;
+      if(condition.use_regex)
+      {
+        auto regex = std::make_shared<const std::regex>(condition.search_string);
+        regex_conditions_.push_back({ condition_id, use_file_name, std::move(regex) });
+        continue;
+      }
+      std::string search_string = condition.search_string;
+      str::transform(
+        search_string, search_string.begin(), [](unsigned char c) { return std::tolower(c); });
+      // empty conditions never match, see wildcardMatch
+      if(search_string.empty())
+        continue;
+      if(search_string.find_first_not_of('*') == std::string::npos)
+      {
+        match_all_conditions_.push_back(condition_id);
+        continue;
+      }
+      WildcardCondition wildcard_condition{
+        condition_id, use_file_name, {}, search_string.front() != '*', search_string.back() != '*'
+      };
+      for(const auto& part : splitString(search_string))
+        wildcard_condition.pattern_ids.push_back(matcher_.addPattern(part));
+      wildcard_conditions_.push_back(std::move(wildcard_condition));
+    }
+  }
+  matcher_.compile();
+  conditions_by_first_pattern_.resize(matcher_.getNumPatterns());
+  for(const auto& [index, condition] : str::enumerate_view(wildcard_conditions_))
+    conditions_by_first_pattern_[condition.pattern_ids.front()].push_back(index);
+}
+
+std::vector<bool> TagEvaluationPlan::evaluate(
+  const std::vector<std::pair<std::string, std::string>>& files) const
+{
+  ModEvaluation evaluation(*this);
+  for(const auto& [path, file_name] : files)
+    evaluation.addFile(path);
+  return evaluation.getResults();
+}
+
+int TagEvaluationPlan::getNumTags() const
+{
+  return evaluators_.size();
+}
+
+bool TagEvaluationPlan::wildcardConditionMatches(const WildcardCondition& condition,
+                                                 const std::vector<std::vector<int>>& occurrences,
+                                                 int target_start,
+                                                 int target_end) const
+{
+  // mirrors wildcardMatch: all parts are matched greedily from left to right, without overlap
+  int position = target_start;
+  for(const auto& [index, pattern_id] : str::enumerate_view(condition.pattern_ids))
+  {
+    const auto& starts = occurrences[pattern_id];
+    auto iter = str::lower_bound(starts, position);
+    if(iter == starts.end() || index == 0 && condition.anchored_start && *iter != target_start)
+      return false;
+    position = *iter + matcher_.getPatternLength(pattern_id);
+  }
+  if(condition.anchored_end)
+  {
+    const int last_pattern = condition.pattern_ids.back();
+    const int last_start = target_end - matcher_.getPatternLength(last_pattern);
+    if(last_start < target_start || !str::binary_search(occurrences[last_pattern], last_start))
+      return false;
+  }
+  return true;
+}
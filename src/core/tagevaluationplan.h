@@ -0,0 +1,142 @@
+/*!
+ * \file tagevaluationplan.h
+ * \brief Header for the TagEvaluationPlan class.
+ */
+
+#pragma once
+
+#include "autotag.h"
+#include "multipatternmatcher.h"
+#include <memory>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+/*!
+ * \brief Evaluates the conditions of many AutoTag objects at once.
+ *
+ * All wildcard conditions of all tags are split into their literal parts, which are combined
+ * in a single MultiPatternMatcher. Every file is then scanned once for all tags and a
+ * wildcard condition is only checked for files which contain its first literal part.
+ * Regular expressions are compiled once when the plan is created.
+ */
+class TagEvaluationPlan
+{
+public:
+  /*!
+   * \brief Accumulates the results of all conditions for the files of one mod.
+   * An object of this class must not outlive the plan it was created from.
+   */
+  class ModEvaluation
+  {
+  public:
+    /*!
+     * \brief Creates an evaluation in which no file matches any condition.
+     * \param plan Plan used for the evaluation.
+     */
+    ModEvaluation(const TagEvaluationPlan& plan);
+
+    /*!
+     * \brief Checks all conditions which have not yet been satisfied against the given file.
+     * \param path Path to the file, relative to the mods root directory.
+     */
+    void addFile(std::string_view path);
+    /*!
+     * \brief Evaluates the expressions of all tags in the plan.
+     * \return For every tag in the plan: True if the mod should have that tag.
+     */
+    std::vector<bool> getResults() const;
+
+  private:
+    /*! \brief Plan used for the evaluation. */
+    const TagEvaluationPlan& plan_;
+    /*! \brief For every condition: Whether or not at least one file satisfies it. */
+    std::vector<char> condition_results_;
+    /*! \brief Number of conditions which have not yet been satisfied. */
+    int num_unsatisfied_conditions_;
+    /*! \brief Lower case version of the current file path. */
+    std::string lower_case_path_;
+    /*! \brief For every pattern: Start positions of all occurrences in the current file. */
+    std::vector<std::vector<int>> occurrences_;
+    /*! \brief Patterns which occur in the current file. */
+    std::vector<int> found_patterns_;
+  };
+
+  /*!
+   * \brief Compiles the conditions of the given tags.
+   * \param tags Tags to evaluate. Only the tags conditions and expression are used, so the
+   * tags may be modified or destroyed after the plan has been created.
+   */
+  TagEvaluationPlan(const std::vector<const AutoTag*>& tags);
+
+  /*!
+   * \brief Evaluates all tags for the given files.
+   * \param files Contains pairs of path and file names for all files of a mod.
+   * \return For every tag: True if the mod should have that tag.
+   */
+  std::vector<bool> evaluate(const std::vector<std::pair<std::string, std::string>>& files) const;
+  /*!
+   * \brief Returns the number of tags in this plan.
+   * \return The number of tags.
+   */
+  int getNumTags() const;
+
+private:
+  /*! \brief A condition using case insensitive matching with * as a wildcard. */
+  struct WildcardCondition
+  {
+    /*! \brief Index of this condition in the plans condition list. */
+    int condition_id;
+    /*! \brief If true: Match against the file name, else against the full path. */
+    bool use_file_name;
+    /*! \brief Ids of the literal parts separated by wildcards, in order. */
+    std::vector<int> pattern_ids;
+    /*! \brief If true: The first part must appear at the start of the target. */
+    bool anchored_start;
+    /*! \brief If true: The last part must appear at the end of the target. */
+    bool anchored_end;
+  };
+
+  /*! \brief A condition using regex matching. */
+  struct RegexCondition
+  {
+    /*! \brief Index of this condition in the plans condition list. */
+    int condition_id;
+    /*! \brief If true: Match against the file name, else against the full path. */
+    bool use_file_name;
+    /*! \brief The compiled regex. */
+    std::shared_ptr<const std::regex> regex;
+  };
+
+  /*! \brief Used to evaluate the expression of every tag. */
+  std::vector<TagConditionNode> evaluators_;
+  /*! \brief For every tag: Index of its first condition in the plans condition list. */
+  std::vector<int> condition_offsets_;
+  /*! \brief Total number of conditions of all tags. */
+  int num_conditions_ = 0;
+  /*! \brief Ids of conditions which match every file, e.g. "*". */
+  std::vector<int> match_all_conditions_;
+  /*! \brief All wildcard conditions with at least one literal part. */
+  std::vector<WildcardCondition> wildcard_conditions_;
+  /*! \brief For every pattern: Wildcard conditions the first part of which is that pattern. */
+  std::vector<std::vector<int>> conditions_by_first_pattern_;
+  /*! \brief All regex conditions. */
+  std::vector<RegexCondition> regex_conditions_;
+  /*! \brief Finds literal parts of all wildcard conditions. */
+  MultiPatternMatcher matcher_;
+
+  /*!
+   * \brief Checks if the given wildcard condition matches a target string.
+   * \param condition Condition to check.
+   * \param occurrences For every pattern: Start positions of all occurrences in the path.
+   * \param target_start Start position of the target in the path.
+   * \param target_end End position of the target in the path.
+   * \return True if the condition matches.
+   */
+  bool wildcardConditionMatches(const WildcardCondition& condition,
+                                const std::vector<std::vector<int>>& occurrences,
+                                int target_start,
+                                int target_end) const;
+};
@@ -101,12 +101,10 @@ bool performDownload(ImportModInfo& info, ApplicationManager* app_mgr)
   return true;
 }
 
-bool performExtraction(ImportModInfo& info, ApplicationManager* app_mgr)
+bool performExtraction(ImportModInfo& info, ProgressNode* progress_node)
 {
   info.last_action_was_successful = false;
-  auto progress_callback = [app_mgr](float progress) { app_mgr->sendUpdateProgress(progress); };
-  ProgressNode node(progress_callback);
-  Installer::extract(info.local_source, info.target_path, &node);
+  Installer::extract(info.local_source, info.target_path, progress_node);
   info.current_path = info.target_path;
   info.last_action_was_successful = true;
   return true;
@@ -119,6 +117,8 @@ ApplicationManager::ApplicationManager(QObject* parent) : QObject{ parent }
   number_of_instances_++;
   Installer::log = [app_mgr = this](Log::LogLevel log_level, const std::string& message)
   { app_mgr->sendLogMessage(log_level, message); };
+  scheduler_.setLog([app_mgr = this](Log::LogLevel log_level, const std::string& message)
+                    { app_mgr->sendLogMessage(log_level, message); });
 }
 
 ApplicationManager::~ApplicationManager()
@@ -274,6 +274,33 @@ bool ApplicationManager::deployerIndexIsValid(int app_id, int deployer, bool sho
   return false;
 }
 
+void ApplicationManager::runJob(int app_id,
+                                JobScheduler::Access access,
+                                std::function<void()> job,
+                                JobScheduler::Priority priority)
+{
+  if(throw_exceptions_)
+  {
+    job();
+    return;
+  }
+  scheduler_.submit(
+    app_id,
+    access,
+    [this, app_id, access, job](std::stop_token stop_token, ProgressNode&)
+    {
+      if(access == JobScheduler::write_access && app_id == JobScheduler::ALL_APPS)
+      {
+        for(auto& app : apps_)
+          app.setStopToken(stop_token);
+      }
+      else if(access == JobScheduler::write_access && app_id >= 0 && app_id < apps_.size())
+        apps_[app_id].setStopToken(stop_token);
+      job();
+    },
+    priority);
+}
+
 void ApplicationManager::handleAddAppError(int code, sfs::path staging_dir)
 {
   if(code == 1)
@@ -329,407 +356,668 @@ void ApplicationManager::sendLogMessage(Log::LogLevel level, QString message)
 
 void ApplicationManager::addApplication(EditApplicationInfo info)
 {
-  sfs::path staging_dir{ info.staging_dir };
-  int code = ModdedApplication::verifyStagingDir(staging_dir);
-  if(code == 0)
-  {
-    try
+  runJob(
+    JobScheduler::ALL_APPS,
+    JobScheduler::write_access,
+    [=, this]() mutable
     {
-      apps_.emplace_back(staging_dir, info.name, info.command, info.icon_path, info.app_version);
-      apps_.back().setProgressCallback([app_mgr = this](float p)
-                                       { app_mgr->sendUpdateProgress(p); });
-      apps_.back().setLog([app_mgr = this](Log::LogLevel log_level, const std::string& message)
-                          { app_mgr->sendLogMessage(log_level, message); });
-
-      for(const auto& depl_info : info.deployers)
-        apps_.back().addDeployer(depl_info);
-      apps_.back().fixInvalidHardLinkDeployers();
-      for(const auto& tag : info.auto_tags)
-        apps_.back().addAutoTag(tag, true);
-      updateSettings();
-      emit completedOperations("Application added");
-    }
-    catch(Json::RuntimeError& error)
-    {
-      handleParseError(staging_dir / ModdedApplication::CONFIG_FILE_NAME, error.what());
-    }
-    catch(Json::LogicError& error)
-    {
-      handleParseError(staging_dir / ModdedApplication::CONFIG_FILE_NAME, error.what());
-    }
-    catch(ParseError& error)
-    {
-      handleParseError(staging_dir / ModdedApplication::CONFIG_FILE_NAME, error.what());
-    }
-    catch(sfs::filesystem_error& error)
-    {
-      handleParseError((staging_dir / ModdedApplication::CONFIG_FILE_NAME).string(), error.what());
-    }
-    catch(std::runtime_error& error)
-    {
-      handleParseError((staging_dir / ModdedApplication::CONFIG_FILE_NAME).string(), error.what());
-    }
-    catch(std::invalid_argument& error)
-    {
-      handleParseError((staging_dir / ModdedApplication::CONFIG_FILE_NAME).string(), error.what());
-    }
-    catch(std::logic_error& error)
-    {
-      handleParseError((staging_dir / ModdedApplication::CONFIG_FILE_NAME).string(), error.what());
-    }
-    catch(...)
-    {
-      handleParseError((staging_dir / ModdedApplication::CONFIG_FILE_NAME).string(),
-                       "Unexpected error while adding application!");
-    }
-  }
-  else
-    handleAddAppError(code, staging_dir);
+      sfs::path staging_dir{ info.staging_dir };
+      int code = ModdedApplication::verifyStagingDir(staging_dir);
+      if(code == 0)
+      {
+        try
+        {
+          apps_.emplace_back(
+            staging_dir, info.name, info.command, info.icon_path, info.app_version);
+          apps_.back().setProgressCallback([app_mgr = this](float p)
+                                           { app_mgr->sendUpdateProgress(p); });
+          apps_.back().setLog([app_mgr = this](Log::LogLevel log_level, const std::string& message)
+                              { app_mgr->sendLogMessage(log_level, message); });
+
+          for(const auto& depl_info : info.deployers)
+            apps_.back().addDeployer(depl_info);
+          apps_.back().fixInvalidHardLinkDeployers();
+          for(const auto& tag : info.auto_tags)
+            apps_.back().addAutoTag(tag, true);
+          updateSettings();
+          emit completedOperations("Application added");
+        }
+        catch(Json::RuntimeError& error)
+        {
+          handleParseError(staging_dir / ModdedApplication::CONFIG_FILE_NAME, error.what());
+        }
+        catch(Json::LogicError& error)
+        {
+          handleParseError(staging_dir / ModdedApplication::CONFIG_FILE_NAME, error.what());
+        }
+        catch(ParseError& error)
+        {
+          handleParseError(staging_dir / ModdedApplication::CONFIG_FILE_NAME, error.what());
+        }
+        catch(sfs::filesystem_error& error)
+        {
+          handleParseError((staging_dir / ModdedApplication::CONFIG_FILE_NAME).string(),
+                           error.what());
+        }
+        catch(std::runtime_error& error)
+        {
+          handleParseError((staging_dir / ModdedApplication::CONFIG_FILE_NAME).string(),
+                           error.what());
+        }
+        catch(std::invalid_argument& error)
+        {
+          handleParseError((staging_dir / ModdedApplication::CONFIG_FILE_NAME).string(),
+                           error.what());
+        }
+        catch(std::logic_error& error)
+        {
+          handleParseError((staging_dir / ModdedApplication::CONFIG_FILE_NAME).string(),
+                           error.what());
+        }
+        catch(...)
+        {
+          handleParseError((staging_dir / ModdedApplication::CONFIG_FILE_NAME).string(),
+                           "Unexpected error while adding application!");
+        }
+      }
+      else
+        handleAddAppError(code, staging_dir);
+    });
 }
 
 void ApplicationManager::removeApplication(int app_id, bool cleanup)
 {
-  if(!appIndexIsValid(app_id))
-    return;
-  if(cleanup)
-    handleExceptions<&ModdedApplication::deleteAllData>(app_id);
-  apps_.erase(apps_.begin() + app_id);
-  updateSettings();
+  runJob(
+    JobScheduler::ALL_APPS,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(!appIndexIsValid(app_id))
+        return;
+      if(cleanup)
+        handleExceptions<&ModdedApplication::deleteAllData>(app_id);
+      apps_.erase(apps_.begin() + app_id);
+      updateSettings();
+    });
 }
 
 void ApplicationManager::deployMods(int app_id)
 {
-  if(appIndexIsValid(app_id))
-  {
-    auto ret_val = handleExceptions(&ModdedApplication::verifyDeployerDirectories, apps_[app_id]);
-    if(ret_val)
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
     {
-      auto [code, path, message] = *ret_val;
-      handleAddDeployerError(code, apps_[app_id].getStagingDir(), path, message);
-      if(code == 0)
-        handleExceptions<&ModdedApplication::deployMods>(app_id);
-    }
-  }
-  emit completedOperations("Mods deployed");
+      if(appIndexIsValid(app_id))
+      {
+        auto ret_val =
+          handleExceptions(&ModdedApplication::verifyDeployerDirectories, apps_[app_id]);
+        if(ret_val)
+        {
+          auto [code, path, message] = *ret_val;
+          handleAddDeployerError(code, apps_[app_id].getStagingDir(), path, message);
+          if(code == 0)
+            handleExceptions<&ModdedApplication::deployMods>(app_id);
+        }
+      }
+      emit completedOperations("Mods deployed");
+    });
 }
 
 void ApplicationManager::deployModsFor(int app_id, std::vector<int> deployer_ids)
 {
-  if(appIndexIsValid(app_id))
-  {
-    for(int deployer : deployer_ids)
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
     {
-      if(!deployerIndexIsValid(app_id, deployer))
+      if(appIndexIsValid(app_id))
       {
-        emit completedOperations();
-        return;
+        for(int deployer : deployer_ids)
+        {
+          if(!deployerIndexIsValid(app_id, deployer))
+          {
+            emit completedOperations();
+            return;
+          }
+        }
+        auto ret_val =
+          handleExceptions(&ModdedApplication::verifyDeployerDirectories, apps_[app_id]);
+        if(ret_val)
+        {
+          auto [code, path, message] = *ret_val;
+          handleAddDeployerError(code, apps_[app_id].getStagingDir(), path, message);
+          if(code == 0)
+            handleExceptions<&ModdedApplication::deployModsFor>(app_id, deployer_ids);
+        }
       }
-    }
-    auto ret_val = handleExceptions(&ModdedApplication::verifyDeployerDirectories, apps_[app_id]);
-    if(ret_val)
-    {
-      auto [code, path, message] = *ret_val;
-      handleAddDeployerError(code, apps_[app_id].getStagingDir(), path, message);
-      if(code == 0)
-        handleExceptions<&ModdedApplication::deployModsFor>(app_id, deployer_ids);
-    }
-  }
-  emit completedOperations("Mods deployed");
+      emit completedOperations("Mods deployed");
+    });
 }
 
 void ApplicationManager::unDeployMods(int app_id)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::unDeployMods>(app_id);
-  emit completedOperations("Mods undeployed");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::unDeployMods>(app_id);
+      emit completedOperations("Mods undeployed");
+    });
 }
 
 void ApplicationManager::unDeployModsFor(int app_id, std::vector<int> deployer_ids)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::unDeployModsFor>(app_id, deployer_ids);
-  emit completedOperations("Mods undeployed");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::unDeployModsFor>(app_id, deployer_ids);
+      emit completedOperations("Mods undeployed");
+    });
 }
 
 void ApplicationManager::installMod(int app_id, ImportModInfo info)
 {
-  bool has_thrown = false;
-  if(appIndexIsValid(app_id))
-  {
-    has_thrown = handleExceptions<&ModdedApplication::installMod>(app_id, info);
-    if(has_thrown)
-      handleExceptions<&ModdedApplication::cleanupFailedInstallation>(app_id);
-  }
-  emit modInstallationComplete(!has_thrown);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      bool has_thrown = false;
+      if(appIndexIsValid(app_id))
+      {
+        has_thrown = handleExceptions<&ModdedApplication::installMod>(app_id, info);
+        if(has_thrown)
+          handleExceptions<&ModdedApplication::cleanupFailedInstallation>(app_id);
+      }
+      emit modInstallationComplete(!has_thrown);
+    });
 }
 
 void ApplicationManager::uninstallMods(int app_id,
                                        std::vector<int> mod_ids,
                                        std::string installer_type)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::uninstallMods>(app_id, mod_ids, installer_type);
-  emit completedOperations(std::format("Mod{} removed", mod_ids.size() == 1 ? "" : "s").c_str());
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::uninstallMods>(app_id, mod_ids, installer_type);
+      emit completedOperations(
+        std::format("Mod{} removed", mod_ids.size() == 1 ? "" : "s").c_str());
+    });
 }
 
 void ApplicationManager::changeLoadorder(int app_id, int deployer, int from_idx, int to_idx)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-    handleExceptions<&ModdedApplication::changeLoadorder>(app_id, deployer, from_idx, to_idx);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+        handleExceptions<&ModdedApplication::changeLoadorder>(app_id, deployer, from_idx, to_idx);
+    });
 }
 
 void ApplicationManager::updateModDeployers(int app_id,
                                             std::vector<int> mod_ids,
                                             std::vector<bool> deployers)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::updateModDeployers>(app_id, mod_ids, deployers);
-  emit completedOperations("Deployers updated");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::updateModDeployers>(app_id, mod_ids, deployers);
+      emit completedOperations("Deployers updated");
+    });
 }
 
 void ApplicationManager::removeModFromDeployer(int app_id, int deployer, int mod_id)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-    handleExceptions<&ModdedApplication::removeModFromDeployer>(
-      app_id, deployer, mod_id, true, std::optional<ProgressNode*>{});
-  emit completedOperations("Deployers updated");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+        handleExceptions<&ModdedApplication::removeModFromDeployer>(
+          app_id, deployer, mod_id, true, std::optional<ProgressNode*>{});
+      emit completedOperations("Deployers updated");
+    });
 }
 
 void ApplicationManager::setModStatus(int app_id, int deployer, int mod_id, bool status)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-    handleExceptions<&ModdedApplication::setModStatus>(app_id, deployer, mod_id, status);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+        handleExceptions<&ModdedApplication::setModStatus>(app_id, deployer, mod_id, status);
+    });
 }
 
 void ApplicationManager::addDeployer(int app_id, EditDeployerInfo info)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::addDeployer>(app_id, info);
-  emit completedOperations("Deployer added");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::addDeployer>(app_id, info);
+      emit completedOperations("Deployer added");
+    });
 }
 
 void ApplicationManager::removeDeployer(int app_id, int deployer, bool cleanup)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-    handleExceptions<&ModdedApplication::removeDeployer>(app_id, deployer, cleanup);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+        handleExceptions<&ModdedApplication::removeDeployer>(app_id, deployer, cleanup);
+    });
 }
 
 void ApplicationManager::getDeployerNames(int app_id, bool is_new)
 {
-  QStringList names{};
-  if(appIndexIsValid(app_id, false))
-  {
-    for(const auto& name : apps_[app_id].getDeployerNames())
-      names << name.c_str();
-  }
-  emit sendDeployerNames(names, is_new);
+  runJob(
+    app_id,
+    JobScheduler::read_access,
+    [=, this]() mutable
+    {
+      QStringList names{};
+      if(appIndexIsValid(app_id, false))
+      {
+        for(const auto& name : apps_[app_id].getDeployerNames())
+          names << name.c_str();
+      }
+      emit sendDeployerNames(names, is_new);
+    },
+    JobScheduler::high_priority);
 }
 
 void ApplicationManager::getModInfo(int app_id)
 {
-  if(appIndexIsValid(app_id, false))
-  {
-    auto info = handleExceptions(&ModdedApplication::getModInfo, apps_[app_id]);
-    if(info)
+  runJob(
+    app_id,
+    JobScheduler::read_access,
+    [=, this]() mutable
     {
-      emit sendModInfo(*info);
-      return;
-    }
-  }
-  emit sendModInfo(std::vector<ModInfo>{});
+      if(appIndexIsValid(app_id, false))
+      {
+        auto info = handleExceptions(&ModdedApplication::getModInfo, apps_[app_id]);
+        if(info)
+        {
+          emit sendModInfo(*info);
+          return;
+        }
+      }
+      emit sendModInfo(std::vector<ModInfo>{});
+    },
+    JobScheduler::high_priority);
 }
 
 void ApplicationManager::getDeployerInfo(int app_id, int deployer)
 {
-  if(appIndexIsValid(app_id, false) && deployerIndexIsValid(app_id, deployer, false))
-  {
-    auto info = handleExceptions(&ModdedApplication::getDeployerInfo, apps_[app_id], deployer);
-    if(info)
+  runJob(
+    app_id,
+    JobScheduler::read_access,
+    [=, this]() mutable
     {
-      emit sendDeployerInfo(*info);
-      return;
-    }
-  }
-  emit sendDeployerInfo(DeployerInfo{});
+      if(appIndexIsValid(app_id, false) && deployerIndexIsValid(app_id, deployer, false))
+      {
+        auto info = handleExceptions(&ModdedApplication::getDeployerInfo, apps_[app_id], deployer);
+        if(info)
+        {
+          emit sendDeployerInfo(*info);
+          return;
+        }
+      }
+      emit sendDeployerInfo(DeployerInfo{});
+    },
+    JobScheduler::high_priority);
 }
 
 void ApplicationManager::getApplicationNames(bool is_new)
 {
-  QStringList names{};
-  QStringList icon_paths{};
-  for(const auto& app : apps_)
-  {
-    names.append(app.name().c_str());
-    icon_paths.append(app.iconPath().string().c_str());
-  }
-  emit sendApplicationNames(names, icon_paths, is_new);
+  runJob(
+    JobScheduler::ALL_APPS,
+    JobScheduler::read_access,
+    [=, this]() mutable
+    {
+      QStringList names{};
+      QStringList icon_paths{};
+      for(const auto& app : apps_)
+      {
+        names.append(app.name().c_str());
+        icon_paths.append(app.iconPath().string().c_str());
+      }
+      emit sendApplicationNames(names, icon_paths, is_new);
+    });
 }
 
 void ApplicationManager::changeModName(int app_id, int mod_id, QString new_name)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::changeModName>(app_id, mod_id, new_name.toStdString());
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::changeModName>(app_id, mod_id, new_name.toStdString());
+    });
 }
 
 void ApplicationManager::getFileConflicts(int app_id, int deployer, int mod_id, bool show_disabled)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-  {
-    auto conflicts = handleExceptions(
-      &ModdedApplication::getFileConflicts, apps_[app_id], deployer, mod_id, show_disabled);
-    if(conflicts)
-      emit sendFileConflicts(*conflicts);
-  }
-  emit completedOperations();
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+      {
+        auto conflicts = handleExceptions(
+          &ModdedApplication::getFileConflicts, apps_[app_id], deployer, mod_id, show_disabled);
+        if(conflicts)
+          emit sendFileConflicts(*conflicts);
+      }
+      emit completedOperations();
+    },
+    JobScheduler::high_priority);
 }
 
 void ApplicationManager::getAppInfo(int app_id)
 {
-  if(!appIndexIsValid(app_id, false))
-  {
-    emit sendAppInfo(AppInfo{});
-    return;
-  }
-  emit sendAppInfo(apps_[app_id].getAppInfo());
+  runJob(
+    app_id,
+    JobScheduler::read_access,
+    [=, this]() mutable
+    {
+      if(!appIndexIsValid(app_id, false))
+      {
+        emit sendAppInfo(AppInfo{});
+        return;
+      }
+      emit sendAppInfo(apps_[app_id].getAppInfo());
+    },
+    JobScheduler::high_priority);
 }
 
 void ApplicationManager::addTool(int app_id, Tool tool)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::addTool>(app_id, tool);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::addTool>(app_id, tool);
+    });
 }
 
 void ApplicationManager::removeTool(int app_id, int tool_id)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::removeTool>(app_id, tool_id);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::removeTool>(app_id, tool_id);
+    });
 }
 
 void ApplicationManager::editApplication(EditApplicationInfo info, int app_id)
 {
-  if(appIndexIsValid(app_id))
-  {
-    if(!handleExceptions<&ModdedApplication::setStagingDir>(
-         app_id, info.staging_dir, info.move_staging_dir))
+  runJob(
+    JobScheduler::ALL_APPS,
+    JobScheduler::write_access,
+    [=, this]() mutable
     {
-      handleExceptions<&ModdedApplication::setName>(app_id, info.name);
-      handleExceptions<&ModdedApplication::setCommand>(app_id, info.command);
-      handleExceptions<&ModdedApplication::setIconPath>(app_id, info.icon_path);
-      handleExceptions<&ModdedApplication::setAppVersion>(app_id, info.app_version);
-    }
-    updateSettings();
-  }
+      if(appIndexIsValid(app_id))
+      {
+        if(!handleExceptions<&ModdedApplication::setStagingDir>(
+             app_id, info.staging_dir, info.move_staging_dir))
+        {
+          handleExceptions<&ModdedApplication::setName>(app_id, info.name);
+          handleExceptions<&ModdedApplication::setCommand>(app_id, info.command);
+          handleExceptions<&ModdedApplication::setIconPath>(app_id, info.icon_path);
+          handleExceptions<&ModdedApplication::setAppVersion>(app_id, info.app_version);
+        }
+        updateSettings();
+      }
+    });
 }
 
 void ApplicationManager::editDeployer(EditDeployerInfo info, int app_id, int deployer)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-    handleExceptions<&ModdedApplication::editDeployer>(app_id, deployer, info);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+        handleExceptions<&ModdedApplication::editDeployer>(app_id, deployer, info);
+    });
 }
 
 void ApplicationManager::getModConflicts(int app_id, int deployer, int mod_id)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-  {
-    auto conflicts =
-      handleExceptions(&ModdedApplication::getModConflicts, apps_[app_id], deployer, mod_id);
-    if(conflicts)
-      emit sendModConflicts(*conflicts);
-  }
-  emit completedOperations();
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+      {
+        auto conflicts =
+          handleExceptions(&ModdedApplication::getModConflicts, apps_[app_id], deployer, mod_id);
+        if(conflicts)
+          emit sendModConflicts(*conflicts);
+      }
+      emit completedOperations();
+    },
+    JobScheduler::high_priority);
 }
 
 void ApplicationManager::setProfile(int app_id, int profile)
 {
-  if(appIndexIsValid(app_id, false))
-    handleExceptions<&ModdedApplication::setProfile>(app_id, profile);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id, false))
+        handleExceptions<&ModdedApplication::setProfile>(app_id, profile);
+    });
 }
 
 void ApplicationManager::addProfile(int app_id, EditProfileInfo info)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::addProfile>(app_id, info);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::addProfile>(app_id, info);
+    });
 }
 
 void ApplicationManager::removeProfile(int app_id, int profile)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::removeProfile>(app_id, profile);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::removeProfile>(app_id, profile);
+    });
 }
 
 void ApplicationManager::getProfileNames(int app_id, bool is_new)
 {
-  QStringList names{};
-  if(appIndexIsValid(app_id, false))
-  {
-    for(const auto& name : apps_[app_id].getProfileNames())
-      names << name.c_str();
-  }
-  emit sendProfileNames(names, is_new);
+  runJob(
+    app_id,
+    JobScheduler::read_access,
+    [=, this]() mutable
+    {
+      QStringList names{};
+      if(appIndexIsValid(app_id, false))
+      {
+        for(const auto& name : apps_[app_id].getProfileNames())
+          names << name.c_str();
+      }
+      emit sendProfileNames(names, is_new);
+    },
+    JobScheduler::high_priority);
 }
 
 void ApplicationManager::editProfile(int app_id, int profile, EditProfileInfo info)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::editProfile>(app_id, profile, info);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::editProfile>(app_id, profile, info);
+    });
 }
 
 void ApplicationManager::editTool(int app_id, int tool_id, Tool new_tool)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::editTool>(app_id, tool_id, new_tool);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::editTool>(app_id, tool_id, new_tool);
+    });
 }
 
 void ApplicationManager::addModToGroup(int app_id, int mod_id, int group)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::addModToGroup>(
-      app_id, mod_id, group, std::optional<ProgressNode*>{});
-  emit completedOperations("Mod added to group");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::addModToGroup>(
+          app_id, mod_id, group, std::optional<ProgressNode*>{});
+      emit completedOperations("Mod added to group");
+    });
 }
 
 void ApplicationManager::removeModFromGroup(int app_id, int mod_id)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::removeModFromGroup>(
-      app_id, mod_id, true, std::optional<ProgressNode*>{});
-  emit completedOperations("Mod removed from group");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::removeModFromGroup>(
+          app_id, mod_id, true, std::optional<ProgressNode*>{});
+      emit completedOperations("Mod removed from group");
+    });
 }
 
 void ApplicationManager::createGroup(int app_id, int first_mod_id, int second_mod_id)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::createGroup>(
-      app_id, first_mod_id, second_mod_id, std::optional<ProgressNode*>{});
-  emit completedOperations("Mod added to group");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::createGroup>(
+          app_id, first_mod_id, second_mod_id, std::optional<ProgressNode*>{});
+      emit completedOperations("Mod added to group");
+    });
 }
 
 void ApplicationManager::changeActiveGroupMember(int app_id, int group, int mod_id)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::changeActiveGroupMember>(
-      app_id, group, mod_id, std::optional<ProgressNode*>{});
-  emit completedOperations();
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::changeActiveGroupMember>(
+          app_id, group, mod_id, std::optional<ProgressNode*>{});
+      emit completedOperations();
+    });
 }
 
 void ApplicationManager::changeModVersion(int app_id, int mod_id, QString new_version)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::changeModVersion>(
-      app_id, mod_id, new_version.toStdString());
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::changeModVersion>(
+          app_id, mod_id, new_version.toStdString());
+    });
 }
 
 void ApplicationManager::sortModsByConflicts(int app_id, int deployer)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-    handleExceptions<&ModdedApplication::sortModsByConflicts>(app_id, deployer);
-  emit completedOperations("Mods sorted");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+        handleExceptions<&ModdedApplication::sortModsByConflicts>(app_id, deployer);
+      emit completedOperations("Mods sorted");
+    });
 }
 
 void ApplicationManager::extractArchive(ImportModInfo info)
 {
-  handleExceptionsForFunction(performExtraction, info, this);
-  emit extractionComplete(info);
+  auto extract = [=, this](ProgressNode* progress_node) mutable
+  {
+    handleExceptionsForFunction(performExtraction, info, progress_node);
+    emit extractionComplete(info);
+  };
+  if(throw_exceptions_)
+  {
+    ProgressNode node([this](float progress) { sendUpdateProgress(progress); });
+    extract(&node);
+    return;
+  }
+  scheduler_.submit(JobScheduler::NO_APP,
+                    JobScheduler::write_access,
+                    [this, extract](std::stop_token stop_token, ProgressNode&) mutable
+                    {
+                      ProgressNode node([this](float progress) { sendUpdateProgress(progress); },
+                                        {},
+                                        stop_token);
+                      extract(&node);
+                    });
 }
 
 void ApplicationManager::addBackupTarget(int app_id,
@@ -738,63 +1026,113 @@ void ApplicationManager::addBackupTarget(int app_id,
                                          QString default_backup,
                                          QString first_backup)
 {
-  if(appIndexIsValid(app_id))
-  {
-    std::vector<std::string> backup_names{ default_backup.toStdString() };
-    if(!first_backup.isEmpty())
-      backup_names.push_back(first_backup.toStdString());
-    handleExceptions<&ModdedApplication::addBackupTarget>(
-      app_id, path.toStdString(), name.toStdString(), backup_names);
-  }
-  emit completedOperations("Backup target added");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+      {
+        std::vector<std::string> backup_names{ default_backup.toStdString() };
+        if(!first_backup.isEmpty())
+          backup_names.push_back(first_backup.toStdString());
+        handleExceptions<&ModdedApplication::addBackupTarget>(
+          app_id, path.toStdString(), name.toStdString(), backup_names);
+      }
+      emit completedOperations("Backup target added");
+    });
 }
 
 void ApplicationManager::removeBackupTarget(int app_id, int target_id)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::removeBackupTarget>(app_id, target_id);
-  emit completedOperations("Backup target removed");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::removeBackupTarget>(app_id, target_id);
+      emit completedOperations("Backup target removed");
+    });
 }
 
 void ApplicationManager::addBackup(int app_id, int target_id, QString name, int source)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::addBackup>(app_id, target_id, name.toStdString(), source);
-  emit completedOperations("Backup added");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::addBackup>(
+          app_id, target_id, name.toStdString(), source);
+      emit completedOperations("Backup added");
+    });
 }
 
 void ApplicationManager::removeBackup(int app_id, int target_id, int backup_id)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::removeBackup>(app_id, target_id, backup_id);
-  emit completedOperations("Backup removed");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::removeBackup>(app_id, target_id, backup_id);
+      emit completedOperations("Backup removed");
+    });
 }
 
 void ApplicationManager::setActiveBackup(int app_id, int target_id, int backup_id)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::setActiveBackup>(app_id, target_id, backup_id);
-  emit completedOperations();
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::setActiveBackup>(app_id, target_id, backup_id);
+      emit completedOperations();
+    });
 }
 
 void ApplicationManager::getBackupTargets(int app_id)
 {
-  if(appIndexIsValid(app_id))
-    emit sendBackupTargets(apps_[app_id].getBackupTargets());
+  runJob(
+    app_id,
+    JobScheduler::read_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        emit sendBackupTargets(apps_[app_id].getBackupTargets());
+    },
+    JobScheduler::high_priority);
 }
 
 void ApplicationManager::setBackupName(int app_id, int target_id, int backup_id, QString name)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::setBackupName>(
-      app_id, target_id, backup_id, name.toStdString());
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::setBackupName>(
+          app_id, target_id, backup_id, name.toStdString());
+    });
 }
 
 void ApplicationManager::setBackupTargetName(int app_id, int target_id, QString name)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::setBackupTargetName>(
-      app_id, target_id, name.toStdString());
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::setBackupTargetName>(
+          app_id, target_id, name.toStdString());
+    });
 }
 
 void ApplicationManager::overwriteBackup(int app_id,
@@ -802,10 +1140,16 @@ void ApplicationManager::overwriteBackup(int app_id,
                                          int source_backup,
                                          int dest_backup)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::overwriteBackup>(
-      app_id, target_id, source_backup, dest_backup);
-  emit completedOperations("Backup overwritten");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::overwriteBackup>(
+          app_id, target_id, source_backup, dest_backup);
+      emit completedOperations("Backup overwritten");
+    });
 }
 
 void ApplicationManager::onScrollLists()
@@ -815,94 +1159,160 @@ void ApplicationManager::onScrollLists()
 
 void ApplicationManager::uninstallGroupMembers(int app_id, const std::vector<int>& mod_ids)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::uninstallGroupMembers>(app_id, mod_ids);
-  emit completedOperations("Group members removed");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::uninstallGroupMembers>(app_id, mod_ids);
+      emit completedOperations("Group members removed");
+    });
 }
 
 void ApplicationManager::addManualTag(int app_id, QString tag_name)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::addManualTag>(app_id, tag_name.toStdString());
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::addManualTag>(app_id, tag_name.toStdString());
+    });
 }
 
 void ApplicationManager::removeManualTag(int app_id, QString tag_name)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::removeManualTag>(app_id, tag_name.toStdString(), true);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::removeManualTag>(app_id, tag_name.toStdString(), true);
+    });
 }
 
 void ApplicationManager::changeManualTagName(int app_id, QString old_name, QString new_name)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::changeManualTagName>(
-      app_id, old_name.toStdString(), new_name.toStdString(), true);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::changeManualTagName>(
+          app_id, old_name.toStdString(), new_name.toStdString(), true);
+    });
 }
 
 void ApplicationManager::addTagsToMods(int app_id,
                                        QStringList tag_names,
                                        const std::vector<int>& mod_ids)
 {
-  if(!appIndexIsValid(app_id))
-    return;
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(!appIndexIsValid(app_id))
+        return;
 
-  std::vector<std::string> tag_vector;
-  for(const auto& tag_name : tag_names)
-    tag_vector.push_back(tag_name.toStdString());
-  handleExceptions<&ModdedApplication::addTagsToMods>(app_id, tag_vector, mod_ids);
+      std::vector<std::string> tag_vector;
+      for(const auto& tag_name : tag_names)
+        tag_vector.push_back(tag_name.toStdString());
+      handleExceptions<&ModdedApplication::addTagsToMods>(app_id, tag_vector, mod_ids);
+    });
 }
 
 void ApplicationManager::removeTagsFromMods(int app_id,
                                             QStringList tag_names,
                                             const std::vector<int>& mod_ids)
 {
-  if(!appIndexIsValid(app_id))
-    return;
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(!appIndexIsValid(app_id))
+        return;
 
-  std::vector<std::string> tag_vector;
-  for(const auto& tag_name : tag_names)
-    tag_vector.push_back(tag_name.toStdString());
-  handleExceptions<&ModdedApplication::removeTagsFromMods>(app_id, tag_vector, mod_ids);
+      std::vector<std::string> tag_vector;
+      for(const auto& tag_name : tag_names)
+        tag_vector.push_back(tag_name.toStdString());
+      handleExceptions<&ModdedApplication::removeTagsFromMods>(app_id, tag_vector, mod_ids);
+    });
 }
 
 void ApplicationManager::setTagsForMods(int app_id,
                                         QStringList tag_names,
                                         const std::vector<int>& mod_ids)
 {
-  if(appIndexIsValid(app_id))
-  {
-    std::vector<std::string> string_vec;
-    for(const auto& name : tag_names)
-      string_vec.push_back(name.toStdString());
-    handleExceptions<&ModdedApplication::setTagsForMods>(app_id, string_vec, mod_ids);
-  }
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+      {
+        std::vector<std::string> string_vec;
+        for(const auto& name : tag_names)
+          string_vec.push_back(name.toStdString());
+        handleExceptions<&ModdedApplication::setTagsForMods>(app_id, string_vec, mod_ids);
+      }
+    });
 }
 
 void ApplicationManager::editManualTags(int app_id, std::vector<EditManualTagAction> actions)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::editManualTags>(app_id, actions);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::editManualTags>(app_id, actions);
+    });
 }
 
 void ApplicationManager::editAutoTags(int app_id, std::vector<EditAutoTagAction> actions)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::editAutoTags>(app_id, actions);
-  emit completedOperations("Auto tags updated");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::editAutoTags>(app_id, actions);
+      emit completedOperations("Auto tags updated");
+    });
 }
 
 void ApplicationManager::reapplyAutoTags(int app_id)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::reapplyAutoTags>(app_id);
-  emit completedOperations("Auto tags updated");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::reapplyAutoTags>(app_id);
+      emit completedOperations("Auto tags updated");
+    });
 }
 
 void ApplicationManager::updateAutoTags(int app_id, std::vector<int> mod_ids)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::updateAutoTags>(app_id, mod_ids);
-  emit completedOperations("Auto tags updated");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::updateAutoTags>(app_id, mod_ids);
+      emit completedOperations("Auto tags updated");
+    });
 }
 
 void ApplicationManager::editModSources(int app_id,
@@ -910,111 +1320,155 @@ void ApplicationManager::editModSources(int app_id,
                                         QString local_source,
                                         QString remote_source)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::setModSources>(
-      app_id, mod_id, local_source.toStdString(), remote_source.toStdString());
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::setModSources>(
+          app_id, mod_id, local_source.toStdString(), remote_source.toStdString());
+    });
 }
 
 void ApplicationManager::getNexusPage(int app_id, int mod_id)
 {
-  if(appIndexIsValid(app_id))
-  {
-    auto page = handleExceptions(&ModdedApplication::getNexusPage, apps_[app_id], mod_id);
-    if(page)
-      emit sendNexusPage(app_id, mod_id, *page);
-  }
-  emit completedOperations();
+  runJob(
+    app_id,
+    JobScheduler::read_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+      {
+        auto page = handleExceptions(&ModdedApplication::getNexusPage, apps_[app_id], mod_id);
+        if(page)
+          emit sendNexusPage(app_id, mod_id, *page);
+      }
+      emit completedOperations();
+    },
+    JobScheduler::high_priority);
 }
 
 void ApplicationManager::downloadMod(ImportModInfo info)
 {
-  info.last_action_was_successful = false;
-  if(!appIndexIsValid(info.app_id))
-  {
-    emit downloadFailed();
-    return;
-  }
-
-  if(info.remote_request_url.empty())
-  {
-    auto download_url = handleExceptionsForFunction(
-      static_cast<std::string (*)(const std::string&, long)>(nexus::Api::getDownloadUrl),
-      info.remote_source,
-      info.remote_file_id);
-    if(!download_url)
-    {
-      emit downloadFailed();
-      return;
-    }
-    info.remote_download_url = *download_url;
-  }
-  else
-  {
-    auto download_url = handleExceptionsForFunction(
-      static_cast<std::string (*)(const std::string&)>(nexus::Api::getDownloadUrl),
-      info.remote_request_url);
-    if(!download_url)
+  runJob(
+    info.app_id,
+    JobScheduler::read_access,
+    [=, this]() mutable
     {
-      emit downloadFailed();
-      return;
-    }
-    info.remote_download_url = *download_url;
-  }
-  info.remote_download_url = QUrl(info.remote_download_url.c_str()).toEncoded().toStdString();
+      info.last_action_was_successful = false;
+      if(!appIndexIsValid(info.app_id))
+      {
+        emit downloadFailed();
+        return;
+      }
 
-  auto init_successful = handleExceptionsForFunction(nexus::Api::initModInfo, info);
-  if(!init_successful || !(*init_successful))
-  {
-    emit downloadFailed();
-    return;
-  }
+      if(info.remote_request_url.empty())
+      {
+        auto download_url = handleExceptionsForFunction(
+          static_cast<std::string (*)(const std::string&, long)>(nexus::Api::getDownloadUrl),
+          info.remote_source,
+          info.remote_file_id);
+        if(!download_url)
+        {
+          emit downloadFailed();
+          return;
+        }
+        info.remote_download_url = *download_url;
+      }
+      else
+      {
+        auto download_url = handleExceptionsForFunction(
+          static_cast<std::string (*)(const std::string&)>(nexus::Api::getDownloadUrl),
+          info.remote_request_url);
+        if(!download_url)
+        {
+          emit downloadFailed();
+          return;
+        }
+        info.remote_download_url = *download_url;
+      }
+      info.remote_download_url = QUrl(info.remote_download_url.c_str()).toEncoded().toStdString();
 
-  info.target_path = apps_[info.app_id].getDownloadDir();
-  auto download_successful = handleExceptionsForFunction(performDownload, info, this);
-  if(!download_successful)
-  {
-    emit downloadFailed();
-    return;
-  }
+      auto init_successful = handleExceptionsForFunction(nexus::Api::initModInfo, info);
+      if(!init_successful || !(*init_successful))
+      {
+        emit downloadFailed();
+        return;
+      }
 
-  info.last_action_was_successful = true;
-  emit downloadComplete(info);
+      info.target_path = apps_[info.app_id].getDownloadDir();
+      auto download_successful = handleExceptionsForFunction(performDownload, info, this);
+      if(!download_successful)
+      {
+        emit downloadFailed();
+        return;
+      }
+
+      info.last_action_was_successful = true;
+      emit downloadComplete(info);
+    });
 }
 
 void ApplicationManager::checkForModUpdates(int app_id)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::checkForModUpdates>(app_id);
-  emit completedOperations();
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::checkForModUpdates>(app_id);
+      emit completedOperations();
+    });
 }
 
 void ApplicationManager::checkModsForUpdates(int app_id, const std::vector<int>& mod_ids)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::checkModsForUpdates>(app_id, mod_ids);
-  emit completedOperations();
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::checkModsForUpdates>(app_id, mod_ids);
+      emit completedOperations();
+    });
 }
 
 void ApplicationManager::suppressUpdateNotification(int app_id, const std::vector<int>& mod_ids)
 {
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::suppressUpdateNotification>(app_id, mod_ids);
-  emit completedOperations();
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::suppressUpdateNotification>(app_id, mod_ids);
+      emit completedOperations();
+    });
 }
 
 void ApplicationManager::getExternalChanges(int app_id, int deployer, bool deploy)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-  {
-    auto changes_info =
-      handleExceptions(&ModdedApplication::getExternalChanges, apps_[app_id], deployer);
-    if(!changes_info)
-      emit completedOperations("Checking for external changes failed");
-    else
-      emit sendExternalChangesInfo(app_id, *changes_info, apps_[app_id].getNumDeployers(), deploy);
-  }
-  else
-    emit completedOperations("Checking for external changes failed");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+      {
+        auto changes_info =
+          handleExceptions(&ModdedApplication::getExternalChanges, apps_[app_id], deployer);
+        if(!changes_info)
+          emit completedOperations("Checking for external changes failed");
+        else
+          emit sendExternalChangesInfo(
+            app_id, *changes_info, apps_[app_id].getNumDeployers(), deploy);
+      }
+      else
+        emit completedOperations("Checking for external changes failed");
+    });
 }
 
 void ApplicationManager::keepOrRevertFileModifications(int app_id,
@@ -1022,46 +1476,81 @@ void ApplicationManager::keepOrRevertFileModifications(int app_id,
                                                        const FileChangeChoices& changes_to_keep,
                                                        bool deploy)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-  {
-    const bool has_throw = handleExceptions<&ModdedApplication::keepOrRevertFileModifications>(
-      app_id, deployer, changes_to_keep);
-    if(has_throw)
-      emit completedOperations("Applying external changes failed");
-    else
-      emit externalChangesHandled(app_id, deployer, apps_[app_id].getNumDeployers(), deploy);
-  }
-  else
-    emit completedOperations("Applying external changes failed");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+      {
+        const bool has_throw = handleExceptions<&ModdedApplication::keepOrRevertFileModifications>(
+          app_id, deployer, changes_to_keep);
+        if(has_throw)
+          emit completedOperations("Applying external changes failed");
+        else
+          emit externalChangesHandled(app_id, deployer, apps_[app_id].getNumDeployers(), deploy);
+      }
+      else
+        emit completedOperations("Applying external changes failed");
+    });
 }
 
 void ApplicationManager::exportAppConfiguration(int app_id,
                                                 std::vector<int> deployers,
                                                 QStringList auto_tags)
 {
-  std::vector<std::string> tag_vector;
-  for(const auto& tag : auto_tags)
-    tag_vector.push_back(tag.toStdString());
-  if(appIndexIsValid(app_id))
-    handleExceptions<&ModdedApplication::exportConfiguration>(app_id, deployers, tag_vector);
-  emit completedOperations("Configuration exported");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      std::vector<std::string> tag_vector;
+      for(const auto& tag : auto_tags)
+        tag_vector.push_back(tag.toStdString());
+      if(appIndexIsValid(app_id))
+        handleExceptions<&ModdedApplication::exportConfiguration>(app_id, deployers, tag_vector);
+      emit completedOperations("Configuration exported");
+    });
 }
 
 void ApplicationManager::updateIgnoredFiles(int app_id, int deployer)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-    handleExceptions<&ModdedApplication::updateIgnoredFiles>(app_id, deployer);
-  emit completedOperations("Ignore list updated");
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+        handleExceptions<&ModdedApplication::updateIgnoredFiles>(app_id, deployer);
+      emit completedOperations("Ignore list updated");
+    });
 }
 
 void ApplicationManager::addModToIgnoreList(int app_id, int deployer, int mod_id)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-    handleExceptions<&ModdedApplication::addModToIgnoreList>(app_id, deployer, mod_id);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+        handleExceptions<&ModdedApplication::addModToIgnoreList>(app_id, deployer, mod_id);
+    });
 }
 
 void ApplicationManager::applyModAction(int app_id, int deployer, int action, int mod_id)
 {
-  if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
-    handleExceptions<&ModdedApplication::applyModAction>(app_id, deployer, action, mod_id);
+  runJob(
+    app_id,
+    JobScheduler::write_access,
+    [=, this]() mutable
+    {
+      if(appIndexIsValid(app_id) && deployerIndexIsValid(app_id, deployer))
+        handleExceptions<&ModdedApplication::applyModAction>(app_id, deployer, action, mod_id);
+    });
+}
+
+void ApplicationManager::cancelOperations(int app_id)
+{
+  scheduler_.cancel(app_id);
 }
@@ -9,6 +9,7 @@
 #include "../core/editapplicationinfo.h"
 #include "../core/editautotagaction.h"
 #include "../core/editmanualtagaction.h"
+#include "../core/jobscheduler.h"
 #include "../core/log.h"
 #include "../core/moddedapplication.h"
 #include "../core/nexus/api.h"
@@ -25,6 +26,9 @@
  *
  * This is intended to be run inside of a worker thread, therefore public functions are
  * implemented as Qt slots and emit Qt signals instead of returning a value directly.
+ * Slots do not perform their work directly but submit it as a job to a JobScheduler. Jobs
+ * for one application are completed in the order in which they were submitted, while jobs
+ * for different applications, as well as queries on one application, may run concurrently.
  * The internal state of this object is stored in a JSON file in the user directory,
  * usually in "~/.local/share/linux_mod_manager/lmm_apps.json".
  * Warning: To ensure all actions are completed as intended, use Qt::QueuedConnection as type
@@ -334,6 +338,11 @@ private:
   std::vector<ModdedApplication> apps_;
   /*! \brief If true: Do not catch exceptions. */
   bool throw_exceptions_ = false;
+  /*!
+   * \brief Runs all slot implementations. Declared last, so that all jobs are completed
+   * before any other member is destroyed.
+   */
+  JobScheduler scheduler_;
 
   /*!
    * \brief Updates the settings file with the current state of this object.
@@ -351,6 +360,19 @@ private:
    * \return True if app id is valid, else false.
    */
   bool appIndexIsValid(int app_id, bool show_error = true);
+  /*!
+   * \brief Submits the given job to the scheduler. If exceptions are enabled, the job is
+   * instead run immediately, so that exceptions are passed on to the caller.
+   * \param app_id Application accessed by the job, or JobScheduler::NO_APP or
+   * JobScheduler::ALL_APPS.
+   * \param access Whether the job only reads or also modifies the application.
+   * \param job The job.
+   * \param priority Priority of the job.
+   */
+  void runJob(int app_id,
+              JobScheduler::Access access,
+              std::function<void()> job,
+              JobScheduler::Priority priority = JobScheduler::normal_priority);
   /*!
    * \brief Checks if given deployer id is valid for given app and optionally emits
    * an error signal.
@@ -1047,4 +1069,10 @@ public slots:
    * \param mod_id Target mod.
    */
   void applyModAction(int app_id, int deployer, int action, int mod_id);
+  /*!
+   * \brief Requests cancellation of all queued and running operations for the given
+   * application. Queued operations are discarded.
+   * \param app_id Target app.
+   */
+  void cancelOperations(int app_id);
 };
@@ -94,10 +94,9 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWi
 
 MainWindow::~MainWindow()
 {
+  // slots only submit jobs, running jobs are cancelled when app_manager_ is deleted
   worker_thread_->quit();
-  worker_thread_->wait(5000);
-  if(worker_thread_->isRunning())
-    worker_thread_->terminate();
+  worker_thread_->wait();
   delete worker_thread_;
   delete ui;
   delete app_manager_;
@@ -382,6 +381,8 @@ void MainWindow::setupConnections()
           this, &MainWindow::onDownloadFailed);
   connect(this, &MainWindow::checkForModUpdates,
           app_manager_, &ApplicationManager::checkForModUpdates);
+  connect(this, &MainWindow::cancelOperations,
+          app_manager_, &ApplicationManager::cancelOperations);
   connect(this, &MainWindow::checkModsForUpdates,
           app_manager_, &ApplicationManager::checkModsForUpdates);
   connect(this, &MainWindow::suppressUpdateNotification,
@@ -903,6 +904,8 @@ void MainWindow::setBusyStatus(bool busy, bool show_progress_bar, bool disable_a
     last_progress_update_time_ = std::chrono::high_resolution_clock::now();
     progress_bar_->setEnabled(busy);
     progress_bar_->setVisible(busy);
+    cancel_button_->setEnabled(busy);
+    cancel_button_->setVisible(busy);
     progress_bar_->setMaximum(0);
     progress_bar_->setMinimum(0);
   }
@@ -2205,6 +2208,12 @@ void MainWindow::setupProgressBar()
   auto layout = new QHBoxLayout();
   layout->insertSpacing(0, 375);
   layout->addWidget(progress_bar_);
+  cancel_button_ = new QToolButton();
+  cancel_button_->setIcon(QIcon::fromTheme("process-stop"));
+  cancel_button_->setToolTip("Cancel all running operations");
+  cancel_button_->setAutoRaise(true);
+  connect(cancel_button_, &QToolButton::clicked, this, &MainWindow::onCancelButtonClicked);
+  layout->addWidget(cancel_button_);
   layout->setSpacing(0);
   layout->setMargin(0);
   layout->setAlignment(Qt::AlignCenter);
@@ -2212,6 +2221,7 @@ void MainWindow::setupProgressBar()
   container->setMaximumHeight(15);
   ui->statusbar->insertPermanentWidget(0, container);
   progress_bar_->setVisible(false);
+  cancel_button_->setVisible(false);
 }
 
 void MainWindow::setupFilters()
@@ -2690,6 +2700,13 @@ void MainWindow::onLogButtonPressed()
   ui->log_container->setVisible(!ui->log_container->isVisible());
 }
 
+void MainWindow::onCancelButtonClicked()
+{
+  cancel_button_->setEnabled(false);
+  setStatusMessage("Cancelling operations");
+  emit cancelOperations(currentApp());
+}
+
 void MainWindow::onReceiveLogMessage(Log::LogLevel log_level, QString message)
 {
   Log::log(log_level, message.toStdString());
@@ -50,6 +50,7 @@
 #include <QProgressBar>
 #include <QTableWidget>
 #include <QThread>
+#include <QToolButton>
 #include <QtCore>
 
 
@@ -265,6 +266,8 @@ private:
   QTableView* conflicts_list_;
   /*! \brief Progress bar shown in the status bar. */
   QProgressBar* progress_bar_;
+  /*! \brief Shown next to \ref progress_bar_. Cancels all operations for the current app. */
+  QToolButton* cancel_button_;
   /*!
    *  \brief Maps the names of all manual tags for the current app to the number of mods with that
    * tag.
@@ -760,6 +763,8 @@ private slots:
   void on_actionSort_Mods_triggered();
   /*! \brief Toggles log window visibility. */
   void onLogButtonPressed();
+  /*! \brief Requests cancellation of all operations for the current app. */
+  void onCancelButtonClicked();
   /*!
    * \brief Shows the received message in the log.
    * \param log_level Log level for the message.
@@ -1603,4 +1608,9 @@ signals:
    * \param mod_id Target mod.
    */
   void applyModAction(int app_id, int deployer, int action, int mod_id);
+  /*!
+   * \brief Requests cancellation of all queued and running operations for the given app.
+   * \param app_id Target app.
+   */
+  void cancelOperations(int app_id);
 };
@@ -90,3 +90,29 @@ TEST_CASE("Profiles are managed", "[bg3]")
   verifyFilesAreEqual(DATA_DIR / "target" / "bg3" / "target" / "modsettings.lsx",
                       DATA_DIR / "target" / "bg3" / "1" / "modsettings.lsx");
 }
+
+TEST_CASE("Pak conflicts are detected", "[bg3]")
+{
+  resetBg3Files();
+
+  Bg3Deployer depl(DATA_DIR / "source" / "bg3" / "source", DATA_DIR / "target" / "bg3" / "target", "");
+  // every archive in this directory contains a meta.lsx file in its root directory
+  const std::unordered_set<int> all_mods{ 0, 1, 2, 3 };
+  REQUIRE(depl.getModConflicts(0) == all_mods);
+  REQUIRE(depl.getModConflicts(3) == all_mods);
+  const auto matrix = depl.getConflictMatrix();
+  REQUIRE(matrix.size() == 4);
+  for(const auto& conflicts : matrix)
+    REQUIRE(conflicts == all_mods);
+
+  Bg3Deployer depl_2(DATA_DIR / "source" / "bg3" / "source", DATA_DIR / "target" / "bg3" / "target", "");
+  REQUIRE(depl_2.getConflictMatrix() == matrix);
+
+  // these archives store their files in different directories
+  resetBg3Files();
+  Bg3Deployer disjoint_depl(DATA_DIR / "source" / "bg3" / "disjoint", DATA_DIR / "target" / "bg3" / "target", "");
+  REQUIRE(disjoint_depl.getNumMods() == 2);
+  REQUIRE(disjoint_depl.getModConflicts(0) == std::unordered_set<int>{ 0 });
+  REQUIRE(disjoint_depl.getConflictMatrix() ==
+          std::vector<std::unordered_set<int>>{ { 0 }, { 1 } });
+}
@@ -1,12 +1,37 @@
+#include "../src/core/cancellationerror.h"
+#include "../src/core/casefoldeddirectoryindex.h"
 #include "../src/core/casematchingdeployer.h"
+#include "../src/core/deployedfilesrecord.h"
 #include "../src/core/deployer.h"
+#include "../src/core/modfilecatalog.h"
+#include "../src/core/modfilemanifest.h"
+#include "../src/core/parseerror.h"
+#include "../src/core/pathutils.h"
 #include "test_utils.h"
 #include <catch2/catch_test_macros.hpp>
 #include <filesystem>
+#include <format>
+#include <fstream>
 #include <iostream>
-#include <set>
+#include <memory>
 #include <ranges>
+#include <set>
+#include <unordered_set>
+
 
+void copyModToStagingDir(int mod_id)
+{
+  const sfs::path mod_path = DATA_DIR / "staging" / std::to_string(mod_id);
+  sfs::copy(DATA_DIR / "source" / std::to_string(mod_id), mod_path, sfs::copy_options::recursive);
+  // mod file manifests are not trusted for recently modified directories
+  const auto old_time = sfs::file_time_type::clock::now() - std::chrono::hours(1);
+  sfs::last_write_time(mod_path, old_time);
+  for(const auto& dir_entry : sfs::recursive_directory_iterator(mod_path))
+  {
+    if(dir_entry.is_directory())
+      sfs::last_write_time(dir_entry.path(), old_time);
+  }
+}
 
 TEST_CASE("Mods are added and removed", "[deployer]")
 {
@@ -146,6 +171,52 @@ TEST_CASE("Get file conflicts", "[deployer]")
   REQUIRE(conflicts.size() == 0);
   conflicts = depl.getFileConflicts(0);
   REQUIRE(conflicts.size() == 3);
+  for(const auto& conflict : conflicts)
+    REQUIRE(conflict.mod_ids == std::vector<int>{ 0, 2 });
+  depl.changeLoadorder(2, 0);
+  depl.setModStatus(0, false);
+  REQUIRE(depl.getFileConflicts(0).empty());
+  conflicts = depl.getFileConflicts(0, true);
+  REQUIRE(conflicts.size() == 3);
+  for(const auto& conflict : conflicts)
+    REQUIRE(conflict.mod_ids == std::vector<int>{ 2, 0 });
+}
+
+TEST_CASE("Conflicts are updated when mods change", "[deployer]")
+{
+  resetStagingDir();
+  copyModToStagingDir(0);
+  copyModToStagingDir(1);
+  copyModToStagingDir(2);
+  Deployer depl = Deployer(DATA_DIR / "staging", DATA_DIR / "app", "");
+  depl.addProfile();
+  depl.addMod(0, true);
+  depl.addMod(1, true);
+  depl.addMod(2, true);
+  REQUIRE(depl.getModConflicts(0) == std::unordered_set<int>{ 0, 2 });
+  REQUIRE(depl.getModConflicts(1) == std::unordered_set<int>{ 1 });
+
+  depl.removeMod(2);
+  REQUIRE(depl.getModConflicts(0) == std::unordered_set<int>{ 0 });
+  depl.addMod(2, true);
+  REQUIRE(depl.getModConflicts(0) == std::unordered_set<int>{ 0, 2 });
+
+  std::ofstream(DATA_DIR / "staging" / "1" / "0.txt") << "new file";
+  ModFileManifest::invalidate(DATA_DIR / "staging" / "1");
+  depl.invalidateModFiles(1);
+  REQUIRE(depl.getModConflicts(1) == std::unordered_set<int>{ 0, 1, 2 });
+  auto conflicts = depl.getFileConflicts(1);
+  REQUIRE(conflicts.size() == 1);
+  REQUIRE(conflicts[0].file == "0.txt");
+  REQUIRE(conflicts[0].mod_ids == std::vector<int>{ 0, 1, 2 });
+
+  // changes made outside of the deployer are detected by the next deployment
+  sfs::remove(DATA_DIR / "staging" / "1" / "0.txt");
+  REQUIRE(depl.getModConflicts(1) == std::unordered_set<int>{ 0, 1, 2 });
+  resetAppDir();
+  depl.deploy();
+  REQUIRE(depl.getModConflicts(1) == std::unordered_set<int>{ 1 });
+  REQUIRE(depl.getFileConflicts(1).empty());
 }
 
 TEST_CASE("Conflict groups are created", "[deployer]")
@@ -161,6 +232,46 @@ TEST_CASE("Conflict groups are created", "[deployer]")
                  std::vector<std::vector<int>>{ { 0, 1, 2, 3, 5 }, { 4, 6 }, { 7 } }));
 }
 
+TEST_CASE("Conflict groups are updated incrementally", "[deployer]")
+{
+  Deployer depl(DATA_DIR / "source" / "conflicts", DATA_DIR / "app", "");
+  depl.addProfile();
+  depl.setAutoUpdateConflictGroups(true);
+  Deployer reference_depl(DATA_DIR / "source" / "conflicts", DATA_DIR / "app", "");
+  reference_depl.addProfile();
+  for(int i : { 5, 6, 0, 7, 4, 2, 1, 3 })
+  {
+    depl.addMod(i, true);
+    reference_depl.addMod(i, true);
+    reference_depl.updateConflictGroups();
+    REQUIRE(depl.getConflictGroups() == reference_depl.getConflictGroups());
+  }
+  REQUIRE_THAT(depl.getConflictGroups(),
+               Catch::Matchers::UnorderedEquals(
+                 std::vector<std::vector<int>>{ { 5, 0, 2, 1, 3 }, { 6, 4 }, { 7 } }));
+  for(int i : { 2, 4, 7, 5, 3, 0, 6, 1 })
+  {
+    depl.removeMod(i);
+    reference_depl.removeMod(i);
+    reference_depl.updateConflictGroups();
+    REQUIRE(depl.getConflictGroups() == reference_depl.getConflictGroups());
+  }
+  REQUIRE(depl.getConflictGroups() == std::vector<std::vector<int>>{ {} });
+
+  // removing mod 2 delays the first conflict in its group past the one in group { 4, 6 }
+  for(int i : { 0, 2, 4, 6, 1, 5, 3 })
+  {
+    depl.addMod(i, true);
+    reference_depl.addMod(i, true);
+  }
+  depl.removeMod(2);
+  reference_depl.removeMod(2);
+  reference_depl.updateConflictGroups();
+  REQUIRE(depl.getConflictGroups() ==
+          std::vector<std::vector<int>>{ { 4, 6 }, { 1, 5, 3 }, { 0 } });
+  REQUIRE(depl.getConflictGroups() == reference_depl.getConflictGroups());
+}
+
 TEST_CASE("Mods are sorted", "[deployer]")
 {
   Deployer depl(DATA_DIR / "source" / "conflicts", DATA_DIR / "app", "");
@@ -191,10 +302,19 @@ TEST_CASE("Case matching deployer", "[deployer]")
   sfs::copy(DATA_DIR / "source" / "case_matching" / "orig_1",
             DATA_DIR / "source" / "case_matching" / "1",
             options);
+  sfs::remove_all(DATA_DIR / "source" / "case_matching" / ".lmm_manifests");
   CaseMatchingDeployer depl(DATA_DIR / "source" / "case_matching", DATA_DIR / "app", "");
   depl.addProfile();
   depl.addMod(0, true);
   depl.addMod(1, true);
+  const auto plan = depl.getDeploymentPlan();
+  verifyDirsAreEqual(DATA_DIR / "source" / "case_matching" / "0",
+                     DATA_DIR / "source" / "case_matching" / "orig_0",
+                     false);
+  verifyDirsAreEqual(DATA_DIR / "source" / "case_matching" / "1",
+                     DATA_DIR / "source" / "case_matching" / "orig_1",
+                     false);
+  REQUIRE_FALSE(sfs::exists(DATA_DIR / "source" / "case_matching" / ".lmm_manifests"));
   depl.deploy({ 0, 1 });
   verifyDirsAreEqual(DATA_DIR / "source" / "case_matching" / "0",
                      DATA_DIR / "target" / "case_matching" / "0",
@@ -202,6 +322,125 @@ TEST_CASE("Case matching deployer", "[deployer]")
   verifyDirsAreEqual(DATA_DIR / "source" / "case_matching" / "1",
                      DATA_DIR / "target" / "case_matching" / "1",
                      false);
+
+  // the plan contains the file names created by renaming
+  std::set<std::string> planned_files;
+  for(const auto& [path, mod_id] : plan.files_to_create)
+    planned_files.insert(path.string());
+  std::set<std::string> deployed_files;
+  for(int mod_id : { 0, 1 })
+  {
+    const sfs::path mod_path = DATA_DIR / "source" / "case_matching" / std::to_string(mod_id);
+    for(const auto& dir_entry : sfs::recursive_directory_iterator(mod_path))
+      deployed_files.insert(sfs::relative(dir_entry.path(), mod_path).string());
+  }
+  REQUIRE(planned_files == deployed_files);
+}
+
+TEST_CASE("Names are case folded", "[deployer]")
+{
+  REQUIRE(path_utils::toCaseFolded("Data/TEXTURES/a.DDS") == "data/textures/a.dds");
+  REQUIRE(path_utils::toCaseFolded("ÄÖÜ/Straße") == "äöü/straße");
+  REQUIRE(path_utils::toCaseFolded("ΣΚΥΡΙΜ/Ŀŉ/ДАННЫЕ") == "σκυριμ/ŀŉ/данные");
+  REQUIRE(path_utils::toCaseFolded("Ÿ/Ａ") == "ÿ/ａ");
+  REQUIRE(path_utils::toCaseFolded("a\xff" "B\xc3") == "a\xff" "b\xc3");
+}
+
+TEST_CASE("Case folding keeps distinct names apart", "[deployer]")
+{
+  REQUIRE(path_utils::toCaseFolded("İ") == "İ");
+  REQUIRE(path_utils::toCaseFolded("İ") != path_utils::toCaseFolded("ı"));
+  REQUIRE(path_utils::toCaseFolded("İ") != path_utils::toCaseFolded("i"));
+  REQUIRE(path_utils::toCaseFolded("ĀĮĲĶ") == "āįĳķ");
+  REQUIRE(path_utils::toCaseFolded("ÀÞ×ßÿ") == "àþ×ßÿ");
+  REQUIRE(path_utils::toCaseFolded("ΑΩΆΈΊΌΎΏ") == "αωάέίόύώ");
+  REQUIRE(path_utils::toCaseFolded("ЀЏАЯѠҐӐ") == "ѐџаяѡґӑ");
+}
+
+TEST_CASE("Case folded directory index resolves paths", "[deployer]")
+{
+  resetStagingDir();
+  sfs::create_directories(DATA_DIR / "staging" / "Data" / "Textures");
+  std::ofstream(DATA_DIR / "staging" / "Data" / "Textures" / "Stein.dds");
+  CaseFoldedDirectoryIndex index(DATA_DIR / "staging");
+  REQUIRE(index.resolve("data/TEXTURES/stein.DDS") == sfs::path("Data/Textures/Stein.dds"));
+  REQUIRE(index.resolve("Data/Textures/") == sfs::path("Data/Textures"));
+  REQUIRE_FALSE(index.resolve("data/meshes"));
+  REQUIRE(index.isDirectory("Data/Textures"));
+  REQUIRE_FALSE(index.exists("data"));
+  REQUIRE(index.resolve("data/../DATA/textures/../Textures") == sfs::path("Data/Textures"));
+  REQUIRE(index.resolve("data/textures/../..") == sfs::path(""));
+
+  sfs::create_directories(DATA_DIR / "staging" / "Data" / "Meshes");
+  sfs::rename(DATA_DIR / "staging" / "Data" / "Textures" / "Stein.dds",
+              DATA_DIR / "staging" / "Data" / "Textures" / "Wand.dds");
+  // cached listings are only checked again after a refresh
+  REQUIRE_FALSE(index.resolve("data/meshes"));
+  index.refresh();
+  REQUIRE(index.resolve("data/meshes") == sfs::path("Data/Meshes"));
+  REQUIRE_FALSE(index.resolve("data/textures/stein.dds"));
+  REQUIRE(index.resolve("DATA/TEXTURES/WAND.DDS") == sfs::path("Data/Textures/Wand.dds"));
+}
+
+TEST_CASE("Case matching deployer matches non ASCII names", "[deployer]")
+{
+  resetAppDir();
+  resetStagingDir();
+  sfs::create_directories(DATA_DIR / "app" / "Données" / "Éléments");
+  std::ofstream(DATA_DIR / "app" / "Données" / "Éléments" / "Fichier.txt");
+  std::ofstream(DATA_DIR / "app" / "Données" / "Ämne.txt");
+  std::ofstream(DATA_DIR / "app" / "Données" / "ämne.TXT");
+  sfs::create_directories(DATA_DIR / "staging" / "0" / "DONNÉES" / "éléments");
+  std::ofstream(DATA_DIR / "staging" / "0" / "DONNÉES" / "éléments" / "FICHIER.txt") << "0";
+  std::ofstream(DATA_DIR / "staging" / "0" / "DONNÉES" / "ÄMNE.txt") << "0";
+  sfs::create_directories(DATA_DIR / "staging" / "1" / "données" / "NEU");
+  std::ofstream(DATA_DIR / "staging" / "1" / "données" / "NEU" / "a.txt") << "1";
+  sfs::create_directories(DATA_DIR / "staging" / "2" / "DONNÉES" / "neu");
+  std::ofstream(DATA_DIR / "staging" / "2" / "DONNÉES" / "neu" / "b.txt") << "2";
+
+  CaseMatchingDeployer depl(DATA_DIR / "staging", DATA_DIR / "app", "");
+  depl.addProfile();
+  for(int mod_id : { 0, 1, 2 })
+    depl.addMod(mod_id, true);
+  depl.deploy({ 0, 1, 2 });
+  const sfs::path mod_0 = DATA_DIR / "staging" / "0";
+  REQUIRE(sfs::exists(mod_0 / "Données" / "Éléments" / "Fichier.txt"));
+  // ambiguous matches are not renamed
+  REQUIRE(sfs::exists(mod_0 / "Données" / "ÄMNE.txt"));
+  REQUIRE(sfs::exists(DATA_DIR / "staging" / "1" / "Données" / "NEU" / "a.txt"));
+  REQUIRE(sfs::exists(DATA_DIR / "staging" / "2" / "Données" / "NEU" / "b.txt"));
+  REQUIRE(sfs::exists(DATA_DIR / "app" / "Données" / "NEU" / "a.txt"));
+  REQUIRE(sfs::exists(DATA_DIR / "app" / "Données" / "NEU" / "b.txt"));
+}
+
+TEST_CASE("Case matching deployer merges directories differing only in case", "[deployer]")
+{
+  resetAppDir();
+  resetStagingDir();
+  const sfs::path mod_path = DATA_DIR / "staging" / "0";
+  // the crash depended on directory iteration order, so use several names
+  for(int i = 0; i < 8; i++)
+  {
+    const std::string suffix = std::to_string(i);
+    sfs::create_directories(DATA_DIR / "app" / ("Data" + suffix) / "Sub");
+    int file = 0;
+    for(const std::string& dir_name : { "Data" + suffix, "DATA" + suffix, "data" + suffix })
+    {
+      sfs::create_directories(mod_path / dir_name / "sub");
+      std::ofstream(mod_path / dir_name / "sub" / (std::to_string(file++) + ".txt")) << "0";
+    }
+  }
+
+  CaseMatchingDeployer depl(DATA_DIR / "staging", DATA_DIR / "app", "");
+  depl.addProfile();
+  depl.addMod(0, true);
+  depl.deploy({ 0 });
+  for(int i = 0; i < 8; i++)
+  {
+    const sfs::path dir = DATA_DIR / "app" / ("Data" + std::to_string(i)) / "Sub";
+    for(int file = 0; file < 3; file++)
+      REQUIRE(sfs::exists(dir / (std::to_string(file) + ".txt")));
+  }
 }
 
 TEST_CASE("External changes are handeld", "[deployer]")
@@ -273,3 +512,253 @@ TEST_CASE("Files are deployed as sym links", "[deployer]")
         REQUIRE(std::filesystem::is_symlink(dir_entry.path()));
   }
 }
+
+TEST_CASE("Mod file manifests are updated", "[deployer]")
+{
+  resetAppDir();
+  resetStagingDir();
+  copyModToStagingDir(1);
+  const sfs::path mod_path = DATA_DIR / "staging" / "1";
+
+  Deployer depl = Deployer(DATA_DIR / "staging", DATA_DIR / "app", "");
+  depl.addProfile();
+  depl.addMod(1, true);
+  depl.deploy();
+  verifyDirsAreEqual(DATA_DIR / "app", DATA_DIR / "target" / "mod1", true);
+  REQUIRE(sfs::exists(ModFileManifest::getManifestPath(mod_path)));
+  const auto manifest = ModFileManifest::get(mod_path);
+  REQUIRE(manifest.isValid(mod_path));
+
+  std::ofstream(mod_path / "new_file") << "new";
+  REQUIRE_FALSE(manifest.isValid(mod_path));
+  depl.deploy();
+  REQUIRE(sfs::exists(DATA_DIR / "app" / "new_file"));
+  REQUIRE(ModFileManifest::get(mod_path).getEntries().size() == manifest.getEntries().size() + 1);
+
+  ModFileManifest::invalidate(mod_path);
+  REQUIRE_FALSE(sfs::exists(ModFileManifest::getManifestPath(mod_path)));
+}
+
+TEST_CASE("Mod file catalogs are shared and invalidated", "[deployer]")
+{
+  resetAppDir();
+  resetStagingDir();
+  copyModToStagingDir(0);
+  copyModToStagingDir(1);
+  const sfs::path mod_path = DATA_DIR / "staging" / "1";
+  auto catalog = std::make_shared<ModFileCatalog>(DATA_DIR / "staging");
+  const auto manifest = catalog->getManifest(1);
+  REQUIRE(catalog->getManifest(1) == manifest);
+  REQUIRE(catalog->getModFiles(1, true).size() == manifest->getEntries().size());
+
+  Deployer depl = Deployer(DATA_DIR / "staging", DATA_DIR / "app", "");
+  depl.setModFileCatalog(catalog);
+  depl.addProfile();
+  depl.addMod(0, true);
+  depl.addMod(1, true);
+  depl.deploy();
+  REQUIRE(catalog->getManifest(1) == manifest);
+
+  std::ofstream(mod_path / "new_file") << "new";
+  const auto changed_manifest = catalog->getManifest(1);
+  REQUIRE(changed_manifest != manifest);
+  REQUIRE(changed_manifest->getEntries().size() == manifest->getEntries().size() + 1);
+  depl.deploy();
+  REQUIRE(sfs::exists(DATA_DIR / "app" / "new_file"));
+
+  catalog->invalidate(1);
+  REQUIRE_FALSE(sfs::exists(ModFileManifest::getManifestPath(mod_path)));
+  REQUIRE(catalog->getManifest(1) != changed_manifest);
+}
+
+TEST_CASE("Deployment plans only contain changed files", "[deployer]")
+{
+  resetAppDir();
+  resetStagingDir();
+  copyModToStagingDir(0);
+  copyModToStagingDir(1);
+  copyModToStagingDir(2);
+  Deployer depl = Deployer(DATA_DIR / "staging", DATA_DIR / "app", "");
+  depl.addProfile();
+  depl.addMod(0, true);
+  depl.addMod(1, true);
+  depl.addMod(2, false);
+  auto plan = depl.getDeploymentPlan();
+  REQUIRE(plan.num_unchanged_files == 0);
+  REQUIRE(plan.files_to_replace.empty());
+  REQUIRE_FALSE(plan.files_to_create.empty());
+  depl.deploy();
+
+  plan = depl.getDeploymentPlan();
+  REQUIRE(plan.getNumChanges() == 0);
+  REQUIRE(plan.num_unchanged_files > 0);
+
+  depl.setModStatus(2, true);
+  plan = depl.getDeploymentPlan();
+  REQUIRE(plan.getNumChanges() > 0);
+  REQUIRE(plan.files_to_remove.empty());
+  depl.deploy();
+  verifyDirsAreEqual(DATA_DIR / "app", DATA_DIR / "target" / "mod012", true);
+  REQUIRE(depl.getDeploymentPlan().getNumChanges() == 0);
+
+  depl.setModStatus(0, false);
+  depl.setModStatus(1, false);
+  depl.setModStatus(2, false);
+  plan = depl.getDeploymentPlan();
+  REQUIRE(plan.files_to_create.empty());
+  REQUIRE(plan.files_to_replace.empty());
+  REQUIRE(plan.num_unchanged_files == 0);
+  depl.deploy();
+  verifyDirsAreEqual(DATA_DIR / "app", DATA_DIR / "source" / "app", true);
+}
+
+TEST_CASE("Large mods are deployed", "[deployer]")
+{
+  resetAppDir();
+  resetStagingDir();
+  const sfs::path mod_path = DATA_DIR / "staging" / "0";
+  for(int i = 0; i < 20; i++)
+  {
+    sfs::create_directories(mod_path / std::format("dir_{}", i));
+    for(int j = 0; j < 100; j++)
+    {
+      std::ofstream file(mod_path / std::format("dir_{}", i) / std::format("file_{}", j));
+      file << i << " " << j;
+    }
+  }
+  for(auto deploy_mode : { Deployer::hard_link, Deployer::copy })
+  {
+    resetAppDir();
+    Deployer depl = Deployer(DATA_DIR / "staging", DATA_DIR / "app", "", deploy_mode);
+    depl.addProfile();
+    depl.addMod(0, true);
+    depl.deploy();
+    for(int i = 0; i < 20; i++)
+    {
+      for(int j = 0; j < 100; j++)
+      {
+        const sfs::path dest_path =
+          DATA_DIR / "app" / std::format("dir_{}", i) / std::format("file_{}", j);
+        REQUIRE(sfs::exists(dest_path));
+        REQUIRE(sfs::equivalent(dest_path, mod_path / std::format("dir_{}", i) /
+                                             std::format("file_{}", j)) ==
+                (deploy_mode == Deployer::hard_link));
+      }
+    }
+    depl.setModStatus(0, false);
+    depl.deploy();
+    verifyDirsAreEqual(DATA_DIR / "app", DATA_DIR / "source" / "app", true);
+  }
+}
+
+TEST_CASE("Deployed files records are written and read", "[deployer]")
+{
+  resetAppDir();
+  const sfs::path record_path = DATA_DIR / "app" / "record";
+  PathMap files;
+  files.add("a", 0);
+  files.add("a/b", 1);
+  files.add("a/b/c.txt", 2);
+  files.add("a/d.txt", 0);
+  files.add("b/b", 3);
+  files.add("b/b/b", 4);
+  files.add("Ünïcödé/file name.txt", 5);
+  DeployedFilesRecord::write(record_path, files);
+  REQUIRE(DeployedFilesRecord::isBinaryRecord(record_path));
+  DeployedFilesRecord record(record_path);
+  REQUIRE(record.size() == files.size());
+  REQUIRE(record.getPath(2) == "a/b/c.txt");
+  REQUIRE(record.getModId(2) == 2);
+  REQUIRE(record.toPathMap() == files);
+
+  DeployedFilesRecord::write(record_path, {});
+  REQUIRE(DeployedFilesRecord(record_path).toPathMap().empty());
+
+  std::ofstream(record_path, std::fstream::binary) << "LMMF broken";
+  REQUIRE_THROWS_AS(DeployedFilesRecord(record_path), ParseError);
+  std::ofstream(record_path, std::fstream::binary) << R"({"files":[]})";
+  REQUIRE_FALSE(DeployedFilesRecord::isBinaryRecord(record_path));
+}
+
+TEST_CASE("Legacy deployed files are migrated", "[deployer]")
+{
+  resetAppDir();
+  resetStagingDir();
+  sfs::copy(DATA_DIR / "source" / "0", DATA_DIR / "staging" / "0", sfs::copy_options::recursive);
+  sfs::copy(DATA_DIR / "source" / "1", DATA_DIR / "staging" / "1", sfs::copy_options::recursive);
+  sfs::copy(DATA_DIR / "source" / "2", DATA_DIR / "staging" / "2", sfs::copy_options::recursive);
+  Deployer depl = Deployer(DATA_DIR / "staging", DATA_DIR / "app", "");
+  depl.addProfile();
+  depl.addMod(0, true);
+  depl.addMod(1, true);
+  depl.addMod(2, true);
+  const sfs::path deployed_files_path = DATA_DIR / "app" / ".lmmfiles";
+  std::ofstream(deployed_files_path, std::fstream::binary) << R"({"files":[]})";
+  depl.deploy();
+  REQUIRE(DeployedFilesRecord::isBinaryRecord(deployed_files_path));
+  verifyDirsAreEqual(DATA_DIR / "app", DATA_DIR / "target" / "mod012", true);
+  depl.setModStatus(2, false);
+  depl.setModStatus(1, false);
+  depl.setModStatus(0, false);
+  depl.deploy();
+  verifyDirsAreEqual(DATA_DIR / "app", DATA_DIR / "source" / "app", true);
+}
+
+TEST_CASE("Interrupted deployments are completed or reverted", "[deployer]")
+{
+  auto interrupt_deployment = [](Deployer& depl)
+  {
+    std::stop_source stop_source;
+    // stop once the first file has been deployed, loading deployed files takes 2 / 8 of the
+    // total progress
+    ProgressNode node([&stop_source](float progress)
+                      {
+                        if(progress > 0.25f)
+                          stop_source.request_stop();
+                      },
+                      {},
+                      stop_source.get_token());
+    REQUIRE_THROWS_AS(depl.deploy(&node), CancellationError);
+    REQUIRE(sfs::exists(DATA_DIR / "app" / ".lmmfiles.journal"));
+  };
+
+  resetAppDir();
+  Deployer depl = Deployer(DATA_DIR / "source", DATA_DIR / "app", "");
+  depl.addProfile();
+  depl.addMod(0, true);
+  depl.addMod(1, true);
+  depl.addMod(2, true);
+  interrupt_deployment(depl);
+  depl.deploy();
+  verifyDirsAreEqual(DATA_DIR / "app", DATA_DIR / "target" / "mod012", true);
+  REQUIRE_FALSE(sfs::exists(DATA_DIR / "app" / ".lmmfiles.journal"));
+
+  resetAppDir();
+  Deployer other_depl = Deployer(DATA_DIR / "source", DATA_DIR / "app", "");
+  other_depl.addProfile();
+  other_depl.addMod(0, true);
+  other_depl.addMod(1, true);
+  other_depl.addMod(2, true);
+  interrupt_deployment(other_depl);
+  other_depl.unDeploy();
+  verifyDirsAreEqual(DATA_DIR / "app", DATA_DIR / "source" / "app", true);
+  REQUIRE_FALSE(sfs::exists(DATA_DIR / "app" / ".lmmfiles.journal"));
+
+  resetAppDir();
+  Deployer partial_depl = Deployer(DATA_DIR / "source", DATA_DIR / "app", "");
+  partial_depl.addProfile();
+  partial_depl.addMod(0, true);
+  partial_depl.addMod(1, true);
+  partial_depl.deploy();
+  REQUIRE_FALSE(sfs::exists(DATA_DIR / "app" / ".lmmfiles.journal"));
+  partial_depl.deploy();
+  REQUIRE_FALSE(sfs::exists(DATA_DIR / "app" / ".lmmfiles.journal"));
+  partial_depl.addMod(2, true);
+  interrupt_deployment(partial_depl);
+  // files from mod 1 are not overwritten by mod 2 and remain deployed
+  const auto plan = partial_depl.getDeploymentPlan();
+  REQUIRE(plan.num_unchanged_files >= 4);
+  partial_depl.deploy();
+  verifyDirsAreEqual(DATA_DIR / "app", DATA_DIR / "target" / "mod012", true);
+  REQUIRE_FALSE(sfs::exists(DATA_DIR / "app" / ".lmmfiles.journal"));
+}
@@ -2,6 +2,7 @@
 #include "test_utils.h"
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
+#include <fstream>
 #include <iostream>
 #include <vector>
 
@@ -102,3 +103,61 @@ TEST_CASE("Root levels", "[installer]")
     verifyDirsAreEqual(DATA_DIR / "target" / "root_level" / "3", DATA_DIR / "staging" / "3");
   }
 }
+
+TEST_CASE("Installer signatures are detected", "[installer]")
+{
+  resetStagingDir();
+  const sfs::path source = DATA_DIR / "staging" / "signature";
+  sfs::create_directories(source / "a" / "b" / "fomod");
+  sfs::create_directories(source / "a" / "c" / "d" / "fomod");
+  std::ofstream(source / "a" / "c" / "d" / "fomod" / "ModuleConfig.xml") << "";
+  std::ofstream(source / "a" / "b" / "fomod" / "moduleconfig.XML") << "";
+  auto [root_level, root_path, type] = Installer::detectInstallerSignature(source);
+  REQUIRE(root_level == 2);
+  REQUIRE(root_path == "a/b");
+  REQUIRE(type == Installer::FOMODINSTALLER);
+
+  sfs::create_directories(source / "fomod");
+  std::ofstream(source / "fomod" / "ModuleConfig.xml") << "";
+  std::tie(root_level, root_path, type) = Installer::detectInstallerSignature(source);
+  REQUIRE(root_level == 0);
+  REQUIRE(type == Installer::FOMODINSTALLER);
+
+  std::tie(root_level, root_path, type) =
+    Installer::detectInstallerSignature(DATA_DIR / "source" / "mod0.tar.gz");
+  REQUIRE(root_level == 0);
+  REQUIRE(type == Installer::SIMPLEINSTALLER);
+  const auto file_names = Installer::getArchiveFileNames(DATA_DIR / "source" / "mod0.tar.gz");
+  REQUIRE_FALSE(file_names.empty());
+  REQUIRE(Installer::getArchiveFileNames(DATA_DIR / "source" / "mod0.tar.gz") == file_names);
+}
+
+TEST_CASE("Fomod files are extracted selectively", "[installer]")
+{
+  resetStagingDir();
+  const sfs::path mod_dir = DATA_DIR / "staging" / "fomod";
+  Installer::install(DATA_DIR / "source" / "mod0.tar.gz",
+                     mod_dir,
+                     Installer::preserve_case,
+                     Installer::FOMODINSTALLER,
+                     1,
+                     { { "b", "x" },
+                       { "0.txt", "y.txt" },
+                       { "b/1.txt", "z.txt" },
+                       { "b/2.txt", "z.txt" },
+                       { "b/1.txt", "w/" } });
+  verifyFilesAreEqual(DATA_DIR / "source" / "0" / "a" / "b" / "1.txt", mod_dir / "x" / "1.txt");
+  verifyFilesAreEqual(DATA_DIR / "source" / "0" / "a" / "b" / "2.txt", mod_dir / "x" / "2.txt");
+  verifyFilesAreEqual(DATA_DIR / "source" / "0" / "a" / "0.txt", mod_dir / "y.txt");
+  verifyFilesAreEqual(DATA_DIR / "source" / "0" / "a" / "b" / "2.txt", mod_dir / "z.txt");
+  verifyFilesAreEqual(DATA_DIR / "source" / "0" / "a" / "b" / "1.txt", mod_dir / "1.txt");
+  REQUIRE_FALSE(sfs::exists(mod_dir / "b"));
+  REQUIRE_FALSE(sfs::exists(mod_dir / "2.txt"));
+
+  REQUIRE_THROWS(Installer::install(DATA_DIR / "source" / "mod0.tar.gz",
+                                    DATA_DIR / "staging" / "missing",
+                                    Installer::preserve_case,
+                                    Installer::FOMODINSTALLER,
+                                    0,
+                                    { { "c", "c" } }));
+}
@@ -0,0 +1,225 @@
+#include "../src/core/cancellationerror.h"
+#include "../src/core/jobscheduler.h"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+
+TEST_CASE("Jobs for one application run in order", "[jobscheduler]")
+{
+  JobScheduler scheduler(4);
+  std::mutex mutex;
+  std::vector<int> order;
+  std::atomic<int> num_running = 0;
+  std::atomic<bool> was_exclusive = true;
+  for(int i = 0; i < 20; i++)
+  {
+    scheduler.submit(0,
+                     i % 5 == 0 ? JobScheduler::read_access : JobScheduler::write_access,
+                     [&, i](std::stop_token stop_token, ProgressNode& progress_node)
+                     {
+                       if(num_running++ != 0)
+                         was_exclusive = false;
+                       std::this_thread::sleep_for(1ms);
+                       {
+                         std::lock_guard lock(mutex);
+                         order.push_back(i);
+                       }
+                       num_running--;
+                     });
+  }
+  scheduler.waitForAll();
+  REQUIRE(was_exclusive);
+  REQUIRE(order.size() == 20);
+  for(int i = 0; i < 20; i++)
+    REQUIRE(order[i] == i);
+  REQUIRE(scheduler.getNumJobs() == 0);
+}
+
+TEST_CASE("Jobs for different applications run concurrently", "[jobscheduler]")
+{
+  JobScheduler scheduler(4);
+  std::binary_semaphore read_done(0);
+  std::atomic<bool> write_finished = false;
+  bool read_during_write = false;
+  scheduler.submit(0,
+                   JobScheduler::write_access,
+                   [&](std::stop_token stop_token, ProgressNode& progress_node)
+                   {
+                     read_during_write = read_done.try_acquire_for(5s);
+                     write_finished = true;
+                   });
+  scheduler.submit(1,
+                   JobScheduler::read_access,
+                   [&](std::stop_token stop_token, ProgressNode& progress_node)
+                   {
+                     if(!write_finished)
+                       read_done.release();
+                   },
+                   JobScheduler::high_priority);
+  scheduler.waitForAll();
+  REQUIRE(read_during_write);
+
+  std::atomic<int> num_readers = 0;
+  std::atomic<int> max_readers = 0;
+  for(int i = 0; i < 3; i++)
+  {
+    scheduler.submit(0,
+                     JobScheduler::read_access,
+                     [&](std::stop_token stop_token, ProgressNode& progress_node)
+                     {
+                       num_readers++;
+                       for(int j = 0; j < 500 && num_readers < 3; j++)
+                         std::this_thread::sleep_for(1ms);
+                       max_readers = std::max<int>(max_readers, num_readers);
+                       num_readers--;
+                     });
+  }
+  scheduler.waitForAll();
+  REQUIRE(max_readers == 3);
+}
+
+TEST_CASE("Jobs for all applications are exclusive", "[jobscheduler]")
+{
+  JobScheduler scheduler(4);
+  std::mutex mutex;
+  std::vector<int> order;
+  auto make_job = [&](int id)
+  {
+    return [&, id](std::stop_token stop_token, ProgressNode& progress_node)
+    {
+      std::this_thread::sleep_for(2ms);
+      std::lock_guard lock(mutex);
+      order.push_back(id);
+    };
+  };
+  scheduler.submit(0, JobScheduler::write_access, make_job(0));
+  scheduler.submit(JobScheduler::ALL_APPS, JobScheduler::write_access, make_job(1));
+  scheduler.submit(1, JobScheduler::read_access, make_job(2), JobScheduler::high_priority);
+  scheduler.waitForAll();
+  REQUIRE(order == std::vector<int>{ 0, 1, 2 });
+}
+
+TEST_CASE("Jobs are started by priority", "[jobscheduler]")
+{
+  JobScheduler scheduler(1);
+  std::binary_semaphore started(0);
+  std::binary_semaphore release(0);
+  std::vector<int> order;
+  scheduler.submit(JobScheduler::NO_APP,
+                   JobScheduler::write_access,
+                   [&](std::stop_token stop_token, ProgressNode& progress_node)
+                   {
+                     started.release();
+                     release.acquire();
+                   });
+  REQUIRE(started.try_acquire_for(5s));
+  for(int priority = 0; priority < 3; priority++)
+  {
+    scheduler.submit(priority,
+                     JobScheduler::write_access,
+                     [&, priority](std::stop_token stop_token, ProgressNode& progress_node)
+                     { order.push_back(priority); },
+                     static_cast<JobScheduler::Priority>(priority));
+  }
+  release.release();
+  scheduler.waitForAll();
+  REQUIRE(order == std::vector<int>{ 2, 1, 0 });
+}
+
+TEST_CASE("Jobs are cancelled", "[jobscheduler]")
+{
+  JobScheduler scheduler(2);
+  std::binary_semaphore started(0);
+  std::atomic<bool> was_stopped = false;
+  std::atomic<bool> queued_job_ran = false;
+  std::atomic<bool> other_job_ran = false;
+  scheduler.submit(0,
+                   JobScheduler::write_access,
+                   [&](std::stop_token stop_token, ProgressNode& progress_node)
+                   {
+                     started.release();
+                     for(int i = 0; i < 5000 && !stop_token.stop_requested(); i++)
+                       std::this_thread::sleep_for(1ms);
+                     was_stopped = stop_token.stop_requested();
+                   });
+  scheduler.submit(0,
+                   JobScheduler::write_access,
+                   [&](std::stop_token stop_token, ProgressNode& progress_node)
+                   { queued_job_ran = true; });
+  auto stop_source =
+    scheduler.submit(1,
+                     JobScheduler::write_access,
+                     [&](std::stop_token stop_token, ProgressNode& progress_node)
+                     { other_job_ran = true; });
+  REQUIRE(started.try_acquire_for(5s));
+  scheduler.cancel(0);
+  scheduler.waitForAll();
+  REQUIRE(was_stopped);
+  REQUIRE_FALSE(queued_job_ran);
+  REQUIRE(other_job_ran);
+  REQUIRE_FALSE(stop_source.stop_requested());
+}
+
+TEST_CASE("Job errors are reported", "[jobscheduler]")
+{
+  JobScheduler scheduler(1);
+  std::vector<std::string> errors;
+  scheduler.setLog([&errors](Log::LogLevel log_level, const std::string& message)
+                   { errors.push_back(message); });
+  scheduler.submit(3,
+                   JobScheduler::write_access,
+                   [](std::stop_token stop_token, ProgressNode& progress_node)
+                   {
+                     progress_node.setTotalSteps(2);
+                     progress_node.advance();
+                     throw std::runtime_error("failed");
+                   });
+  scheduler.submit(3,
+                   JobScheduler::write_access,
+                   [](std::stop_token stop_token, ProgressNode& progress_node) { throw 1; });
+  bool later_job_ran = false;
+  scheduler.submit(3,
+                   JobScheduler::write_access,
+                   [&later_job_ran](std::stop_token stop_token, ProgressNode& progress_node)
+                   { later_job_ran = true; });
+  scheduler.waitForAll();
+  REQUIRE(errors.size() == 2);
+  REQUIRE(errors[0] == "failed");
+  // failed jobs release their application
+  REQUIRE(later_job_ran);
+}
+
+TEST_CASE("Job progress nodes forward cancellation", "[jobscheduler]")
+{
+  JobScheduler scheduler(1);
+  std::binary_semaphore started(0);
+  std::atomic<bool> was_cancelled = false;
+  scheduler.submit(0,
+                   JobScheduler::write_access,
+                   [&started, &was_cancelled](std::stop_token stop_token,
+                                              ProgressNode& progress_node)
+                   {
+                     started.release();
+                     while(!stop_token.stop_requested())
+                       std::this_thread::sleep_for(1ms);
+                     try
+                     {
+                       progress_node.checkStop();
+                     }
+                     catch(CancellationError& error)
+                     {
+                       was_cancelled = true;
+                     }
+                   });
+  REQUIRE(started.try_acquire_for(5s));
+  scheduler.cancel(0);
+  scheduler.waitForAll();
+  REQUIRE(was_cancelled);
+}
@@ -4,6 +4,7 @@
 #include "test_utils.h"
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
+#include <fstream>
 #include <iostream>
 #include <ranges>
 
@@ -67,6 +68,78 @@ TEST_CASE("Deployers are added", "[app]")
   verifyDirsAreEqual(DATA_DIR / "app", DATA_DIR / "target" / "mod012", true);
 }
 
+TEST_CASE("Mods are installed in batches", "[app]")
+{
+  resetStagingDir();
+  resetAppDir();
+  ModdedApplication app(DATA_DIR / "staging", "test");
+  app.addDeployer({ DeployerFactory::SIMPLEDEPLOYER, "depl0", DATA_DIR / "app", Deployer::hard_link });
+  std::vector<ImportModInfo> infos(3);
+  for(auto& info : infos)
+  {
+    info.version = "1.0";
+    info.installer = Installer::SIMPLEINSTALLER;
+    info.deployers = { 0 };
+    info.installer_flags = INSTALLER_FLAGS;
+  }
+  infos[0].name = "mod 0";
+  infos[0].current_path = DATA_DIR / "source" / "mod0.tar.gz";
+  infos[1].name = "mod 1";
+  infos[1].current_path = DATA_DIR / "source" / "mod1.zip";
+  infos[2].name = "mod 2";
+  infos[2].current_path = DATA_DIR / "source" / "mod2.tar.gz";
+  app.installMods(infos);
+  verifyDirsAreEqual(DATA_DIR / "staging" / "0", DATA_DIR / "source" / "0");
+  verifyDirsAreEqual(DATA_DIR / "staging" / "1", DATA_DIR / "source" / "1");
+  verifyDirsAreEqual(DATA_DIR / "staging" / "2", DATA_DIR / "source" / "2");
+  REQUIRE(app.getLoadorder(0) ==
+          std::vector<std::tuple<int, bool>>{ { 0, true }, { 1, true }, { 2, true } });
+  app.deployMods();
+  verifyDirsAreEqual(DATA_DIR / "app", DATA_DIR / "target" / "mod012", true);
+
+  infos.resize(2);
+  infos[0].name = "missing";
+  infos[0].current_path = DATA_DIR / "source" / "does_not_exist.zip";
+  infos[1].target_group_id = 0;
+  REQUIRE_THROWS(app.installMods(infos));
+  REQUIRE_FALSE(sfs::exists(DATA_DIR / "staging" / "3"));
+  verifyDirsAreEqual(DATA_DIR / "staging" / "4", DATA_DIR / "source" / "1");
+  REQUIRE(app.getModInfo().size() == 4);
+  REQUIRE(app.getLoadorder(0) ==
+          std::vector<std::tuple<int, bool>>{ { 4, true }, { 1, true }, { 2, true } });
+}
+
+TEST_CASE("Failed installations do not remove other mods", "[app]")
+{
+  resetStagingDir();
+  ModdedApplication app(DATA_DIR / "staging", "test");
+  ImportModInfo info;
+  info.name = "mod 0";
+  info.version = "1.0";
+  info.installer = Installer::SIMPLEINSTALLER;
+  info.current_path = DATA_DIR / "source" / "mod0.tar.gz";
+  info.installer_flags = INSTALLER_FLAGS;
+  app.installMod(info);
+  const sfs::path broken_archive = DATA_DIR / "staging" / "broken.zip";
+  std::ofstream(broken_archive) << "not an archive";
+  ImportModInfo broken_info = info;
+  broken_info.name = "broken";
+  broken_info.current_path = broken_archive;
+  REQUIRE_THROWS(app.installMod(broken_info));
+  app.cleanupFailedInstallation();
+  verifyDirsAreEqual(DATA_DIR / "staging" / "0", DATA_DIR / "source" / "0");
+  REQUIRE(app.getModInfo().size() == 1);
+
+  info.name = "mod 1";
+  info.current_path = DATA_DIR / "source" / "mod1.zip";
+  REQUIRE_THROWS(app.installMods({ info, broken_info }));
+  app.cleanupFailedInstallation();
+  verifyDirsAreEqual(DATA_DIR / "staging" / "0", DATA_DIR / "source" / "0");
+  verifyDirsAreEqual(DATA_DIR / "staging" / "1", DATA_DIR / "source" / "1");
+  REQUIRE_FALSE(sfs::exists(DATA_DIR / "staging" / "2"));
+  REQUIRE(app.getModInfo().size() == 2);
+}
+
 TEST_CASE("State is saved", "[app]")
 {
   resetStagingDir();
@@ -113,6 +186,98 @@ TEST_CASE("State is saved", "[app]")
   sfs::remove_all(DATA_DIR / "app_2");
 }
 
+TEST_CASE("Changes are journaled", "[app]")
+{
+  resetStagingDir();
+  ModdedApplication app(DATA_DIR / "staging", "test");
+  app.addDeployer({ DeployerFactory::SIMPLEDEPLOYER, "depl0", DATA_DIR / "app", Deployer::hard_link });
+  ImportModInfo info;
+  info.name = "mod 0";
+  info.version = "1.0";
+  info.installer = Installer::SIMPLEINSTALLER;
+  info.current_path = DATA_DIR / "source" / "mod0.tar.gz";
+  info.deployers = { 0 };
+  info.installer_flags = INSTALLER_FLAGS;
+  info.root_level = 0;
+  app.installMod(info);
+  info.name = "mod 1";
+  info.current_path = DATA_DIR / "source" / "mod1.zip";
+  app.installMod(info);
+
+  const sfs::path settings_path = DATA_DIR / "staging" / "lmm_mods.json";
+  const sfs::path journal_path = DATA_DIR / "staging" / ".lmm_mods.json.journal";
+  auto read_file = [](const sfs::path& path)
+  {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  };
+  const std::string snapshot = read_file(settings_path);
+  app.changeModName(0, "renamed mod");
+  app.setModStatus(0, 1, false);
+  app.changeLoadorder(0, 0, 1);
+  REQUIRE(read_file(settings_path) == snapshot);
+  REQUIRE(sfs::exists(journal_path));
+
+  ModdedApplication app2(DATA_DIR / "staging", "test2");
+  REQUIRE_FALSE(sfs::exists(journal_path));
+  REQUIRE_THAT(app.getLoadorder(0), Catch::Matchers::Equals(app2.getLoadorder(0)));
+  REQUIRE_THAT(
+    app2.getLoadorder(0),
+    Catch::Matchers::Equals(std::vector<std::tuple<int, bool>>{ { 1, false }, { 0, true } }));
+  REQUIRE(app2.getModInfo()[0].mod.name == "renamed mod");
+
+  // removed sections must not be kept as null values
+  app2.addTool({ "t1", "", "command string" });
+  app2.removeTool(0);
+  sfs::remove(settings_path);
+  app2.changeModName(0, "mod 0");
+  std::ifstream settings_file(settings_path, std::ios::binary);
+  Json::Value settings;
+  settings_file >> settings;
+  REQUIRE_FALSE(settings.isMember("tools"));
+}
+
+TEST_CASE("Settings are loaded from the cache", "[app]")
+{
+  resetStagingDir();
+  resetAppDir();
+  const sfs::path cache_path = DATA_DIR / "staging" / ".lmm_mods.json.cache";
+  const std::vector<std::string> deployer_names{ "depl0", "rev" };
+  {
+    ModdedApplication app(DATA_DIR / "staging", "test");
+    app.addDeployer(
+      { DeployerFactory::SIMPLEDEPLOYER, "depl0", DATA_DIR / "app", Deployer::hard_link });
+    app.addDeployer(
+      { DeployerFactory::REVERSEDEPLOYER, "rev", DATA_DIR / "app", Deployer::hard_link });
+  }
+  ModdedApplication app(DATA_DIR / "staging", "test");
+  REQUIRE(sfs::exists(cache_path));
+  REQUIRE_THAT(app.getDeployerNames(), Catch::Matchers::Equals(deployer_names));
+
+  ModdedApplication app2(DATA_DIR / "staging", "test2");
+  REQUIRE_THAT(app2.getDeployerNames(), Catch::Matchers::Equals(deployer_names));
+  REQUIRE_THAT(app2.getProfileNames(), Catch::Matchers::Equals(app.getProfileNames()));
+  REQUIRE(app2.getAppInfo().deployer_types[1] == DeployerFactory::REVERSEDEPLOYER);
+
+  std::ofstream(cache_path, std::ios::binary) << "invalid";
+  ModdedApplication app3(DATA_DIR / "staging", "test3");
+  REQUIRE_THAT(app3.getDeployerNames(), Catch::Matchers::Equals(deployer_names));
+  REQUIRE(sfs::file_size(cache_path) > 7);
+
+  // the reverse deployer can not be constructed, so getAppInfo would throw if it tried
+  const sfs::path rev_depl_dir = DATA_DIR / "staging" / "rev_depl_0";
+  sfs::create_directories(rev_depl_dir);
+  std::ofstream(rev_depl_dir / ".revdepl-managed_files.json") << "invalid";
+  ModdedApplication app4(DATA_DIR / "staging", "test4");
+  const AppInfo info = app4.getAppInfo();
+  REQUIRE_THAT(info.deployers, Catch::Matchers::Equals(deployer_names));
+  REQUIRE(info.deployer_types[1] == DeployerFactory::REVERSEDEPLOYER);
+  REQUIRE(info.target_dirs[1] == (DATA_DIR / "app").string());
+  REQUIRE(info.deploy_modes[1] == Deployer::hard_link);
+  REQUIRE_FALSE(info.deployer_is_case_invariant[1]);
+  REQUIRE_THROWS(app4.getDeployerInfo(1));
+}
+
 TEST_CASE("Groups update loadorders", "[app]")
 {
   resetStagingDir();
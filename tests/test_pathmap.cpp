@@ -0,0 +1,187 @@
+#include "../src/core/pathmap.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <malloc.h>
+#include <map>
+#include <random>
+
+namespace sfs = std::filesystem;
+
+
+size_t getAllocatedBytes()
+{
+  // large blocks are allocated with mmap and only counted in hblkhd
+  const auto info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+}
+
+TEST_CASE("Paths are ordered like std::filesystem::path", "[pathmap]")
+{
+  const std::vector<std::string> paths = {
+    "a", "a/b", "a-b", "a/b/c", "ab", "a b/c", "A", "b/a", "b", "a.txt", "a/b.txt", "Ü/a", "a/Ü"
+  };
+  for(const auto& first : paths)
+  {
+    for(const auto& second : paths)
+    {
+      CAPTURE(first, second);
+      REQUIRE((PathMap::compare(first, second) < 0) == (sfs::path(first) < sfs::path(second)));
+      REQUIRE((PathMap::compare(first, second) == 0) == (sfs::path(first) == sfs::path(second)));
+    }
+  }
+}
+
+TEST_CASE("Entries are added and found", "[pathmap]")
+{
+  PathMap map;
+  map.add("b/c", 1);
+  map.add("a", 2);
+  map.add("b", 3);
+  map.add("a", 4);
+  map.add("b/c", 5);
+  REQUIRE_THROWS_AS(map.find("a"), std::logic_error);
+  map.sort();
+  REQUIRE(map.size() == 3);
+  REQUIRE(map.find("a")->second == 4);
+  REQUIRE(map.find("b")->second == 3);
+  REQUIRE(map.find("b/c")->second == 5);
+  REQUIRE(map.find("c") == map.end());
+  REQUIRE_FALSE(map.contains("b/"));
+
+  map.add("b/d", 6);
+  map.add("b/d", 7);
+  REQUIRE(map.find("b/d")->second == 7);
+  const std::vector<std::pair<std::string_view, int>> expected = {
+    { "a", 4 }, { "b", 3 }, { "b/c", 5 }, { "b/d", 7 }
+  };
+  REQUIRE(std::vector(map.begin(), map.end()) == expected);
+
+  const PathMap copy = map;
+  map = PathMap();
+  REQUIRE(std::vector(copy.begin(), copy.end()) == expected);
+  const std::string long_path(1 << 16, 'x');
+  map.add(long_path, 8);
+  map.add("y", 9);
+  REQUIRE(map.find(long_path)->second == 8);
+  REQUIRE(map.find("y")->second == 9);
+}
+
+TEST_CASE("Differences and intersections are computed", "[pathmap]")
+{
+  PathMap first;
+  for(const auto& path : { "a", "a/b", "a/c", "b", "c/d" })
+    first.add(path, 1);
+  PathMap second;
+  for(const auto& path : { "a/b", "b", "b/e", "c" })
+    second.add(path, 2);
+  const PathMap difference = PathMap::difference(first, second);
+  const std::vector<std::pair<std::string_view, int>> expected_difference = {
+    { "a", 1 }, { "a/c", 1 }, { "c/d", 1 }
+  };
+  REQUIRE(std::vector(difference.begin(), difference.end()) == expected_difference);
+  const PathMap intersection = PathMap::intersection(first, second);
+  const std::vector<std::pair<std::string_view, int>> expected_intersection = { { "a/b", 1 },
+                                                                                { "b", 1 } };
+  REQUIRE(std::vector(intersection.begin(), intersection.end()) == expected_intersection);
+  REQUIRE(PathMap::difference(first, PathMap()) == first);
+  REQUIRE(PathMap::intersection(first, PathMap()).empty());
+}
+
+TEST_CASE("Paths are shared between maps", "[pathmap]")
+{
+  auto map = std::make_unique<PathMap>();
+  for(int i = 0; i < 10000; i++)
+    map->add("dir/file_" + std::to_string(i), i);
+  map->sort();
+  PathMap copy = *map;
+  PathMap removed;
+  removed.add("dir/file_1", 0);
+  const PathMap difference = PathMap::difference(*map, removed);
+  REQUIRE(copy.find("dir/file_5")->first.data() == map->find("dir/file_5")->first.data());
+  REQUIRE(difference.find("dir/file_5")->first.data() == map->find("dir/file_5")->first.data());
+
+  map.reset();
+  for(int i = 0; i < 1000; i++)
+    copy.add("new_" + std::to_string(i), -1);
+  copy.sort();
+  REQUIRE(copy.size() == 11000);
+  REQUIRE(difference.size() == 9999);
+  REQUIRE_FALSE(difference.contains("dir/file_1"));
+  for(int i = 0; i < 10000; i++)
+  {
+    if(i != 1)
+      REQUIRE(difference.find("dir/file_" + std::to_string(i))->second == i);
+    REQUIRE(copy.find("dir/file_" + std::to_string(i))->second == i);
+  }
+
+  PathMap moved = std::move(copy);
+  copy.add("a", 1);
+  REQUIRE(copy.size() == 1);
+  REQUIRE(moved.size() == 11000);
+  REQUIRE(moved.find("new_0")->second == -1);
+}
+
+TEST_CASE("PathMap performance", "[pathmap][!benchmark]")
+{
+  for(int num_entries : { 100000, 500000 })
+  {
+    std::vector<std::string> paths;
+    std::mt19937 generator(num_entries);
+    for(int i = 0; i < num_entries; i++)
+      paths.push_back(std::format("Data/Textures/Actors/Character_{}/Variant_{}/texture_{}.dds",
+                                  generator() % 100,
+                                  generator() % 50,
+                                  i));
+    std::vector<sfs::path> lookups(paths.begin(), paths.begin() + 1000);
+
+    const size_t memory_before_map = getAllocatedBytes();
+    auto std_map = std::make_unique<std::map<sfs::path, int>>();
+    for(const auto& path : paths)
+      (*std_map)[path] = 0;
+    const size_t std_map_memory = getAllocatedBytes() - memory_before_map;
+
+    const size_t memory_before_path_map = getAllocatedBytes();
+    auto path_map = std::make_unique<PathMap>();
+    for(const auto& path : paths)
+      path_map->add(path, 0);
+    path_map->sort();
+    const size_t path_map_memory = getAllocatedBytes() - memory_before_path_map;
+    std::cout << std::format("{} entries: std::map uses {} KiB, PathMap uses {} KiB\n",
+                             num_entries,
+                             std_map_memory / 1024,
+                             path_map_memory / 1024);
+
+    BENCHMARK(std::format("std::map build {}", num_entries))
+    {
+      std::map<sfs::path, int> map;
+      for(const auto& path : paths)
+        map[path] = 0;
+      return map.size();
+    };
+    BENCHMARK(std::format("PathMap build {}", num_entries))
+    {
+      PathMap map;
+      for(const auto& path : paths)
+        map.add(path, 0);
+      map.sort();
+      return map.size();
+    };
+    BENCHMARK(std::format("std::map lookup {}", num_entries))
+    {
+      int found = 0;
+      for(const auto& path : lookups)
+        found += std_map->contains(path);
+      return found;
+    };
+    BENCHMARK(std::format("PathMap lookup {}", num_entries))
+    {
+      int found = 0;
+      for(const auto& path : lookups)
+        found += path_map->contains(path.string());
+      return found;
+    };
+  }
+}
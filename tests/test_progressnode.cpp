@@ -0,0 +1,77 @@
+#include "../src/core/progressnode.h"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+
+TEST_CASE("Progress is the weighted sum of sub-tasks", "[progressnode]")
+{
+  std::vector<float> progress;
+  ProgressNode node([&progress](float p) { progress.push_back(p); }, { 1.0f, 3.0f });
+  node.setUpdateInterval(std::chrono::hours(1));
+  node.child(0).setTotalSteps(2);
+  node.child(1).addChildren({ 1.0f, 1.0f });
+  node.child(1).child(0).setTotalSteps(4);
+  node.child(1).child(1).setTotalSteps(0);
+  REQUIRE_THROWS(node.child(1).advance());
+
+  node.child(0).advance();
+  REQUIRE(node.child(0).getProgress() == 0.5f);
+  REQUIRE(node.getProgress() == 0.125f);
+  node.child(1).child(1).advance();
+  REQUIRE(node.child(1).getProgress() == 0.5f);
+  REQUIRE(node.getProgress() == 0.5f);
+  node.child(1).child(0).advance(10);
+  node.child(0).advance();
+  REQUIRE(node.getProgress() == 1.0f);
+  REQUIRE(progress.front() == 0.0f);
+  REQUIRE(progress.back() == 1.0f);
+}
+
+TEST_CASE("Progress is sampled at most once per interval", "[progressnode]")
+{
+  int num_samples = 0;
+  ProgressNode node([&num_samples](float p) { num_samples++; });
+  node.setUpdateInterval(std::chrono::hours(1));
+  node.setUpdateStepSize(0.0f);
+  node.setTotalSteps(1000);
+  for(int i = 0; i < 999; i++)
+    node.advance();
+  // initial progress and first sample, completion is always reported
+  REQUIRE(num_samples == 2);
+  node.advance();
+  REQUIRE(num_samples == 3);
+}
+
+TEST_CASE("Progress can be advanced concurrently", "[progressnode]")
+{
+  std::atomic<int> num_callers = 0;
+  std::atomic<bool> callback_was_exclusive = true;
+  std::vector<float> progress;
+  ProgressNode node(
+    [&](float p)
+    {
+      if(num_callers++ != 0)
+        callback_was_exclusive = false;
+      progress.push_back(p);
+      num_callers--;
+    },
+    { 1.0f, 1.0f, 1.0f, 1.0f });
+  node.setUpdateInterval(std::chrono::microseconds(10));
+  std::vector<std::jthread> threads;
+  for(int i = 0; i < 4; i++)
+  {
+    node.child(i).setTotalSteps(50000);
+    threads.emplace_back(
+      [&node, i]()
+      {
+        for(int step = 0; step < 50000; step++)
+          node.child(step % 2 == 0 ? i : 3 - i).advance();
+      });
+  }
+  threads.clear();
+  REQUIRE(callback_was_exclusive);
+  REQUIRE(node.getProgress() == 1.0f);
+  REQUIRE(progress.back() == 1.0f);
+}
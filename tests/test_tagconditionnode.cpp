@@ -1,7 +1,11 @@
 #include "../src/core/autotag.h"
+#include "../src/core/modfilemanifest.h"
+#include "../src/core/multipatternmatcher.h"
 #include "../src/core/tagconditionnode.h"
+#include "../src/core/tagevaluationplan.h"
 #include "test_utils.h"
 #include <catch2/catch_test_macros.hpp>
+#include <random>
 
 
 TEST_CASE("Expressions are validated", "[tags]")
@@ -162,3 +166,118 @@ TEST_CASE("Complex expressions are parsed", "[tags]")
   REQUIRE_FALSE(node11.evaluate(files.at(0)));
   REQUIRE(node11.evaluate(files.at(1)));
 }
+
+TEST_CASE("Multiple patterns are found in one pass", "[tags]")
+{
+  MultiPatternMatcher matcher;
+  const int he = matcher.addPattern("he");
+  const int she = matcher.addPattern("she");
+  const int his = matcher.addPattern("his");
+  const int hers = matcher.addPattern("hers");
+  REQUIRE(matcher.addPattern("she") == she);
+  matcher.compile();
+  std::vector<std::pair<int, int>> occurrences;
+  matcher.findAll("ushershis",
+                  [&occurrences](int pattern, int start)
+                  { occurrences.emplace_back(pattern, start); });
+  const std::vector<std::pair<int, int>> expected = {
+    { she, 1 }, { he, 2 }, { hers, 2 }, { his, 6 }
+  };
+  REQUIRE(occurrences == expected);
+}
+
+TEST_CASE("Evaluation plans match single tag evaluation", "[tags]")
+{
+  std::vector<TagCondition> conditions{
+    { false, TagCondition::Type::file_name, false, "*.txt" },
+    { false, TagCondition::Type::file_name, false, "*12*abc" },
+    { false, TagCondition::Type::path, false, "dir/abc/*c_1*" },
+    { true, TagCondition::Type::file_name, false, "fawefw*fQFQ*3q*" },
+    { false, TagCondition::Type::file_name, true, R"(some_\d+_file_.b.)" },
+    { false, TagCondition::Type::path, true, R"(d\wr/.*\.png)" },
+    { false, TagCondition::Type::file_name, false, "*rw3*" },
+    { false, TagCondition::Type::file_name, false, "unique_*f*" },
+    { false, TagCondition::Type::path, false, "j/n" },
+    { false, TagCondition::Type::path, false, "qwert" },
+    { false, TagCondition::Type::path, true, R"(j/a_fi.*)" },
+    { false, TagCondition::Type::file_name, false, "**" },
+    { false, TagCondition::Type::file_name, false, "" }
+  };
+  const std::vector<std::string> expressions = {
+    "0",          "1",       "2",           "3",
+    "4",          "5",       "6 or 7",      "not 9 and 10 or 7 and 8",
+    "0 and not 3", "11",     "12",          "not(0 and 1 and 2 and 3 and 4) and 5 and 6"
+  };
+  std::vector<AutoTag> tags;
+  for(int i = 0; i < expressions.size(); i++)
+    tags.emplace_back(std::to_string(i), expressions[i], conditions);
+  std::vector<const AutoTag*> tag_pointers;
+  for(const auto& tag : tags)
+    tag_pointers.push_back(&tag);
+  const TagEvaluationPlan plan(tag_pointers);
+  REQUIRE(plan.getNumTags() == expressions.size());
+
+  const auto files =
+    AutoTag::readModFiles(DATA_DIR / "source" / "auto_tags", std::vector<int>{ 0, 1, 2 });
+  for(const auto& [mod_id, mod_files] : files)
+  {
+    const auto results = plan.evaluate(mod_files);
+    for(int i = 0; i < expressions.size(); i++)
+    {
+      CAPTURE(mod_id, expressions[i]);
+      REQUIRE(results[i] == TagConditionNode(expressions[i], conditions).evaluate(mod_files));
+    }
+  }
+
+  std::mt19937 generator(0);
+  auto random_string = [&generator](const std::string& alphabet, int max_length)
+  {
+    std::string string;
+    const int length = generator() % (max_length + 1);
+    for(int i = 0; i < length; i++)
+      string += alphabet[generator() % alphabet.size()];
+    return string;
+  };
+  for(int i = 0; i < 2000; i++)
+  {
+    const std::string pattern = random_string("ab*", 6);
+    const std::string path = random_string("aAb/", 8);
+    CAPTURE(pattern, path);
+    const AutoTag path_tag("path", "0", { { false, TagCondition::Type::path, false, pattern } });
+    const AutoTag name_tag(
+      "name", "0", { { false, TagCondition::Type::file_name, false, pattern } });
+    const TagEvaluationPlan single_plan({ &path_tag, &name_tag });
+    const std::vector<std::pair<std::string, std::string>> files = {
+      { path, std::filesystem::path(path).filename().string() }
+    };
+    const auto results = single_plan.evaluate(files);
+    REQUIRE(results[0] == path_tag.getEvaluator().evaluate(files));
+    REQUIRE(results[1] == name_tag.getEvaluator().evaluate(files));
+  }
+}
+
+TEST_CASE("Tags are evaluated from mod manifests", "[tags]")
+{
+  resetAppDir();
+  const sfs::path staging_dir = DATA_DIR / "app" / "auto_tags";
+  sfs::copy(DATA_DIR / "source" / "auto_tags", staging_dir, sfs::copy_options::recursive);
+  std::vector<TagCondition> conditions{
+    { false, TagCondition::Type::file_name, false, "*.txt" },
+    { false, TagCondition::Type::path, false, "dir/abc/*c_1*" },
+    { false, TagCondition::Type::path, true, R"(d\wr/.*\.png)" },
+    { true, TagCondition::Type::file_name, false, "*rw3*" }
+  };
+  const AutoTag first_tag("first", "0 and not 1", conditions);
+  const AutoTag second_tag("second", "2 or 3", conditions);
+  const TagEvaluationPlan plan({ &first_tag, &second_tag });
+  const auto files = AutoTag::readModFiles(staging_dir, std::vector<int>{ 0, 1, 2 });
+  for(int mod_id : { 0, 1, 2 })
+  {
+    const auto manifest = ModFileManifest::get(staging_dir / std::to_string(mod_id));
+    TagEvaluationPlan::ModEvaluation evaluation(plan);
+    for(const auto& entry : manifest.getEntries())
+      evaluation.addFile(entry.path);
+    CAPTURE(mod_id);
+    REQUIRE(evaluation.getResults() == plan.evaluate(files.at(mod_id)));
+  }
+}
@@ -1,14 +1,63 @@
 #include "test_utils.h"
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
 #include <fstream>
 #include <iostream>
 
 
+/*!
+ * \brief Removes the mod file manifests which deployers write into the checked in test data
+ * when using one of its directories as their staging directory.
+ */
+class ManifestCleanupListener : public Catch::EventListenerBase
+{
+public:
+  using Catch::EventListenerBase::EventListenerBase;
+
+  void testRunStarting(const Catch::TestRunInfo& test_run_info) override { removeManifests(); }
+
+  void testRunEnded(const Catch::TestRunStats& test_run_stats) override { removeManifests(); }
+
+private:
+  static void removeManifests()
+  {
+    std::vector<sfs::path> manifest_dirs;
+    for(auto iter = sfs::recursive_directory_iterator(DATA_DIR / "source");
+        iter != sfs::recursive_directory_iterator();
+        iter++)
+    {
+      if(iter->path().filename() == ".lmm_manifests")
+      {
+        manifest_dirs.push_back(iter->path());
+        iter.disable_recursion_pending();
+      }
+    }
+    for(const auto& path : manifest_dirs)
+      sfs::remove_all(path);
+  }
+};
+
+CATCH_REGISTER_LISTENER(ManifestCleanupListener)
+
+
 std::vector<std::string> getFiles(sfs::path dir, bool get_contents = false)
 {
   std::vector<std::string> files;
-  for(const auto& dir_entry : sfs::recursive_directory_iterator(dir))
+  for(auto iter = sfs::recursive_directory_iterator(dir); iter != sfs::recursive_directory_iterator();
+      iter++)
   {
-    if(dir_entry.path().filename() == ".lmmfiles" || dir_entry.path().filename() == ".lmm_managed_dir")
+    const auto& dir_entry = *iter;
+    // staging directories contain the manifests of their mods
+    if(dir_entry.path().filename() == ".lmm_manifests")
+    {
+      iter.disable_recursion_pending();
+      continue;
+    }
+    if(dir_entry.path().filename() == ".lmmfiles" ||
+       dir_entry.path().filename() == ".lmmfiles.journal" ||
+       dir_entry.path().filename() == ".lmm_managed_dir" ||
+       dir_entry.path().filename() == ".lmm_mods.json.journal" ||
+       dir_entry.path().filename() == ".lmm_mods.json.cache")
       continue;
     std::string entry = dir_entry.path().string().erase(0, dir.string().size());
     if(get_contents && dir_entry.is_regular_file())